@@ -0,0 +1,19 @@
+#version 120
+
+uniform sampler2D texture;
+uniform sampler2D mask;
+uniform vec2 mask_size;
+
+void main()
+{
+   // the mask is rendered with the same view and size as the target, so window coordinates map 1:1
+   float coverage = texture2D(mask, gl_FragCoord.xy / mask_size).a;
+
+   // same threshold the stencil buffer approach used for its alpha test
+   if (coverage <= 0.5)
+   {
+      discard;
+   }
+
+   gl_FragColor = texture2D(texture, gl_TexCoord[0].xy) * gl_Color;
+}
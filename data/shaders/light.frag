@@ -3,6 +3,7 @@ uniform sampler2D light_map;
 uniform sampler2D normal_map;
 
 uniform vec2 u_resolution;
+uniform vec2 u_light_map_size;
 uniform vec4 u_ambient;
 
 struct Light{
@@ -15,6 +16,44 @@ uniform int u_light_count;
 uniform Light u_lights[5];
 
 
+// the light map may have a lower resolution than the color map. a plain bilinear lookup would bleed
+// light across edges, so the 4 nearest light map texels are weighted by how similar the normal at
+// their center is to the normal of the fragment
+float lightMask(vec2 uv, vec3 normal)
+{
+   if (u_light_map_size.x >= u_resolution.x)
+   {
+      return texture2D(light_map, uv).r;
+   }
+
+   vec2 texel_size = 1.0 / u_light_map_size;
+   vec2 position = uv * u_light_map_size - 0.5;
+   vec2 base = floor(position);
+   vec2 f = position - base;
+
+   float mask_sum = 0.0;
+   float weight_sum = 0.0;
+
+   for (int y = 0; y < 2; y++)
+   {
+      for (int x = 0; x < 2; x++)
+      {
+         vec2 offset = vec2(float(x), float(y));
+         vec2 tap_uv = (base + offset + 0.5) * texel_size;
+
+         vec2 bilinear = mix(1.0 - f, f, offset);
+         vec3 normal_delta = texture2D(normal_map, tap_uv).rgb - normal;
+         float weight = bilinear.x * bilinear.y / (1.0 + 32.0 * dot(normal_delta, normal_delta));
+
+         mask_sum += texture2D(light_map, tap_uv).r * weight;
+         weight_sum += weight;
+      }
+   }
+
+   return mask_sum / max(weight_sum, 0.0001);
+}
+
+
 void main()
 {
    vec2 uv = gl_TexCoord[0].xy;
@@ -22,7 +61,7 @@ void main()
 
    vec4 diffuse_color = texture2D(color_map,  uv);
    vec3 normal        = texture2D(normal_map, uv).rgb;
-   float light_mask   = texture2D(light_map,  uv).r;
+   float light_mask   = lightMask(uv, normal);
 
    vec3 light_sum = vec3(0.0);
    for (int i = 0; i < u_light_count; i++)
@@ -0,0 +1,6 @@
+#version 120
+
+void main()
+{
+   gl_FragColor = gl_Color;
+}
@@ -0,0 +1,81 @@
+#version 120
+
+// stateless dust particles: each particle respawns at a random position inside the clip rect once its
+// lifetime is over and is carried along the flow field from there. the path is integrated from the
+// spawn position on every frame, so no particle state needs to be stored.
+
+uniform float u_time;
+uniform vec4 u_clip_rect;      // left, top, width, height
+uniform vec2 u_wind_direction;
+uniform float u_velocity;
+uniform float u_size;
+uniform vec4 u_color;
+uniform sampler2D u_flow_field;
+uniform vec2 u_flow_field_size;
+
+const int integration_steps = 16;
+const float alpha_default = 50.0 / 255.0;
+
+
+float hash(float x)
+{
+   return fract(sin(x * 12.9898) * 43758.5453);
+}
+
+
+void main()
+{
+   float seed = gl_MultiTexCoord0.x;
+   float corner = gl_MultiTexCoord0.y;
+
+   // 5..15s lifetime, particles are spread over their lifetime so they don't respawn all at once
+   float lifetime = 5.0 + floor(hash(seed) * 100.0) * 0.1;
+   float time = u_time + hash(seed + 0.5) * lifetime;
+   float cycle = floor(time / lifetime);
+   float age = time - cycle * lifetime;
+
+   vec2 position = u_clip_rect.xy + floor(vec2(hash(seed + cycle * 0.731), hash(seed + cycle * 0.317 + 0.25)) * u_clip_rect.zw);
+
+   float z = 0.0;
+   float alive = 1.0;
+   float dt = age / float(integration_steps);
+
+   for (int i = 0; i < integration_steps; i++)
+   {
+      vec2 offset_px = position - u_clip_rect.xy;
+
+      // particles that leave the clip rect are hidden until they respawn
+      if (offset_px.x < 0.0 || offset_px.x >= u_clip_rect.z || offset_px.y < 0.0 || offset_px.y >= u_clip_rect.w)
+      {
+         alive = 0.0;
+         break;
+      }
+
+      // the flow field is not stretched over the clip rect, one texel covers one pixel starting at its top left
+      vec2 uv = (floor(offset_px) + 0.5) / u_flow_field_size;
+      vec3 direction = texture2DLod(u_flow_field, uv, 0.0).rgb - 0.5;
+      position += (direction.xy + u_wind_direction) * dt * u_velocity;
+      z = direction.z;
+   }
+
+   float alpha = 0.0;
+   if (age > lifetime - 1.0)
+   {
+      alpha = (lifetime - age) * alpha_default;
+   }
+   else if (age < 1.0)
+   {
+      alpha = age * alpha_default;
+   }
+   else
+   {
+      alpha = alpha_default + z * alpha_default;
+   }
+
+   // quad corners 0..3: top left, bottom left, bottom right, top right
+   vec2 offset = vec2(step(1.5, corner), step(0.5, corner) * (1.0 - step(2.5, corner)));
+   position += offset * u_size;
+
+   gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 0.0, 1.0);
+   gl_FrontColor = vec4(u_color.rgb, alpha * alive);
+}
@@ -119,9 +119,11 @@ SOURCES += \
    src/framework/tools/checksum.cpp \
    src/framework/tools/elapsedtimer.cpp \
    src/framework/tools/globalclock.cpp \
+   src/framework/tools/gltimerquery.cpp \
    src/framework/tools/jsonconfiguration.cpp \
    src/framework/tools/log.cpp \
-   src/framework/tools/logthread.cpp \
+   src/framework/tools/logfile.cpp \
+   src/framework/tools/profiler.cpp \
    src/framework/tools/scopeexit.cpp \
    src/framework/tools/stopwatch.cpp \
    src/framework/tools/timer.cpp \
@@ -151,7 +153,9 @@ SOURCES += \
    src/game/debugdraw.cpp \
    src/game/detonationanimation.cpp \
    src/game/displaymode.cpp \
+   src/game/dynamicresolution.cpp \
    src/game/effects/dust.cpp \
+   src/game/effects/gpuparticleemitter.cpp \
    src/game/effects/lightsystem.cpp \
    src/game/effects/smokeeffect.cpp \
    src/game/effects/staticlight.cpp \
@@ -164,7 +168,9 @@ SOURCES += \
    src/game/extraskill.cpp \
    src/game/extratable.cpp \
    src/game/fadetransitioneffect.cpp \
+   src/game/fixedtimestep.cpp \
    src/game/fixturenode.cpp \
+   src/game/framecapture.cpp \
    src/game/forestscene.cpp \
    src/game/game.cpp \
    src/game/gameclock.cpp \
@@ -180,6 +186,7 @@ SOURCES += \
    src/game/gamestate.cpp \
    src/game/gun.cpp \
    src/game/hitbox.cpp \
+   src/game/hitboxindex.cpp \
    src/game/imagelayer.cpp \
    src/game/infolayer.cpp \
    src/game/inventory.cpp \
@@ -224,8 +231,10 @@ SOURCES += \
    src/game/overlays/rainoverlay.cpp \
    src/game/overlays/thunderstormoverlay.cpp \
    src/game/overlays/weatheroverlay.cpp \
+   src/game/physics/chainchunks.cpp \
    src/game/physics/physics.cpp \
    src/game/physics/physicsconfiguration.cpp \
+   src/game/physics/ropesimulation.cpp \
    src/game/player/player.cpp \
    src/game/player/playeranimation.cpp \
    src/game/player/playerbelt.cpp \
@@ -237,6 +246,7 @@ SOURCES += \
    src/game/preloader.cpp \
    src/game/projectile.cpp \
    src/game/projectilehitanimation.cpp \
+   src/game/rendertargetpool.cpp \
    src/game/room.cpp \
    src/game/savestate.cpp \
    src/game/screentransition.cpp \
@@ -246,6 +256,7 @@ SOURCES += \
    src/game/shaders/blurshader.cpp \
    src/game/shaders/deathshader.cpp \
    src/game/shaders/gammashader.cpp \
+   src/game/simulationlod.cpp \
    src/game/squaremarcher.cpp \
    src/game/stenciltilemap.cpp \
    src/game/sword.cpp \
@@ -311,9 +322,12 @@ HEADERS += \
    src/framework/tmxparser/tmxtileset.h \
    src/framework/tmxparser/tmxtools.h \
    src/framework/tools/elapsedtimer.h \
+   src/framework/tools/gltimerquery.h \
    src/framework/tools/jsonconfiguration.h \
    src/framework/tools/log.h \
-   src/framework/tools/logthread.h \
+   src/framework/tools/logfile.h \
+   src/framework/tools/profiler.h \
+   src/framework/tools/ringbuffer.h \
    src/framework/tools/scopeexit.h \
    src/framework/tools/stopwatch.h \
    src/game/boomeffectenvelope.h \
@@ -345,7 +359,9 @@ HEADERS += \
    src/game/debugdraw.h \
    src/game/detonationanimation.h \
    src/game/displaymode.h \
+   src/game/dynamicresolution.h \
    src/game/effects/dust.h \
+   src/game/effects/gpuparticleemitter.h \
    src/game/enemy.h \
    src/game/enemydescription.h \
    src/game/eventserializer.h \
@@ -356,7 +372,9 @@ HEADERS += \
    src/game/extraskill.h \
    src/game/extratable.h \
    src/game/fadetransitioneffect.h \
+   src/game/fixedtimestep.h \
    src/game/fixturenode.h \
+   src/game/framecapture.h \
    src/game/forestscene.h \
    src/game/game.h \
    src/game/gameclock.h \
@@ -372,6 +390,7 @@ HEADERS += \
    src/game/gamestate.h \
    src/game/gun.h \
    src/game/hitbox.h \
+   src/game/hitboxindex.h \
    src/game/imagelayer.h \
    src/game/infolayer.h \
    src/game/inventory.h \
@@ -417,8 +436,10 @@ HEADERS += \
    src/game/overlays/rainoverlay.h \
    src/game/overlays/thunderstormoverlay.h \
    src/game/overlays/weatheroverlay.h \
+   src/game/physics/chainchunks.h \
    src/game/physics/physics.h \
    src/game/physics/physicsconfiguration.h \
+   src/game/physics/ropesimulation.h \
    src/game/player/player.h \
    src/game/player/playeranimation.h \
    src/game/player/playerattack.h \
@@ -435,6 +456,7 @@ HEADERS += \
    src/game/preloader.h \
    src/game/projectile.h \
    src/game/projectilehitanimation.h \
+   src/game/rendertargetpool.h \
    src/game/room.h \
    src/game/savestate.h \
    src/game/screentransition.h \
@@ -444,6 +466,7 @@ HEADERS += \
    src/game/shaders/blurshader.h \
    src/game/shaders/deathshader.h \
    src/game/shaders/gammashader.h \
+   src/game/simulationlod.h \
    src/game/squaremarcher.h \
    src/game/stenciltilemap.h \
    src/game/sword.h \
@@ -497,6 +520,7 @@ SOURCES += \
     src/thirdparty/Box2D/Common/b2Math.cpp \
     src/thirdparty/Box2D/Common/b2Settings.cpp \
     src/thirdparty/Box2D/Common/b2StackAllocator.cpp \
+    src/thirdparty/Box2D/Common/b2ThreadPool.cpp \
     src/thirdparty/Box2D/Common/b2Timer.cpp \
     src/thirdparty/Box2D/Collision/b2BroadPhase.cpp \
     src/thirdparty/Box2D/Collision/b2CollideCircle.cpp \
@@ -530,6 +554,8 @@ SOURCES += \
     src/thirdparty/Box2D/Dynamics/Contacts/b2CircleContact.cpp \
     src/thirdparty/Box2D/Dynamics/Contacts/b2Contact.cpp \
     src/thirdparty/Box2D/Dynamics/Contacts/b2ContactSolver.cpp \
+    src/thirdparty/Box2D/Dynamics/Contacts/b2ContactSolverAVX2.cpp \
+    src/thirdparty/Box2D/Dynamics/Contacts/b2ContactSolverSSE2.cpp \
     src/thirdparty/Box2D/Dynamics/Contacts/b2EdgeAndCircleContact.cpp \
     src/thirdparty/Box2D/Dynamics/Contacts/b2EdgeAndPolygonContact.cpp \
     src/thirdparty/Box2D/Dynamics/Contacts/b2PolygonAndCircleContact.cpp \
@@ -548,6 +574,7 @@ HEADERS += \
     src/thirdparty/Box2D/Common/b2Math.h \
     src/thirdparty/Box2D/Common/b2Settings.h \
     src/thirdparty/Box2D/Common/b2StackAllocator.h \
+    src/thirdparty/Box2D/Common/b2ThreadPool.h \
     src/thirdparty/Box2D/Common/b2Timer.h \
     src/thirdparty/Box2D/Collision/b2BroadPhase.h \
     src/thirdparty/Box2D/Collision/b2Collision.h \
@@ -579,6 +606,8 @@ HEADERS += \
     src/thirdparty/Box2D/Dynamics/Contacts/b2CircleContact.h \
     src/thirdparty/Box2D/Dynamics/Contacts/b2Contact.h \
     src/thirdparty/Box2D/Dynamics/Contacts/b2ContactSolver.h \
+    src/thirdparty/Box2D/Dynamics/Contacts/b2ContactSolverWide.h \
+    src/thirdparty/Box2D/Dynamics/Contacts/b2ContactSolverWide.inl \
     src/thirdparty/Box2D/Dynamics/Contacts/b2EdgeAndCircleContact.h \
     src/thirdparty/Box2D/Dynamics/Contacts/b2EdgeAndPolygonContact.h \
     src/thirdparty/Box2D/Dynamics/Contacts/b2PolygonAndCircleContact.h \
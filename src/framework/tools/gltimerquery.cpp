@@ -0,0 +1,40 @@
+#include "gltimerquery.h"
+
+#include <SFML/Window/Context.hpp>
+
+
+//-----------------------------------------------------------------------------
+GlTimerQuery::GlTimerQuery()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   _gen_queries = reinterpret_cast<GenQueries>(sf::Context::getFunction("glGenQueries"));
+   _delete_queries = reinterpret_cast<DeleteQueries>(sf::Context::getFunction("glDeleteQueries"));
+   _begin_query = reinterpret_cast<BeginQuery>(sf::Context::getFunction("glBeginQuery"));
+   _end_query = reinterpret_cast<EndQuery>(sf::Context::getFunction("glEndQuery"));
+   _query_counter = reinterpret_cast<QueryCounter>(sf::Context::getFunction("glQueryCounter"));
+   _get_query_object_uiv = reinterpret_cast<GetQueryObjectuiv>(sf::Context::getFunction("glGetQueryObjectuiv"));
+   _get_query_object_ui64v = reinterpret_cast<GetQueryObjectui64v>(sf::Context::getFunction("glGetQueryObjectui64v"));
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+const GlTimerQuery& GlTimerQuery::get()
+{
+   static GlTimerQuery __instance;
+   return __instance;
+}
+
+
+//-----------------------------------------------------------------------------
+bool GlTimerQuery::isAvailable() const
+{
+   return
+         _gen_queries
+      && _delete_queries
+      && _begin_query
+      && _end_query
+      && _query_counter
+      && _get_query_object_uiv
+      && _get_query_object_ui64v;
+}
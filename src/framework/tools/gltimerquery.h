@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SFML/Config.hpp>
+#include <SFML/OpenGL.hpp>
+
+#include <cstdint>
+
+// timer queries are part of OpenGL 3.3 (ARB_timer_query), the entry points are resolved at runtime
+#if SFML_VERSION_MAJOR > 2 || (SFML_VERSION_MAJOR == 2 && SFML_VERSION_MINOR >= 4)
+#define GL_TIMER_QUERIES_SUPPORTED
+#endif
+
+#ifdef _WIN32
+#define GL_TIMER_QUERY_API __stdcall
+#else
+#define GL_TIMER_QUERY_API
+#endif
+
+
+/*! \brief OpenGL timer query entry points
+ *         SFML only exposes OpenGL 1.1, so the functions are looked up from the current context.
+ *
+ *  GL_TIME_ELAPSED queries measure the GPU time between begin and end but must not be nested,
+ *  GL_TIMESTAMP counters can be issued at any point and are independent of elapsed queries.
+ */
+struct GlTimerQuery
+{
+   static constexpr GLenum time_elapsed = 0x88BF;
+   static constexpr GLenum timestamp = 0x8E28;
+   static constexpr GLenum query_result = 0x8866;
+   static constexpr GLenum query_result_available = 0x8867;
+
+   using GenQueries = void (GL_TIMER_QUERY_API*)(GLsizei, GLuint*);
+   using DeleteQueries = void (GL_TIMER_QUERY_API*)(GLsizei, const GLuint*);
+   using BeginQuery = void (GL_TIMER_QUERY_API*)(GLenum, GLuint);
+   using EndQuery = void (GL_TIMER_QUERY_API*)(GLenum);
+   using QueryCounter = void (GL_TIMER_QUERY_API*)(GLuint, GLenum);
+   using GetQueryObjectuiv = void (GL_TIMER_QUERY_API*)(GLuint, GLenum, GLuint*);
+   using GetQueryObjectui64v = void (GL_TIMER_QUERY_API*)(GLuint, GLenum, uint64_t*);
+
+   static const GlTimerQuery& get();
+
+   bool isAvailable() const;
+
+   GenQueries _gen_queries = nullptr;
+   DeleteQueries _delete_queries = nullptr;
+   BeginQuery _begin_query = nullptr;
+   EndQuery _end_query = nullptr;
+   QueryCounter _query_counter = nullptr;
+   GetQueryObjectuiv _get_query_object_uiv = nullptr;
+   GetQueryObjectui64v _get_query_object_ui64v = nullptr;
+
+private:
+
+   GlTimerQuery();
+};
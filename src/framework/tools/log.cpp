@@ -1,7 +1,18 @@
 #include "log.h"
 
+#include "ringbuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #ifdef __GNUC__
 #define FMT_HEADER_ONLY
@@ -17,105 +28,353 @@ namespace fmt = std;
 
 namespace
 {
-Log::ListenerCallback _log_callback;
 
-void log(
-   Log::Level level,
-   const std::string_view& message,
-   const std::source_location& source_location
-)
+struct Record
 {
-   const auto now = std::chrono::system_clock::now();
-   const auto source_tag = fmt::format(
-      "{0}:{1}:{2}",
-      std::filesystem::path{source_location.file_name()}.filename().string(),
-      source_location.function_name(),
-      source_location.line()
-   );
+   Log::SysClockTimePoint _time_point;
+   Log::Level _level = Log::Level::Info;
+   std::source_location _source_location;
+   size_t _length = 0;
+   std::array<char, Log::max_message_length> _text;
+   std::string _long_text; // only used by messages that don't fit into _text
 
-#ifdef __GNUC__
-   const auto now_time = std::chrono::system_clock::to_time_t(now);
+   void setText(const std::string_view& text)
+   {
+      if (text.size() > _text.size())
+      {
+         _long_text.assign(text);
+         _length = 0;
+         return;
+      }
 
-   std::stringstream ss;
-   ss << std::put_time(std::localtime(&now_time), "%Y-%m-%d %X");
-   const auto now_local = ss.str();
-#else
-   const auto now_local = std::chrono::zoned_time{std::chrono::current_zone(), now};
-#endif
+      _long_text.clear();
+      _length = text.size();
+      std::memcpy(_text.data(), text.data(), _length);
+   }
 
-   std::cout
-      << fmt::format(
-#ifdef __GNUC__
-            "[{0}] {1} | {2}: {3}",
-#else
-            "[{0}] {1:%T} | {2}: {3}",
-#endif
-            static_cast<char>(level),
-            now_local,
-            source_tag,
-            message
-         )
-      << std::endl;
+   std::string_view text() const
+   {
+      return _long_text.empty() ? std::string_view{_text.data(), _length} : std::string_view{_long_text};
+   }
+};
+
+using RecordBuffer = RingBuffer<Record, 256>;
+
+
+// set once the writer has been shut down during static destruction; late messages are written synchronously then
+std::atomic<bool> writer_shut_down = false;
+
+
+class Writer
+{
+public:
+
+   static Writer& getInstance()
+   {
+      static Writer __instance;
+      return __instance;
+   }
+
+   ~Writer()
+   {
+      _stopped = true;
+      _thread.join();
+      drain();
+      writer_shut_down = true;
+   }
+
+   void push(const Log::SysClockTimePoint& time_point, Log::Level level, const std::string_view& text, const std::source_location& location)
+   {
+      auto& buffer = threadBuffer();
+
+      // apply back-pressure instead of dropping messages when the writer falls behind
+      Record* record = nullptr;
+      while ((record = buffer.acquire()) == nullptr)
+      {
+         std::this_thread::yield();
+      }
+
+      record->_time_point = time_point;
+      record->_level = level;
+      record->_source_location = location;
+      record->setText(text);
+
+      buffer.commit();
+   }
+
+   void setListener(const Log::ListenerCallback& callback)
+   {
+      std::lock_guard<std::mutex> guard(_output_mutex);
+      _listener = callback;
+   }
+
+   void flush()
+   {
+      const auto flush_request = ++_flush_requested;
+      while (_flush_completed < flush_request && !_stopped)
+      {
+         std::this_thread::yield();
+      }
+   }
+
+   static void write(const Record& record, const Log::ListenerCallback& listener, std::string& time_string, time_t& time_string_time)
+   {
+      const auto& source_location = record._source_location;
+      const auto message = std::string{record.text()};
+
+      const auto source_tag = fmt::format(
+         "{0}:{1}:{2}",
+         std::filesystem::path{source_location.file_name()}.filename().string(),
+         source_location.function_name(),
+         source_location.line()
+      );
+
+      // localtime and put_time are expensive, so the formatted time is only refreshed once per second
+      const auto time = std::chrono::system_clock::to_time_t(record._time_point);
+      if (time != time_string_time)
+      {
+         std::stringstream ss;
+         ss << std::put_time(std::localtime(&time), "%Y-%m-%d %X");
+         time_string = ss.str();
+         time_string_time = time;
+      }
+
+      std::cout << fmt::format("[{0}] {1} | {2}: {3}", static_cast<char>(record._level), time_string, source_tag, message) << '\n';
+
+      if (listener)
+      {
+         listener(record._time_point, record._level, message, source_location);
+      }
+   }
+
+
+private:
+
+   Writer()
+   {
+      _thread = std::thread(&Writer::run, this);
+   }
+
+   RecordBuffer& threadBuffer()
+   {
+      // each thread registers its own buffer on first use, the registry keeps it alive beyond the thread's lifetime
+      thread_local std::shared_ptr<RecordBuffer> buffer;
+      if (!buffer)
+      {
+         buffer = std::make_shared<RecordBuffer>();
+         std::lock_guard<std::mutex> guard(_buffers_mutex);
+         _buffers.push_back(buffer);
+      }
+
+      return *buffer;
+   }
+
+   void run()
+   {
+      while (!_stopped)
+      {
+         const auto flush_request = _flush_requested.load();
+
+         if (!drain())
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+         }
+
+         _flush_completed = flush_request;
+      }
+   }
+
+   bool drain()
+   {
+      std::vector<std::shared_ptr<RecordBuffer>> buffers;
+      {
+         std::lock_guard<std::mutex> guard(_buffers_mutex);
+         buffers = _buffers;
+      }
+
+      // merge all per-thread queues by time so the output remains in order
+      _pending.clear();
+      for (const auto& buffer : buffers)
+      {
+         for (auto record = buffer->front(); record; record = buffer->front())
+         {
+            _pending.push_back(*record);
+            buffer->pop();
+         }
+      }
+
+      if (_pending.empty())
+      {
+         return false;
+      }
+
+      std::stable_sort(
+         _pending.begin(), _pending.end(), [](const auto& a, const auto& b) { return a._time_point < b._time_point; }
+      );
+
+      std::lock_guard<std::mutex> guard(_output_mutex);
+      for (const auto& record : _pending)
+      {
+         write(record, _listener, _time_string, _time_string_time);
+      }
+
+      std::cout.flush();
+      return true;
+   }
+
+   std::thread _thread;
+   std::atomic<bool> _stopped = false;
+   std::atomic<uint64_t> _flush_requested = 0;
+   std::atomic<uint64_t> _flush_completed = 0;
+
+   std::mutex _buffers_mutex;
+   std::vector<std::shared_ptr<RecordBuffer>> _buffers;
+   std::vector<Record> _pending;
+
+   std::mutex _output_mutex;
+   Log::ListenerCallback _listener;
+   std::string _time_string;
+   time_t _time_string_time = 0;
+};
+
+
+void log(Log::Level level, const std::string_view& message, const std::source_location& source_location)
+{
+   const auto now = std::chrono::system_clock::now();
 
-   if (_log_callback)
+   if (writer_shut_down)
    {
-      _log_callback(now, level, std::string{message}, source_location);
+      Record record;
+      record._time_point = now;
+      record._level = level;
+      record._source_location = source_location;
+      record.setText(message);
+
+      std::string time_string;
+      time_t time_string_time = 0;
+      Writer::write(record, {}, time_string, time_string_time);
+      return;
    }
+
+   Writer::getInstance().push(now, level, message, source_location);
 }
 
 }
 
+
 void Log::registerListenerCallback(const ListenerCallback& cb)
 {
-   _log_callback = cb;
+   Writer::getInstance().setListener(cb);
+}
+
+
+void Log::flush()
+{
+   if (!writer_shut_down)
+   {
+      Writer::getInstance().flush();
+   }
 }
 
 
 void Log::info(const std::string_view& message, const std::source_location& source_location)
 {
-   log(Level::Info, message, source_location);
+   if constexpr (isEnabled(Level::Info))
+   {
+      log(Level::Info, message, source_location);
+   }
 }
 
 
 void Log::warning(const std::string_view& message, const std::source_location& source_location)
 {
-   log(Level::Warning, message, source_location);
+   if constexpr (isEnabled(Level::Warning))
+   {
+      log(Level::Warning, message, source_location);
+   }
 }
 
 
 void Log::error(const std::string_view& message, const std::source_location& source_location)
 {
-   log(Level::Error, message, source_location);
+   if constexpr (isEnabled(Level::Error))
+   {
+      log(Level::Error, message, source_location);
+   }
 }
 
 
-Log::Message::Message(const std::source_location& source_location, const LogFunction& log_function)
- : _source_location(source_location),
-   _log_function(log_function)
+Log::MessageBuffer::MessageBuffer()
 {
+   setp(_data.data(), _data.data() + _data.size());
 }
 
 
-Log::Message::~Message()
+std::string_view Log::MessageBuffer::view() const
+{
+   if (!_overflow.empty())
+   {
+      return _overflow;
+   }
+
+   return {pbase(), static_cast<size_t>(pptr() - pbase())};
+}
+
+
+Log::MessageBuffer::int_type Log::MessageBuffer::overflow(int_type c)
+{
+   if (traits_type::eq_int_type(c, traits_type::eof()))
+   {
+      return traits_type::not_eof(c);
+   }
+
+   // messages exceeding the buffer continue on the heap, the put area stays full so everything else ends up here too
+   if (_overflow.empty())
+   {
+      _overflow.reserve(2 * _data.size());
+      _overflow.assign(pbase(), pptr());
+   }
+
+   _overflow.push_back(traits_type::to_char_type(c));
+   return c;
+}
+
+
+Log::Message::Message(const std::source_location& source_location, Level level)
+ : std::ostream(nullptr),
+   _source_location(source_location),
+   _level(level)
 {
-   _log_function(str(), _source_location);
+   rdbuf(&_buffer);
 }
 
 
-Log::Info::Info(const std::source_location& source_location)
- : Message(source_location, info)
+Log::Message::~Message()
 {
+   // std::endl is still used in many places, the trailing newline is added by the writer anyway
+   auto text = _buffer.view();
+   while (!text.empty() && text.back() == '\n')
+   {
+      text.remove_suffix(1);
+   }
+
+   log(_level, text, _source_location);
 }
 
 
-Log::Warning::Warning(const std::source_location& source_location)
- : Message(source_location, warning)
+Log::InfoMessage::InfoMessage(const std::source_location& source_location)
+ : Message(source_location, Level::Info)
 {
 }
 
 
-Log::Error::Error(const std::source_location& source_location)
- : Message(source_location, error)
+Log::WarningMessage::WarningMessage(const std::source_location& source_location)
+ : Message(source_location, Level::Warning)
 {
 }
 
+
+Log::ErrorMessage::ErrorMessage(const std::source_location& source_location)
+ : Message(source_location, Level::Error)
+{
+}
@@ -1,16 +1,30 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <ostream>
 #include <source_location>
-#include <sstream>
+#include <streambuf>
+#include <string>
 #include <string_view>
+#include <type_traits>
+
+// messages below this level are compiled out; 0: info, 1: warning, 2: error
+#ifndef LOG_LEVEL_MIN
+#define LOG_LEVEL_MIN 0
+#endif
 
 
 /*!
  * Log functions to output messages in a consistent manner including a timestamp and source location.
  * In contrast to std::cout << "bla", a newline is always appended to each message.
  *
+ * The calling thread only streams the message into a fixed size buffer and pushes it into a lock-free
+ * per-thread queue. The rare messages that don't fit are moved to the heap instead of being cut off. Formatting, console and file output all happen on a single background writer thread.
+ * Messages below LOG_LEVEL_MIN turn into no-ops at compile time.
+ *
  * usages
  *    Log::info("Hello World");
  *    Log::Info() << "Hello " << "World";
@@ -25,26 +39,71 @@ enum class Level : char
    Error   = 'e'
 };
 
+constexpr int32_t severity(Level level)
+{
+   return (level == Level::Info) ? 0 : (level == Level::Warning) ? 1 : 2;
+}
+
+constexpr bool isEnabled(Level level)
+{
+   return severity(level) >= LOG_LEVEL_MIN;
+}
+
 void info(const std::string_view& message, const std::source_location& source = std::source_location::current());
 void warning(const std::string_view& message, const std::source_location& source = std::source_location::current());
 void error(const std::string_view& message, const std::source_location& source = std::source_location::current());
 
-using LogFunction = std::function<void(const std::string_view& message, const std::source_location& source)>;
+// blocks until all messages logged so far have been written
+void flush();
+
+static constexpr auto max_message_length = 480;
+
+class MessageBuffer : public std::streambuf
+{
+public:
+   MessageBuffer();
+   std::string_view view() const;
+
+protected:
+   int_type overflow(int_type c) override;
 
-struct Message : public std::ostringstream
+private:
+   std::array<char, max_message_length> _data;
+   std::string _overflow;
+};
+
+struct Message : public std::ostream
 {
-   Message(const std::source_location& source_location, const LogFunction& log_function);
+   Message(const std::source_location& source_location, Level level);
    virtual ~Message();
+   MessageBuffer _buffer;
    std::source_location _source_location;
-   LogFunction _log_function;
+   Level _level;
+};
+
+// swallows everything that is streamed into it, used for compiled out log levels
+struct NullMessage
+{
+   NullMessage(const std::source_location& = std::source_location::current()) {}
+
+   template <typename T>
+   const NullMessage& operator<<(const T&) const { return *this; }
+   const NullMessage& operator<<(std::ostream& (*)(std::ostream&)) const { return *this; }
+   const NullMessage& operator<<(std::ios_base& (*)(std::ios_base&)) const { return *this; }
 };
 
-struct Info : public Message{Info(const std::source_location& source_location = std::source_location::current());};
-struct Warning : public Message{Warning(const std::source_location& source_location = std::source_location::current());};
-struct Error : public Message{Error(const std::source_location& source_location = std::source_location::current());};
+struct InfoMessage : public Message{InfoMessage(const std::source_location& source_location = std::source_location::current());};
+struct WarningMessage : public Message{WarningMessage(const std::source_location& source_location = std::source_location::current());};
+struct ErrorMessage : public Message{ErrorMessage(const std::source_location& source_location = std::source_location::current());};
+
+using Info = std::conditional_t<isEnabled(Level::Info), InfoMessage, NullMessage>;
+using Warning = std::conditional_t<isEnabled(Level::Warning), WarningMessage, NullMessage>;
+using Error = std::conditional_t<isEnabled(Level::Error), ErrorMessage, NullMessage>;
 
 using SysClockTimePoint = std::chrono::time_point<std::chrono::system_clock>;
 using ListenerCallback = std::function<void(const SysClockTimePoint&, Level, const std::string&, const std::source_location&)>;
+
+// the listener is called from the writer thread
 void registerListenerCallback(const ListenerCallback& cb);
 }
 
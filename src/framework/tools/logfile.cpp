@@ -0,0 +1,65 @@
+#include "logfile.h"
+
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __GNUC__
+#define FMT_HEADER_ONLY
+#  include <ctime>
+#  include <fmt/core.h>
+#else
+namespace fmt = std;
+#endif
+
+
+LogFile::LogFile()
+{
+   // generate filename with current date
+   const auto now = std::chrono::system_clock::now();
+   const auto now_time = std::chrono::system_clock::to_time_t(now);
+   std::stringstream ss;
+   ss << std::put_time(std::localtime(&now_time), "%Y-%m-%d__%H-%M.log");
+   const auto filename = ss.str();
+
+   _out = std::make_unique<std::ofstream>(filename);
+}
+
+
+LogFile::~LogFile()
+{
+   // write everything that is still queued, then detach from the writer thread
+   Log::flush();
+   Log::registerListenerCallback({});
+   _out->flush();
+}
+
+
+void LogFile::log(
+   const SysClockTimePoint& time_point,
+   Log::Level level,
+   const std::string& message,
+   const std::source_location& source_location
+)
+{
+   const auto source_tag = fmt::format(
+      "{0}:{1}:{2}",
+      std::filesystem::path{source_location.file_name()}.filename().string(),
+      source_location.function_name(),
+      source_location.line()
+   );
+
+   // only format the time once per second
+   const auto time = std::chrono::system_clock::to_time_t(time_point);
+   if (time != _time_string_time)
+   {
+      std::stringstream ss;
+      ss << std::put_time(std::localtime(&time), "%Y-%m-%d %X");
+      _time_string = ss.str();
+      _time_string_time = time;
+   }
+
+   *_out << fmt::format("[{0}] {1} | {2}: {3}", static_cast<char>(level), _time_string, source_tag, message) << '\n';
+}
+
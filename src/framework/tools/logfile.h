@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <source_location>
+#include <string>
+
+#include "log.h"
+
+/*! \brief Writes all log messages into a file named after the current date and time.
+ *
+ *  The log function is registered as listener callback and is invoked from the log writer thread,
+ *  so no file I/O happens on the threads that produce log messages.
+ */
+class LogFile
+{
+
+public:
+
+   LogFile();
+   virtual ~LogFile();
+
+   using SysClockTimePoint = std::chrono::time_point<std::chrono::system_clock>;
+   void log(const SysClockTimePoint&, Log::Level, const std::string&, const std::source_location&);
+
+
+private:
+
+   std::unique_ptr<std::ofstream> _out;
+   std::string _time_string;
+   time_t _time_string_time = 0;
+};
+
@@ -0,0 +1,379 @@
+#include "profiler.h"
+
+#include "framework/tools/gltimerquery.h"
+#include "framework/tools/log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+#include "json/json.hpp"
+
+
+struct Profiler::GpuQuery
+{
+   uint32_t _id = 0;
+   const char* _name = nullptr;
+};
+
+
+//-----------------------------------------------------------------------------
+Profiler& Profiler::getInstance()
+{
+   static Profiler __instance;
+   return __instance;
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::beginFrame()
+{
+   if (!_enabled)
+   {
+      return;
+   }
+
+   collectGpuQueries();
+
+   // subsystems that did not run in the last frame are pushed as 0ms so the histories stay aligned
+   for (auto& [name, history] : _histories)
+   {
+      const auto it = _frame_samples_ms.find(name);
+      history._current_ms = (it != _frame_samples_ms.end()) ? it->second : 0.0f;
+   }
+
+   for (const auto& [name, duration_ms] : _frame_samples_ms)
+   {
+      _histories[name]._current_ms = duration_ms;
+   }
+
+   for (auto& [name, history] : _histories)
+   {
+      history._values_ms[_history_index] = history._current_ms;
+      history._average_ms = std::accumulate(history._values_ms.begin(), history._values_ms.end(), 0.0f) / history_size;
+      history._max_ms = *std::max_element(history._values_ms.begin(), history._values_ms.end());
+   }
+
+   _history_index = (_history_index + 1) % history_size;
+   _frame_samples_ms.clear();
+
+   if (_trace_frames_left > 0)
+   {
+      _trace_frames_left--;
+      if (_trace_frames_left == 0)
+      {
+         writeTrace();
+      }
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::addSample(const std::string& name, float duration_ms)
+{
+   if (!_enabled)
+   {
+      return;
+   }
+
+   _frame_samples_ms[name] += duration_ms;
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::addSample(const char* name, const HighResTimePoint& start, const HighResTimePoint& end)
+{
+   addSample(name, std::chrono::duration<float, std::milli>(end - start).count());
+
+   if (_trace_frames_left > 0)
+   {
+      _trace_events.push_back({
+         name,
+         std::chrono::duration_cast<std::chrono::microseconds>(start - _trace_start_time).count(),
+         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+      });
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+bool Profiler::isEnabled() const
+{
+   return _enabled;
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::setEnabled(bool enabled)
+{
+   _enabled = enabled;
+
+   if (!_enabled)
+   {
+      _frame_samples_ms.clear();
+      _histories.clear();
+
+      // a trace that is still running is written with the frames captured so far
+      stopTrace();
+      releaseGpuQueries();
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+bool Profiler::isGpuTimingEnabled() const
+{
+   return _gpu_timing_enabled;
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::setGpuTimingEnabled(bool enabled)
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   if (enabled && !GlTimerQuery::get().isAvailable())
+   {
+      Log::Warning() << "gpu timer queries are not supported by this driver";
+      return;
+   }
+
+   _gpu_timing_enabled = enabled;
+
+   if (!_gpu_timing_enabled)
+   {
+      releaseGpuQueries();
+   }
+#else
+   Log::Warning() << "gpu timer queries require sfml 2.4 or newer";
+   static_cast<void>(enabled);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::startTrace(int32_t frame_count, const std::string& filename)
+{
+   _enabled = true;
+   _trace_frames_left = frame_count;
+   _trace_filename = filename;
+   _trace_start_time = HighResClock::now();
+   _trace_events.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+bool Profiler::isTracing() const
+{
+   return _trace_frames_left > 0;
+}
+
+
+//-----------------------------------------------------------------------------
+const std::map<std::string, Profiler::History>& Profiler::getHistories() const
+{
+   return _histories;
+}
+
+
+int32_t Profiler::getHistoryIndex() const
+{
+   return _history_index;
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::stopTrace()
+{
+   if (_trace_frames_left == 0)
+   {
+      return;
+   }
+
+   _trace_frames_left = 0;
+   writeTrace();
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::writeTrace()
+{
+   using json = nlohmann::json;
+
+   auto events = json::array();
+   for (const auto& event : _trace_events)
+   {
+      events.push_back({
+         {"name", event._name},
+         {"ph", "X"},
+         {"ts", event._start_us},
+         {"dur", event._duration_us},
+         {"pid", 0},
+         {"tid", 0}
+      });
+   }
+
+   std::ofstream file(_trace_filename);
+   file << json{{"traceEvents", events}, {"displayTimeUnit", "ms"}}.dump();
+
+   Log::Info() << "wrote " << _trace_events.size() << " trace events to " << _trace_filename;
+
+   _trace_events.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::beginGpuQuery(const char* name)
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   // timer queries of type GL_TIME_ELAPSED must not be nested
+   if (_gpu_query_active)
+   {
+      return;
+   }
+
+   const auto& gl = GlTimerQuery::get();
+
+   GpuQuery* query = nullptr;
+   if (_gpu_queries_free.empty())
+   {
+      query = new GpuQuery();
+      gl._gen_queries(1, &query->_id);
+   }
+   else
+   {
+      query = _gpu_queries_free.back();
+      _gpu_queries_free.pop_back();
+   }
+
+   query->_name = name;
+   gl._begin_query(GlTimerQuery::time_elapsed, query->_id);
+   _gpu_query_active = query;
+#else
+   static_cast<void>(name);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::endGpuQuery()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   if (!_gpu_query_active)
+   {
+      return;
+   }
+
+   GlTimerQuery::get()._end_query(GlTimerQuery::time_elapsed);
+   _gpu_queries_pending.push_back(_gpu_query_active);
+   _gpu_query_active = nullptr;
+
+   // gpu timing was switched off while this query was running
+   if (!_enabled || !_gpu_timing_enabled)
+   {
+      releaseGpuQueries();
+   }
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::collectGpuQueries()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   // resolving the gl functions would create a context, which headless runs don't have
+   if (_gpu_queries_pending.empty())
+   {
+      return;
+   }
+
+   const auto& gl = GlTimerQuery::get();
+
+   // results arrive in order, so stop at the first query that is not ready yet
+   auto it = _gpu_queries_pending.begin();
+   for (; it != _gpu_queries_pending.end(); ++it)
+   {
+      GLuint available = 0;
+      gl._get_query_object_uiv((*it)->_id, GlTimerQuery::query_result_available, &available);
+      if (!available)
+      {
+         break;
+      }
+
+      GLuint elapsed_ns = 0;
+      gl._get_query_object_uiv((*it)->_id, GlTimerQuery::query_result, &elapsed_ns);
+      addSample(std::string{"gpu "} + (*it)->_name, elapsed_ns / 1000000.0f);
+      _gpu_queries_free.push_back(*it);
+   }
+
+   _gpu_queries_pending.erase(_gpu_queries_pending.begin(), it);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void Profiler::releaseGpuQueries()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   // results that haven't arrived yet are discarded, the running query is released once it has ended
+   _gpu_queries_free.insert(_gpu_queries_free.end(), _gpu_queries_pending.begin(), _gpu_queries_pending.end());
+   _gpu_queries_pending.clear();
+
+   if (_gpu_queries_free.empty())
+   {
+      return;
+   }
+
+   const auto& gl = GlTimerQuery::get();
+   for (auto query : _gpu_queries_free)
+   {
+      gl._delete_queries(1, &query->_id);
+      delete query;
+   }
+
+   _gpu_queries_free.clear();
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+Profiler::Scope::Scope(const char* name)
+ : _name(name),
+   _enabled(Profiler::getInstance().isEnabled())
+{
+   if (_enabled)
+   {
+      _start_time = HighResClock::now();
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+Profiler::Scope::~Scope()
+{
+   if (_enabled)
+   {
+      Profiler::getInstance().addSample(_name, _start_time, HighResClock::now());
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+Profiler::GpuScope::GpuScope(const char* name)
+ : _name(name),
+   _enabled(Profiler::getInstance().isEnabled() && Profiler::getInstance().isGpuTimingEnabled())
+{
+   if (_enabled)
+   {
+      Profiler::getInstance().beginGpuQuery(_name);
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+Profiler::GpuScope::~GpuScope()
+{
+   if (_enabled)
+   {
+      Profiler::getInstance().endGpuQuery();
+   }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/*! \brief Collects per-frame timings of named subsystems.
+ *
+ *  CPU timings are taken by Profiler::Scope, GPU timings by Profiler::GpuScope which wraps OpenGL timer queries.
+ *  Multiple scopes with the same name within one frame are summed up, so fixed time step updates that run several
+ *  times per frame show up as one value. The last frames of each subsystem are kept in a rolling history.
+ *  When a trace capture is running, each scope is additionally recorded as an event that can be written to a
+ *  Chrome trace JSON file (chrome://tracing, Perfetto).
+ *
+ *  usage
+ *     Profiler::Scope scope("level update");
+ *
+ *  The profiler is meant to be used from the main thread only.
+ */
+class Profiler
+{
+   using HighResClock = std::chrono::high_resolution_clock;
+   using HighResTimePoint = HighResClock::time_point;
+
+public:
+
+   static constexpr auto history_size = 120;
+
+   struct History
+   {
+      std::array<float, history_size> _values_ms{};
+      float _current_ms = 0.0f;
+      float _average_ms = 0.0f;
+      float _max_ms = 0.0f;
+   };
+
+   struct Scope
+   {
+      Scope(const char* name);
+      ~Scope();
+
+      const char* _name = nullptr;
+      HighResTimePoint _start_time;
+      bool _enabled = false;
+   };
+
+   struct GpuScope
+   {
+      GpuScope(const char* name);
+      ~GpuScope();
+
+      const char* _name = nullptr;
+      bool _enabled = false;
+   };
+
+   static Profiler& getInstance();
+
+   void beginFrame();
+
+   void addSample(const std::string& name, float duration_ms);
+   void addSample(const char* name, const HighResTimePoint& start, const HighResTimePoint& end);
+
+   bool isEnabled() const;
+   void setEnabled(bool enabled);
+
+   bool isGpuTimingEnabled() const;
+   void setGpuTimingEnabled(bool enabled);
+
+   void startTrace(int32_t frame_count, const std::string& filename = "profile_trace.json");
+   bool isTracing() const;
+
+   const std::map<std::string, History>& getHistories() const;
+
+   //! the histories are ring buffers, this is where the oldest sample is
+   int32_t getHistoryIndex() const;
+
+
+private:
+
+   struct TraceEvent
+   {
+      const char* _name = nullptr;
+      int64_t _start_us = 0;
+      int64_t _duration_us = 0;
+   };
+
+   struct GpuQuery;
+
+   Profiler() = default;
+
+   void beginGpuQuery(const char* name);
+   void endGpuQuery();
+   void collectGpuQueries();
+   void releaseGpuQueries();
+   void stopTrace();
+   void writeTrace();
+
+   bool _enabled = false;
+   bool _gpu_timing_enabled = false;
+   int32_t _history_index = 0;
+
+   std::map<std::string, float> _frame_samples_ms;
+   std::map<std::string, History> _histories;
+
+   // trace capture
+   int32_t _trace_frames_left = 0;
+   std::string _trace_filename;
+   HighResTimePoint _trace_start_time;
+   std::vector<TraceEvent> _trace_events;
+
+   // gpu timer queries are read back a few frames later to avoid stalling the pipeline
+   std::vector<GpuQuery*> _gpu_queries_pending;
+   std::vector<GpuQuery*> _gpu_queries_free;
+   GpuQuery* _gpu_query_active = nullptr;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/*! \brief Lock-free ring buffer for exactly one producer and one consumer thread.
+ *
+ *  Slots are preallocated; the producer fills a slot in place with acquire()/commit(), the consumer reads it
+ *  in place with front()/pop(). No locks and no allocations are involved after construction.
+ */
+template <typename T, size_t Capacity>
+class RingBuffer
+{
+   static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+
+   // producer side
+   T* acquire()
+   {
+      const auto head = _head.load(std::memory_order_relaxed);
+      if (head - _tail.load(std::memory_order_acquire) == Capacity)
+      {
+         return nullptr;
+      }
+
+      return &_slots[head & (Capacity - 1)];
+   }
+
+   void commit()
+   {
+      _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+   }
+
+   // consumer side
+   T* front()
+   {
+      const auto tail = _tail.load(std::memory_order_relaxed);
+      if (tail == _head.load(std::memory_order_acquire))
+      {
+         return nullptr;
+      }
+
+      return &_slots[tail & (Capacity - 1)];
+   }
+
+   void pop()
+   {
+      _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+   }
+
+
+private:
+
+   std::array<T, Capacity> _slots;
+
+   // keep producer and consumer indices on separate cache lines
+   alignas(64) std::atomic<size_t> _head{0};
+   alignas(64) std::atomic<size_t> _tail{0};
+};
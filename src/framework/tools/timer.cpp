@@ -3,63 +3,77 @@
 #include <algorithm>
 
 
-std::vector<std::unique_ptr<Timer>> Timer::__timers;
+std::vector<Timer::Node> Timer::__nodes;
+std::vector<int32_t> Timer::__free_nodes;
+std::vector<Timer::HeapEntry> Timer::__heaps[Timer::scope_count];
+std::chrono::microseconds Timer::__clocks[Timer::scope_count];
+uint64_t Timer::__sequence = 0;
 std::mutex Timer::__mutex;
 
 
-void Timer::update(Scope scope)
+bool Timer::HeapEntry::operator<(const HeapEntry& other) const
 {
-   auto now = std::chrono::high_resolution_clock::now();
+   // timers with the same deadline fire in the order they were added
+   if (_deadline != other._deadline)
+   {
+      return _deadline > other._deadline;
+   }
 
-   std::lock_guard<std::mutex> guard(__mutex);
+   return _sequence > other._sequence;
+}
 
-   // it might be better to
-   // 1) lock
-   // 2) find the timer
-   // 3) unlock
-   // 4) call the update function
-   // 5) lock/cleanup/unlock
-   //
-   // background: if the callback starts another timer, the mutex is locked :/
-
-   __timers.erase(
-      std::remove_if(
-         __timers.begin(),
-         __timers.end(),
-         [now, scope](auto& timer) -> bool
-         {
-            if (timer->_scope != scope)
-            {
-               return false;
-            }
-
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - timer->_start_time);
-            auto delta = elapsed - timer->_interval;
-
-            if (delta > std::chrono::milliseconds(0))
-            {
-               timer->_callback();
-
-               if (timer->_type == Type::Singleshot)
-               {
-                  return true;
-               }
-               else
-               {
-                  timer->_start_time = now + delta;
-                  return false;
-               }
-            }
-
-            return false;
-         }
-      ),
-      __timers.end()
-   );
+
+void Timer::update(Scope scope, std::chrono::microseconds dt)
+{
+   const auto scope_index = static_cast<int32_t>(scope);
+
+   std::unique_lock<std::mutex> lock(__mutex);
+
+   __clocks[scope_index] += dt;
+   const auto now = __clocks[scope_index];
+   auto& heap = __heaps[scope_index];
+
+   while (!heap.empty() && heap.front()._deadline <= now)
+   {
+      std::pop_heap(heap.begin(), heap.end());
+      const auto entry = heap.back();
+      heap.pop_back();
+
+      // the timer has been removed in the meantime, its node might already be reused;
+      // paused timers and timers that were paused and resumed in the meantime are skipped as well
+      auto& node = __nodes[entry._index];
+      if (!node._active || node._generation != entry._generation || node._paused || node._sequence != entry._sequence)
+      {
+         continue;
+      }
+
+      // repeated timers fire at most once per update
+      if (node._type == Type::Repeated)
+      {
+         schedule(entry._index, std::max(entry._deadline + node._interval, now + std::chrono::microseconds(1)));
+      }
+
+      // the callback is invoked without holding the lock, so it is free to add or remove timers;
+      // it is taken out of the node since the node vector may grow while the callback is running
+      std::function<void()> callback;
+      if (node._type == Type::Singleshot)
+      {
+         callback = std::move(node._callback);
+         release(entry._index);
+      }
+      else
+      {
+         callback = node._callback;
+      }
+
+      lock.unlock();
+      callback();
+      lock.lock();
+   }
 }
 
 
-void Timer::add(
+Timer::Handle Timer::add(
    std::chrono::milliseconds interval,
    std::function<void ()> callback,
    Type type,
@@ -68,18 +82,51 @@ void Timer::add(
    const std::shared_ptr<void>& caller
 )
 {
-   std::unique_ptr<Timer> timer = std::make_unique<Timer>();
-   timer->_interval = interval;
-   timer->_type = type;
-   timer->_scope = scope;
-   timer->_start_time = std::chrono::high_resolution_clock::now();
-   timer->_callback = callback;
-   timer->_data = data;
-   timer->_caller = caller;
-
-   // don't start another timer from the timed function in your lua code :)
    std::lock_guard<std::mutex> guard(__mutex);
-   __timers.push_back(std::move(timer));
+
+   int32_t index = 0;
+   if (__free_nodes.empty())
+   {
+      index = static_cast<int32_t>(__nodes.size());
+      __nodes.emplace_back();
+   }
+   else
+   {
+      index = __free_nodes.back();
+      __free_nodes.pop_back();
+   }
+
+   auto& node = __nodes[index];
+   node._interval = interval;
+   node._type = type;
+   node._scope = scope;
+   node._callback = std::move(callback);
+   node._data = data;
+   node._caller = caller;
+   node._active = true;
+   node._paused = false;
+
+   schedule(index, __clocks[static_cast<int32_t>(scope)] + node._interval);
+
+   return {index, node._generation};
+}
+
+
+void Timer::remove(const Handle& handle)
+{
+   std::lock_guard<std::mutex> guard(__mutex);
+
+   if (handle._index < 0 || handle._index >= static_cast<int32_t>(__nodes.size()))
+   {
+      return;
+   }
+
+   // the heap entry stays where it is and is skipped once it expires
+   const auto& node = __nodes[handle._index];
+   if (node._active && node._generation == handle._generation)
+   {
+      release(handle._index);
+   }
 }
 
 
@@ -87,13 +134,64 @@ void Timer::removeByCaller(const std::shared_ptr<void>& caller)
 {
    std::lock_guard<std::mutex> guard(__mutex);
 
-   __timers.erase(
-      std::remove_if(
-         __timers.begin(),
-         __timers.end(),
-         [caller](auto& timer) -> bool {return timer->_caller == caller;}
-      ),
-      __timers.end()
-   );
+   for (auto index = 0u; index < __nodes.size(); index++)
+   {
+      if (__nodes[index]._active && __nodes[index]._caller == caller)
+      {
+         release(static_cast<int32_t>(index));
+      }
+   }
 }
 
+
+void Timer::setPausedByCaller(const void* caller, bool paused)
+{
+   std::lock_guard<std::mutex> guard(__mutex);
+
+   for (auto index = 0u; index < __nodes.size(); index++)
+   {
+      auto& node = __nodes[index];
+      if (!node._active || node._paused == paused || node._caller.get() != caller)
+      {
+         continue;
+      }
+
+      // the heap entry of a paused timer is skipped once it expires, resuming it pushes a new one
+      const auto now = __clocks[static_cast<int32_t>(node._scope)];
+      node._paused = paused;
+
+      if (paused)
+      {
+         node._deadline -= now;
+      }
+      else
+      {
+         schedule(static_cast<int32_t>(index), now + node._deadline);
+      }
+   }
+}
+
+
+void Timer::schedule(int32_t index, std::chrono::microseconds deadline)
+{
+   auto& node = __nodes[index];
+   node._deadline = deadline;
+   node._sequence = __sequence++;
+
+   auto& heap = __heaps[static_cast<int32_t>(node._scope)];
+   heap.push_back({deadline, node._sequence, index, node._generation});
+   std::push_heap(heap.begin(), heap.end());
+}
+
+
+void Timer::release(int32_t index)
+{
+   auto& node = __nodes[index];
+   node._active = false;
+   node._paused = false;
+   node._generation++;
+   node._callback = nullptr;
+   node._data.reset();
+   node._caller.reset();
+   __free_nodes.push_back(index);
+}
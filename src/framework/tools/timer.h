@@ -1,11 +1,21 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
 
+/*! \brief Schedules callbacks after a given interval.
+ *
+ *  Each scope runs on its own clock which is advanced by the dt passed to update(). The in-game scope is updated
+ *  from the fixed time step, so its timers are bound to game ticks rather than wall-clock time.
+ *
+ *  Timers are stored in a pool of reusable nodes and ordered in a min-heap by their deadline, so adding a timer
+ *  costs O(log n), cancelling it by its handle costs O(1) and an update only touches the timers that expired.
+ *  Callbacks are invoked without holding the lock, so they may add or remove timers themselves.
+ */
 class Timer
 {
 
@@ -23,11 +33,14 @@ public:
       UpdateIngame
    };
 
-   Timer() = default;
-   ~Timer() = default;
+   struct Handle
+   {
+      int32_t _index = -1;
+      uint32_t _generation = 0;
+   };
 
-   static void update(Scope scope);
-   static void add(
+   static void update(Scope scope, std::chrono::microseconds dt);
+   static Handle add(
       std::chrono::milliseconds interval,
       std::function<void()>,
       Type type = Type::Singleshot,
@@ -36,19 +49,50 @@ public:
       const std::shared_ptr<void>& caller = nullptr
    );
 
+   static void remove(const Handle& handle);
    static void removeByCaller(const std::shared_ptr<void>& caller);
 
-   std::chrono::milliseconds _interval;
-   Type _type = Type::Singleshot;
-   Scope _scope = Scope::UpdateAlways;
-   std::function<void()> _callback = nullptr;
-   std::chrono::high_resolution_clock::time_point _start_time;
-   std::shared_ptr<void> _data;
-   std::shared_ptr<void> _caller;
+   //! paused timers keep their remaining time until they're resumed
+   static void setPausedByCaller(const void* caller, bool paused);
+
 
 private:
 
-   static std::vector<std::unique_ptr<Timer>> __timers;
+   struct Node
+   {
+      std::chrono::microseconds _interval{};
+      Type _type = Type::Singleshot;
+      Scope _scope = Scope::UpdateAlways;
+      std::function<void()> _callback = nullptr;
+      std::shared_ptr<void> _data;
+      std::shared_ptr<void> _caller;
+      uint32_t _generation = 0;
+      bool _active = false;
+      bool _paused = false;
+      std::chrono::microseconds _deadline{}; // remaining time while paused
+      uint64_t _sequence = 0;
+   };
+
+   struct HeapEntry
+   {
+      std::chrono::microseconds _deadline{};
+      uint64_t _sequence = 0;
+      int32_t _index = 0;
+      uint32_t _generation = 0;
+
+      // std::push_heap builds a max-heap, so the comparison is inverted
+      bool operator<(const HeapEntry& other) const;
+   };
+
+   static constexpr auto scope_count = 2;
+
+   static void schedule(int32_t index, std::chrono::microseconds deadline);
+   static void release(int32_t index);
+
+   static std::vector<Node> __nodes;
+   static std::vector<int32_t> __free_nodes;
+   static std::vector<HeapEntry> __heaps[scope_count];
+   static std::chrono::microseconds __clocks[scope_count];
+   static uint64_t __sequence;
    static std::mutex __mutex;
 };
-
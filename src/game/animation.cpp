@@ -286,6 +286,19 @@ void Animation::updateVertices(bool resetTime)
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------
+void Animation::appendVertices(sf::VertexArray& vertices) const
+{
+   // transformed quad of the current frame so animations sharing a texture can be drawn in one go
+   const auto& transform = getTransform();
+
+   for (const auto& vertex : _vertices)
+   {
+      vertices.append(sf::Vertex(transform.transformPoint(vertex.position), vertex.color, vertex.texCoords));
+   }
+}
+
+
 //----------------------------------------------------------------------------------------------------------------------
 sf::FloatRect Animation::getLocalBounds() const
 {
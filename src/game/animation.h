@@ -19,6 +19,10 @@ public:
    Animation() = default;
    Animation(const Animation& anim);
 
+   // the copy constructor starts a fresh playback, assignments take over the playback state as well
+   Animation& operator=(const Animation&) = default;
+   Animation& operator=(Animation&&) = default;
+
    void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const override;
    void draw(sf::RenderTarget& color, sf::RenderTarget& normal, sf::RenderStates states = {}) const;
    void drawTree(sf::RenderTarget& target, sf::RenderStates states = {}) const;
@@ -37,6 +41,7 @@ public:
    void seekToStartTree();
 
    void updateVertices(bool resetTime = true);
+   void appendVertices(sf::VertexArray& vertices) const;
 
    void setAlpha(uint8_t alpha);
    void setAlphaTree(uint8_t alpha);
@@ -108,6 +108,11 @@ void Audio::initializeMusicVolume()
 //-----------------------------------------------------------------------------
 void Audio::playSample(const std::string& sample, float volume)
 {
+   if (!_enabled)
+   {
+      return;
+   }
+
    const auto& thread_it = std::find_if(
       _threads.begin(),
       _threads.end(),
@@ -137,6 +142,11 @@ void Audio::playSample(const std::string& sample, float volume)
 //-----------------------------------------------------------------------------
 void Audio::updateMusic()
 {
+    if (!_enabled)
+    {
+        return;
+    }
+
     if (_tracks.empty())
     {
         return;
@@ -165,3 +175,21 @@ sf::Music& Audio::getMusic() const
    return _music;
 }
 
+
+//-----------------------------------------------------------------------------
+bool Audio::isEnabled() const
+{
+   return _enabled;
+}
+
+
+//-----------------------------------------------------------------------------
+void Audio::setEnabled(bool enabled)
+{
+   _enabled = enabled;
+
+   if (!_enabled)
+   {
+      _music.stop();
+   }
+}
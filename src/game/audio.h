@@ -32,6 +32,9 @@ public:
 
    sf::Music& getMusic() const;
 
+   bool isEnabled() const;
+   void setEnabled(bool enabled);
+
 
 private:
 
@@ -46,5 +49,6 @@ private:
    mutable sf::Music _music;
    std::vector<Track> _tracks;
    uint32_t _current_index = 999;
+   bool _enabled = true;
 };
 
@@ -17,7 +17,7 @@ void BitmapFont::load(
 )
 {
    _texture = TexturePool::getInstance().get(texturePath);
-   _sprite.setTexture(*_texture);
+   _text_runs.clear();
 
    std::ifstream file(mapPath);
 
@@ -101,6 +101,25 @@ std::vector<std::shared_ptr<sf::IntRect>> BitmapFont::getCoords(const std::strin
 }
 
 
+void BitmapFont::appendGlyph(sf::VertexArray& vertices, const sf::IntRect& rect, int32_t x, int32_t y) const
+{
+   const auto left = static_cast<float>(x);
+   const auto top = static_cast<float>(y);
+   const auto right = static_cast<float>(x + rect.width);
+   const auto bottom = static_cast<float>(y + rect.height);
+
+   const auto u0 = static_cast<float>(rect.left);
+   const auto v0 = static_cast<float>(rect.top);
+   const auto u1 = static_cast<float>(rect.left + rect.width);
+   const auto v1 = static_cast<float>(rect.top + rect.height);
+
+   vertices.append(sf::Vertex({left, top}, {u0, v0}));
+   vertices.append(sf::Vertex({right, top}, {u1, v0}));
+   vertices.append(sf::Vertex({right, bottom}, {u1, v1}));
+   vertices.append(sf::Vertex({left, bottom}, {u0, v1}));
+}
+
+
 void BitmapFont::draw(
    sf::RenderTarget& window,
    const std::vector<std::shared_ptr<sf::IntRect> >& coords,
@@ -108,26 +127,84 @@ void BitmapFont::draw(
    int32_t y
 )
 {
+   sf::VertexArray vertices(sf::Quads);
+
    auto x_offset = 0;
    for (auto& coord : coords)
    {
-      _sprite.setTextureRect(
-         sf::IntRect(
-            coord->left,
-            coord->top,
-            coord->width,
-            coord->height
-         )
-      );
-
-      _sprite.setPosition(
-         static_cast<float>(x + x_offset),
-         static_cast<float>(y)
-      );
-
-      window.draw(_sprite);
+      appendGlyph(vertices, *coord, x + x_offset, y);
       x_offset += _char_width;
    }
 
+   window.draw(vertices, _texture.get());
+
    _text_width = x_offset;
 }
+
+
+void BitmapFont::draw(
+   sf::RenderTarget& window,
+   const std::string& text,
+   int32_t x,
+   int32_t y
+)
+{
+   static constexpr auto max_text_run_count = 256u;
+
+   _draw_counter++;
+
+   auto it = _text_runs.find(text);
+   if (it == _text_runs.end())
+   {
+      // drop the runs that haven't been drawn for a while once the cache is full
+      if (_text_runs.size() >= max_text_run_count)
+      {
+         for (auto run = _text_runs.begin(); run != _text_runs.end();)
+         {
+            run = (_draw_counter - run->second._last_used > max_text_run_count) ? _text_runs.erase(run) : std::next(run);
+         }
+
+         if (_text_runs.size() >= max_text_run_count)
+         {
+            _text_runs.clear();
+         }
+      }
+
+      it = _text_runs.emplace(text, TextRun{}).first;
+      it->second._width = append(it->second._vertices, text);
+   }
+
+   auto& run = it->second;
+   run._last_used = _draw_counter;
+
+   sf::RenderStates states;
+   states.texture = _texture.get();
+   states.transform.translate(static_cast<float>(x), static_cast<float>(y));
+   window.draw(run._vertices, states);
+
+   _text_width = run._width;
+}
+
+
+int32_t BitmapFont::append(
+   sf::VertexArray& vertices,
+   const std::string& text,
+   int32_t x,
+   int32_t y
+) const
+{
+   auto x_offset = 0;
+   for (auto c : text)
+   {
+      const auto it = _map.find(c);
+      if (it == _map.end())
+      {
+         continue;
+      }
+
+      appendGlyph(vertices, *it->second, x + x_offset, y);
+      x_offset += _char_width;
+   }
+
+   return x_offset;
+}
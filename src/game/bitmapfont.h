@@ -1,7 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
 
@@ -22,6 +26,10 @@
  * You can create the UV coordinates for a given text by calling getCoords.
  * Once you have them you can use the draw function to render a given vector of coordinates to a specified
  * position on the screen.
+ *
+ * Drawing a string directly caches its glyph quads in a vertex array that is re-used for as long as the same
+ * string is drawn, so text that doesn't change every frame is neither rebuilt nor drawn glyph by glyph.
+ * Text that changes every frame can be collected into one vertex array with append and drawn at once.
  */
 struct BitmapFont
 {
@@ -36,12 +44,39 @@ struct BitmapFont
       int32_t y = 0
    );
 
+   void draw(
+      sf::RenderTarget& window,
+      const std::string& text,
+      int32_t x = 0,
+      int32_t y = 0
+   );
+
+   int32_t append(
+      sf::VertexArray& vertices,
+      const std::string& text,
+      int32_t x = 0,
+      int32_t y = 0
+   ) const;
+
    std::shared_ptr<sf::Texture> _texture;
-   sf::Sprite _sprite;
    std::map<char, std::shared_ptr<sf::IntRect>> _map;
 
    int32_t _char_width = 0;
    int32_t _char_height = 0;
    int32_t _text_width = 0;
+
+private:
+
+   struct TextRun
+   {
+      sf::VertexArray _vertices{sf::Quads};
+      int32_t _width = 0;
+      uint32_t _last_used = 0;
+   };
+
+   void appendGlyph(sf::VertexArray& vertices, const sf::IntRect& rect, int32_t x, int32_t y) const;
+
+   std::unordered_map<std::string, TextRun> _text_runs;
+   uint32_t _draw_counter = 0;
 };
 
@@ -77,7 +77,7 @@ Bow::~Bow()
 }
 
 
-void Bow::load(b2World* world)
+void Bow::load(const std::shared_ptr<b2World>& world)
 {
    auto arrow = _loaded_arrow = new Arrow();
 
@@ -92,32 +92,39 @@ void Bow::load(b2World* world)
       _projectiles.erase(std::remove(_projectiles.begin(), _projectiles.end(), arrow), _projectiles.end());
    });
 
-   b2BodyDef body_def;
-   body_def.type = b2_dynamicBody;
-   body_def.position.Set(0, 5);
-
-   b2PolygonShape polygon_shape;
-   b2Vec2 vertices[4];
-   vertices[0].Set(arrow_tail * scale,  0.0f               );
-   vertices[1].Set( 0.0,               -arrow_width * scale);
-   vertices[2].Set(arrow_tip * scale,   0.0f               );
-   vertices[3].Set( 0.0,                arrow_width * scale);
-   polygon_shape.Set(vertices, 4);
-
-   b2FixtureDef fixture_def;
-   fixture_def.shape = &polygon_shape;
-   fixture_def.density = 1.0f;
-   fixture_def.filter.groupIndex   = group_index;
-   fixture_def.filter.maskBits     = mask_bits_standing;
-   fixture_def.filter.categoryBits = category_bits;
-
-   auto loaded_arrow_body = world->CreateBody(&body_def);
-   auto fixture = loaded_arrow_body->CreateFixture(&fixture_def);
-   loaded_arrow_body->SetAngularDamping(3);
+   auto loaded_arrow_body = acquirePooledBody(world, {0.0f, 5.0f});
+
+   if (!loaded_arrow_body)
+   {
+      b2BodyDef body_def;
+      body_def.type = b2_dynamicBody;
+      body_def.position.Set(0, 5);
+
+      b2PolygonShape polygon_shape;
+      b2Vec2 vertices[4];
+      vertices[0].Set(arrow_tail * scale,  0.0f               );
+      vertices[1].Set( 0.0,               -arrow_width * scale);
+      vertices[2].Set(arrow_tip * scale,   0.0f               );
+      vertices[3].Set( 0.0,                arrow_width * scale);
+      polygon_shape.Set(vertices, 4);
+
+      b2FixtureDef fixture_def;
+      fixture_def.shape = &polygon_shape;
+      fixture_def.density = 1.0f;
+      fixture_def.filter.groupIndex   = group_index;
+      fixture_def.filter.maskBits     = mask_bits_standing;
+      fixture_def.filter.categoryBits = category_bits;
+
+      loaded_arrow_body = world->CreateBody(&body_def);
+      loaded_arrow_body->CreateFixture(&fixture_def);
+      loaded_arrow_body->SetAngularDamping(3);
+   }
+
    loaded_arrow_body->SetGravityScale(0.0f);
-   fixture->SetUserData(_loaded_arrow);
+   loaded_arrow_body->GetFixtureList()->SetUserData(_loaded_arrow);
 
    _loaded_arrow->setBody(loaded_arrow_body);
+   setupBodyRecycling(_loaded_arrow);
 }
 
 
@@ -132,7 +139,7 @@ void Bow::use(
    // 2) pull
    // 3) release
    // Right now it's just firing into walking direction.
-   load(world.get());
+   load(world);
 
    _arrows.push_back(_loaded_arrow);
 
@@ -147,7 +154,7 @@ void Bow::use(
    _loaded_arrow->getBody()->SetAngularVelocity(0.0f);
    _loaded_arrow->getBody()->SetTransform(pos, angle);
    _loaded_arrow->getBody()->SetLinearVelocity(velocity);
-   _loaded_arrow->setProperty("damage", _damage);
+   _loaded_arrow->setProperty(FixtureNode::Property::Damage, _damage);
 
    updateRotation(_loaded_arrow);
    copyReferenceAnimation(_loaded_arrow);
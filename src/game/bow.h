@@ -18,7 +18,7 @@ public:
    Bow();
    virtual ~Bow();
 
-   void load(b2World* world);
+   void load(const std::shared_ptr<b2World>& world);
 
    void use(
       const std::shared_ptr<b2World>& world,
@@ -1,6 +1,7 @@
 #include "camerasystem.h"
 
 #include "cameraroomlock.h"
+#include "fixedtimestep.h"
 #include "framework/easings/easings.h"
 #include "gameconfiguration.h"
 #include "player/player.h"
@@ -227,6 +228,28 @@ void CameraSystem::syncNow()
 
    _x_px = player_x;
    _y_px = player_y;
+
+   // don't interpolate from where the camera was before
+   storePreviousPosition();
+}
+
+
+void CameraSystem::storePreviousPosition()
+{
+   _x_previous_px = getX();
+   _y_previous_px = getY();
+}
+
+
+float CameraSystem::getXInterpolated() const
+{
+   return _x_previous_px + (getX() - _x_previous_px) * FixedTimeStep::getInstance().getInterpolationAlpha();
+}
+
+
+float CameraSystem::getYInterpolated() const
+{
+   return _y_previous_px + (getY() - _y_previous_px) * FixedTimeStep::getInstance().getInterpolationAlpha();
 }
 
 
@@ -17,6 +17,11 @@ class CameraSystem
       float getX() const;
       float getY() const;
 
+      // the camera position blended between the last two simulation steps, used for rendering
+      float getXInterpolated() const;
+      float getYInterpolated() const;
+      void storePreviousPosition();
+
       float getFocusZoneX0() const;
       float getFocusZoneX1() const;
 
@@ -44,6 +49,9 @@ class CameraSystem
       float _x_px = 0.0f;
       float _y_px = 0.0f;
 
+      float _x_previous_px = 0.0f;
+      float _y_previous_px = 0.0f;
+
       float _dx_px = 0.0f;
       float _dy_px = 0.0f;
 
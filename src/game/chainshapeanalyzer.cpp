@@ -1,143 +1,227 @@
 #include "chainshapeanalyzer.h"
 
 #include <algorithm>
-#include <iostream>
-#include <set>
-#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
 
-#include "constants.h"
-#include "fixturenode.h"
 #include "player/player.h"
 
 namespace
 {
 
-struct IndexedVector
+// a conflict is only relevant when the foot sensor is on top of it, a few tiles per cell keep the lookup small
+constexpr auto cell_size_m = 4.0f * PIXELS_PER_TILE / PPM;
+
+struct ChainRef
 {
-   int32_t _chain_index{0};
-   int32_t _vertex_index{0};
-   std::pair<float, float> _pos;
+   int32_t _chain_id{0};
    ObjectType _object_type{ObjectType::ObjectTypeInvalid};
-   b2ChainShape* _chain{nullptr};
+};
 
-   bool operator<(const IndexedVector& v) const
-   {
-      return _pos < v._pos;
-   }
+struct Vertex
+{
+   b2Vec2 _pos;
+   std::vector<ChainRef> _chains;
+   bool _conflicting{false};
+};
+
+struct Chain
+{
+   std::vector<uint64_t> _vertex_keys;
 };
 
 b2Vec2 player_position_last_m;
-std::set<std::pair<float, float>> _conflicting_pos_set_m;
-std::vector<b2Vec2> _conflicting_positions_m;
-std::vector<sf::Vector2f> _conflicting_positions_px;
-std::set<IndexedVector> _indexed_vectors;
 
-}  // namespace
+// vertices are matched on their exact position, just like the chains share them in the obj files
+std::unordered_map<uint64_t, Vertex> _vertices;
+std::unordered_map<int32_t, Chain> _chains;
+std::unordered_map<uint64_t, std::vector<b2Vec2>> _conflicting_cells_m;
+
+uint64_t vertexKey(const b2Vec2& pos)
+{
+   // -0.0 and 0.0 compare equal but have different bit patterns
+   const auto x = pos.x + 0.0f;
+   const auto y = pos.y + 0.0f;
+
+   uint32_t x_bits = 0;
+   uint32_t y_bits = 0;
+   std::memcpy(&x_bits, &x, sizeof(x_bits));
+   std::memcpy(&y_bits, &y, sizeof(y_bits));
+   return (static_cast<uint64_t>(x_bits) << 32) | y_bits;
+}
+
+int32_t cellCoordinate(float value_m)
+{
+   return static_cast<int32_t>(std::floor(value_m / cell_size_m));
+}
+
+uint64_t cellKey(int32_t x, int32_t y)
+{
+   return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint64_t cellKey(const b2Vec2& pos)
+{
+   return cellKey(cellCoordinate(pos.x), cellCoordinate(pos.y));
+}
+
+void addConflict(const b2Vec2& pos)
+{
+   _conflicting_cells_m[cellKey(pos)].push_back(pos);
+}
 
-void ChainShapeAnalyzer::analyze(const std::shared_ptr<b2World>& world)
+void removeConflict(const b2Vec2& pos)
 {
-   _indexed_vectors.clear();
+   auto it = _conflicting_cells_m.find(cellKey(pos));
+   if (it == _conflicting_cells_m.end())
+   {
+      return;
+   }
 
-   int32_t chain_index = 0;
-   for (auto body = world->GetBodyList(); body != nullptr; body = body->GetNext())
+   auto& positions = it->second;
+   positions.erase(
+      std::remove_if(positions.begin(), positions.end(), [&pos](const auto& p) { return p == pos; }), positions.end()
+   );
+
+   if (positions.empty())
    {
-      if (body->GetType() != b2_staticBody)
-      {
-         continue;
+      _conflicting_cells_m.erase(it);
+   }
+}
+
+// two chains of a different type sharing a vertex (like a one-sided wall next to a solid block) cause the hiccup
+void updateConflict(Vertex& vertex)
+{
+   const auto& chains = vertex._chains;
+   const auto conflicting = std::any_of(chains.begin(), chains.end(), [&chains](const auto& ref) {
+         return ref._chain_id != chains.front()._chain_id && ref._object_type != chains.front()._object_type;
       }
+   );
 
-      auto fixture = body->GetFixtureList();
-      while (fixture)
-      {
-         int32_t vertex_index = 0;
+   if (conflicting == vertex._conflicting)
+   {
+      return;
+   }
 
-         auto next = fixture->GetNext();
-         auto shape = fixture->GetShape();
+   vertex._conflicting = conflicting;
 
-         if (shape->GetType() != b2Shape::e_chain)
-         {
-            fixture = next;
-            continue;
-         }
+   if (conflicting)
+   {
+      addConflict(vertex._pos);
+   }
+   else
+   {
+      removeConflict(vertex._pos);
+   }
+}
+
+}  // namespace
 
-         chain_index++;
+void ChainShapeAnalyzer::clear()
+{
+   _vertices.clear();
+   _chains.clear();
+   _conflicting_cells_m.clear();
+}
 
-         auto chain = dynamic_cast<b2ChainShape*>(shape);
+void ChainShapeAnalyzer::addChain(int32_t chain_id, const std::vector<b2Vec2>& chain, ObjectType object_type)
+{
+   removeChain(chain_id);
 
-         auto object_type = ObjectType::ObjectTypeInvalid;
-         auto user_data = static_cast<FixtureNode*>(fixture->GetUserData());
-         if (user_data)
-         {
-            object_type = user_data->getType();
-         }
+   auto& vertex_keys = _chains[chain_id]._vertex_keys;
+   vertex_keys.reserve(chain.size());
 
-         for (auto i = 0; i < chain->m_count; i++)
-         {
-            auto pos = chain->m_vertices[i];
+   for (const auto& pos : chain)
+   {
+      const auto key = vertexKey(pos);
+      vertex_keys.push_back(key);
 
-            const auto iv = IndexedVector{chain_index, vertex_index, {pos.x, pos.y}, object_type, chain};
-            const auto it = _indexed_vectors.find(iv);
+      auto& vertex = _vertices[key];
+      vertex._pos = pos;
+      vertex._chains.push_back({chain_id, object_type});
+      updateConflict(vertex);
+   }
+}
 
-            if (it == _indexed_vectors.end())
-            {
-               _indexed_vectors.insert(iv);
-            }
-            else if (chain_index != it->_chain_index && object_type != it->_object_type)
-            {
-               // check if the vertex needs a ghost vertex on the left or on the right
-               // auto isOnTheRightOfCollisionPos = [](const b2Vec2& colliding_vertex, b2Vec2* vertices, int32_t count)
-               // {
-               //    return std::any_of(
-               //       vertices,
-               //       vertices + count,
-               //       [colliding_vertex](auto pos)
-               //       {
-               //          // std::cout << pos.x * PPM << " vs " << colliding_vertex.x * PPM << std::endl;
-               //          return (pos.x - 0.001f > colliding_vertex.x) && (fabs(pos.y - colliding_vertex.y) < 0.001f);
-               //       }
-               //    );
-               // };
-               //
-               // const auto chain_is_on_the_right_of_the_collision =
-               //   isOnTheRightOfCollisionPos(pos, chain->m_vertices, chain->m_count);
-               //
-               // const auto collision_is_on_the_right_of_the_one_way_wall =
-               //   (object_type == ObjectTypeSolid && chain_is_on_the_right_of_the_collision);
-               //
-               // std::cout << "chain " << chain_index << ", vertex: [" << vertex_index << "/" << (chain->m_count - 1) << "], pos("
-               //           << iv._pos.first * PPM << ", " << iv._pos.second * PPM << ") collides with chain: " << it->_chain_index
-               //           << ", vertex: [" << it->_vertex_index << "/" << (it->_chain->m_count - 1) << "]"
-               //           << ", pos(" << it->_pos.first * PPM << ", " << it->_pos.second * PPM << ")"
-               //           << " on the " << (collision_is_on_the_right_of_the_one_way_wall ? "right" : "left") << " side" << std::endl;
-
-               _conflicting_pos_set_m.insert({pos.x, pos.y});
-            }
-            vertex_index++;
+void ChainShapeAnalyzer::removeChain(int32_t chain_id)
+{
+   auto chain_it = _chains.find(chain_id);
+   if (chain_it == _chains.end())
+   {
+      return;
+   }
+
+   for (const auto key : chain_it->second._vertex_keys)
+   {
+      auto vertex_it = _vertices.find(key);
+      if (vertex_it == _vertices.end())
+      {
+         continue;
+      }
+
+      auto& vertex = vertex_it->second;
+      auto& chains = vertex._chains;
+      chains.erase(
+         std::remove_if(chains.begin(), chains.end(), [chain_id](const auto& ref) { return ref._chain_id == chain_id; }),
+         chains.end()
+      );
+
+      if (chains.empty())
+      {
+         if (vertex._conflicting)
+         {
+            removeConflict(vertex._pos);
          }
 
-         fixture = next;
+         _vertices.erase(vertex_it);
+         continue;
       }
-   }
 
-   for (const auto& pos_m : _conflicting_pos_set_m)
-   {
-      _conflicting_positions_m.push_back({pos_m.first, pos_m.second});
-      _conflicting_positions_px.push_back({pos_m.first * PPM, pos_m.second * PPM});
+      updateConflict(vertex);
    }
+
+   _chains.erase(chain_it);
 }
 
 std::optional<b2Vec2> ChainShapeAnalyzer::checkPlayerAtCollisionPosition()
 {
+   if (_conflicting_cells_m.empty())
+   {
+      return std::nullopt;
+   }
+
    auto player = Player::getCurrent();
    auto foot_sensor_fixture = player->getFootSensorFixture();
    const auto& world_transform = player->getBody()->GetTransform();
+   const auto shape = foot_sensor_fixture->GetShape();
 
-   for (const auto& bad_pos_m : _conflicting_positions_m)
+   b2AABB foot_aabb;
+   shape->ComputeAABB(&foot_aabb, world_transform, 0);
+
+   const auto x0 = cellCoordinate(foot_aabb.lowerBound.x);
+   const auto y0 = cellCoordinate(foot_aabb.lowerBound.y);
+   const auto x1 = cellCoordinate(foot_aabb.upperBound.x);
+   const auto y1 = cellCoordinate(foot_aabb.upperBound.y);
+
+   for (auto y = y0; y <= y1; y++)
    {
-      const auto point_inside_rect = foot_sensor_fixture->GetShape()->TestPoint(world_transform, bad_pos_m);
-      if (point_inside_rect)
+      for (auto x = x0; x <= x1; x++)
       {
-         return bad_pos_m;
+         const auto it = _conflicting_cells_m.find(cellKey(x, y));
+         if (it == _conflicting_cells_m.end())
+         {
+            continue;
+         }
+
+         for (const auto& bad_pos_m : it->second)
+         {
+            const auto point_inside_rect = shape->TestPoint(world_transform, bad_pos_m);
+            if (point_inside_rect)
+            {
+               return bad_pos_m;
+            }
+         }
       }
    }
 
@@ -168,7 +252,6 @@ correct, bridge on the left, floor on the right
            |
            +----------
 
-
 chain 49, vector: 19, pos(9480, 2400) collides with chain: 16, vector: 0, pos(9480, 2400)
 ----------++-----------+
           ||///////////|
@@ -185,7 +268,6 @@ chain 49, vector: 20, pos(9360, 2400) collides with chain: 17, vector: 3, pos(93
            |
            +----------
 
-
 chain 49, vector: 52, pos(6360, 2952) collides with chain: 9, vector: 3, pos(6360, 2952)
 +---------++----------
 |/////////||
@@ -194,8 +276,6 @@ chain 49, vector: 52, pos(6360, 2952) collides with chain: 9, vector: 3, pos(636
            |
            +----------
 
-
-
 chain 53, vector: 47, pos(10584, 1968) collides with chain: 22, vector: 0, pos(10584, 1968)
 ----------++-----------+
           ||///////////|
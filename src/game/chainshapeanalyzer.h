@@ -1,6 +1,7 @@
 #ifndef CHAINSHAPEANALYZER_H
 #define CHAINSHAPEANALYZER_H
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 #include "Box2D/Box2D.h"
@@ -19,10 +20,16 @@
 //
 //
 // player will jump a bit up between the two adjacent vertices (!!)
+//
+// chains are registered while the level is built and whenever a static chain is added or removed later on.
+// only the vertices of the affected chain are re-evaluated, the conflicting positions are kept in a grid
+// so the per-frame check only looks at the cells underneath the player's feet.
 
 namespace ChainShapeAnalyzer
 {
-void analyze(const std::shared_ptr<b2World>& world);
+void clear();
+void addChain(int32_t chain_id, const std::vector<b2Vec2>& chain, ObjectType object_type);
+void removeChain(int32_t chain_id);
 std::optional<b2Vec2> checkPlayerAtCollisionPosition();
 bool checkPlayerHiccup();
 b2Vec2 lastGoodPosition();
@@ -334,7 +334,7 @@ void DebugDraw::debugBodies(sf::RenderTarget& target, Level* level)
    // )
    //
 
-   auto bodies = WorldQuery::retrieveBodiesOnScreen(level->getWorld(), screen);
+   const auto& bodies = WorldQuery::retrieveBodiesOnScreen(level->getWorld(), screen);
 
    for (auto body : bodies)
    {
@@ -476,11 +476,12 @@ void DebugDraw::debugHitboxes(sf::RenderTarget& target)
    using namespace std::chrono_literals;
 
    const auto screen = getScreenRect(target);
-   const auto nodes = WorldQuery::findNodes(screen);
+   static std::vector<LuaNode*> __nodes;
+   WorldQuery::findNodes(screen, __nodes);
 
    const auto now = std::chrono::high_resolution_clock::now();
 
-   for (const auto& node : nodes)
+   for (const auto node : __nodes)
    {
       const auto hit_time = node->getHitTime();
       if (!hit_time.has_value())
@@ -0,0 +1,223 @@
+#include "dynamicresolution.h"
+
+#include "framework/tools/gltimerquery.h"
+#include "framework/tools/log.h"
+
+#include <algorithm>
+
+
+namespace
+{
+// samples needed before the smoothed gpu time is trusted
+constexpr auto min_sample_count = 30;
+
+// frames between two scale changes, each change re-creates the level render textures
+constexpr auto min_frames_between_changes = 120;
+
+// weight of a new sample in the smoothed gpu time
+constexpr auto smoothing = 0.1f;
+
+// only scale up if the higher scale is expected to stay this far below the budget
+constexpr auto scale_up_headroom = 0.9f;
+}
+
+
+//-----------------------------------------------------------------------------
+DynamicResolution& DynamicResolution::getInstance()
+{
+   static DynamicResolution __instance;
+   return __instance;
+}
+
+
+//-----------------------------------------------------------------------------
+bool DynamicResolution::isEnabled() const
+{
+   return _enabled;
+}
+
+
+//-----------------------------------------------------------------------------
+void DynamicResolution::setEnabled(bool enabled)
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   if (enabled && !GlTimerQuery::get().isAvailable())
+   {
+      Log::Warning() << "dynamic resolution requires gpu timer queries which are not supported by this driver";
+      return;
+   }
+
+   _enabled = enabled;
+   _sample_count = 0;
+   _frames_since_change = 0;
+#else
+   Log::Warning() << "dynamic resolution requires sfml 2.4 or newer";
+   static_cast<void>(enabled);
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void DynamicResolution::beginFrame()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   if (!_enabled)
+   {
+      return;
+   }
+
+   const auto& gl = GlTimerQuery::get();
+
+   if (!_queries_created)
+   {
+      for (auto& query : _queries)
+      {
+         gl._gen_queries(1, &query._begin_id);
+         gl._gen_queries(1, &query._end_id);
+      }
+
+      _queries_created = true;
+   }
+
+   // all queries still in flight, skip measuring this frame rather than stalling
+   auto& query = _queries[_query_index];
+   if (query._pending)
+   {
+      return;
+   }
+
+   gl._query_counter(query._begin_id, GlTimerQuery::timestamp);
+   _frame_active = true;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void DynamicResolution::endFrame()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   if (!_frame_active)
+   {
+      return;
+   }
+
+   auto& query = _queries[_query_index];
+   GlTimerQuery::get()._query_counter(query._end_id, GlTimerQuery::timestamp);
+   query._pending = true;
+
+   _query_index = (_query_index + 1) % query_count;
+   _frame_active = false;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+void DynamicResolution::collectQueries()
+{
+#ifdef GL_TIMER_QUERIES_SUPPORTED
+   const auto& gl = GlTimerQuery::get();
+
+   // the oldest query is the one that is going to be re-used next
+   for (auto i = 0; i < query_count; i++)
+   {
+      auto& query = _queries[(_query_index + i) % query_count];
+      if (!query._pending)
+      {
+         continue;
+      }
+
+      GLuint available = 0;
+      gl._get_query_object_uiv(query._end_id, GlTimerQuery::query_result_available, &available);
+      if (!available)
+      {
+         break;
+      }
+
+      uint64_t begin_ns = 0;
+      uint64_t end_ns = 0;
+      gl._get_query_object_ui64v(query._begin_id, GlTimerQuery::query_result, &begin_ns);
+      gl._get_query_object_ui64v(query._end_id, GlTimerQuery::query_result, &end_ns);
+      query._pending = false;
+
+      const auto sample_ms = static_cast<float>(end_ns - begin_ns) / 1000000.0f;
+      _gpu_time_ms = (_sample_count == 0) ? sample_ms : (_gpu_time_ms + (sample_ms - _gpu_time_ms) * smoothing);
+      _sample_count++;
+   }
+#endif
+}
+
+
+//-----------------------------------------------------------------------------
+bool DynamicResolution::update()
+{
+   if (!_enabled)
+   {
+      return false;
+   }
+
+   collectQueries();
+
+   _frames_since_change++;
+
+   if (_sample_count < min_sample_count || _frames_since_change < min_frames_between_changes)
+   {
+      return false;
+   }
+
+   const auto scale = getScale();
+   auto next_scale = scale;
+
+   if (_gpu_time_ms > _budget_ms && scale > 1)
+   {
+      next_scale = scale - 1;
+   }
+   else if (scale < _maximum_scale)
+   {
+      // fill cost grows with the number of pixels, i.e. quadratically with the scale
+      const auto growth = static_cast<float>((scale + 1) * (scale + 1)) / static_cast<float>(scale * scale);
+      if (_gpu_time_ms * growth < _budget_ms * scale_up_headroom)
+      {
+         next_scale = scale + 1;
+      }
+   }
+
+   if (next_scale == scale)
+   {
+      return false;
+   }
+
+   Log::Info() << "dynamic resolution: gpu time " << _gpu_time_ms << "ms, render scale " << scale << " -> " << next_scale;
+
+   _scale = next_scale;
+   _sample_count = 0;
+   _frames_since_change = 0;
+
+   return true;
+}
+
+
+//-----------------------------------------------------------------------------
+void DynamicResolution::setMaximumScale(int32_t scale)
+{
+   _maximum_scale = std::max(scale, 1);
+
+   // start off at the best quality the window allows
+   if (_scale == 0)
+   {
+      _scale = _maximum_scale;
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+int32_t DynamicResolution::getScale() const
+{
+   return std::clamp(_scale, 1, _maximum_scale);
+}
+
+
+//-----------------------------------------------------------------------------
+float DynamicResolution::getGpuTimeMs() const
+{
+   return _gpu_time_ms;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/*! \brief Adjusts the level render scale to the measured gpu time
+ *
+ *  The gpu time of the level rendering is measured by timestamp queries around Level::draw which are read back
+ *  a few frames later. When the smoothed gpu time exceeds the budget, the integer render scale of the level
+ *  textures is lowered by one. When the next higher scale is expected to fit into the budget, it is raised
+ *  again up to the scale derived from the window size. Since each change re-creates the level render textures,
+ *  changes are at least a couple of seconds apart.
+ *
+ *  usage
+ *     if (DynamicResolution::getInstance().update())
+ *     {
+ *        level->initializeTextures();
+ *     }
+ */
+class DynamicResolution
+{
+public:
+
+   static DynamicResolution& getInstance();
+
+   bool isEnabled() const;
+   void setEnabled(bool enabled);
+
+   void beginFrame();
+   void endFrame();
+   bool update();
+
+   void setMaximumScale(int32_t scale);
+   int32_t getScale() const;
+   float getGpuTimeMs() const;
+
+
+private:
+
+   struct FrameQuery
+   {
+      uint32_t _begin_id = 0;
+      uint32_t _end_id = 0;
+      bool _pending = false;
+   };
+
+   DynamicResolution() = default;
+
+   void collectQueries();
+
+   static constexpr auto query_count = 4;
+   std::array<FrameQuery, query_count> _queries;
+   int32_t _query_index = 0;
+   bool _queries_created = false;
+   bool _frame_active = false;
+
+   bool _enabled = false;
+   int32_t _scale = 0;
+   int32_t _maximum_scale = 1;
+
+   float _gpu_time_ms = 0.0f;
+   int32_t _sample_count = 0;
+   int32_t _frames_since_change = 0;
+
+   float _budget_ms = 12.0f;
+};
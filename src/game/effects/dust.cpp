@@ -5,6 +5,7 @@
 #include "framework/tmxparser/tmxproperties.h"
 #include "framework/tmxparser/tmxproperty.h"
 #include "framework/tmxparser/tmxtools.h"
+#include "texturepool.h"
 
 
 Dust::Dust(GameNode* parent)
@@ -16,73 +17,23 @@ Dust::Dust(GameNode* parent)
 
 void Dust::update(const sf::Time& dt)
 {
-   const auto dt_s = dt.asSeconds();
-
-   for (auto& p : _particles)
+   if (_emitter)
    {
-      const auto x_px = p._position.x - _clip_rect.left;
-      const auto y_px = p._position.y - _clip_rect.top;
-
-      if (x_px < 0 || x_px >= _clip_rect.width || y_px < 0 || y_px >= _clip_rect.height)
-      {
-         p.spawn(_clip_rect);
-         continue;
-      }
-
-      const auto col = _flow_field_image.getPixel(static_cast<int32_t>(x_px), static_cast<int32_t>(y_px));
-      const auto col_x = (static_cast<float>(col.r) / 255.0f) - 0.5f;
-      const auto col_y = (static_cast<float>(col.g) / 255.0f) - 0.5f;
-      const auto col_z = (static_cast<float>(col.b) / 255.0f) - 0.5f;
-      const auto dir = sf::Vector3f{col_x, col_y, col_z};
-
-      p._position = p._position + dir * dt_s * _particle_velocity + _wind_direction * dt_s * _particle_velocity;
-      p._z = col_z;
-      p._age += dt_s;
-
-      if (p._age > p._lifetime)
-      {
-         p.spawn(_clip_rect);
-      }
+      _emitter->update(dt);
    }
 }
 
 
-
 void Dust::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
 {
-   static const auto alpha_default = 50;
-
-   for (const auto& p : _particles)
+   if (!_emitter)
    {
-      const auto pos = p._position;
-      auto alpha = 0.0f;
-
-      if (p._age > p._lifetime - 1.0f)
-      {
-         alpha = (p._lifetime - p._age) * alpha_default;
-      }
-      else if (p._age < 1.0f)
-      {
-         alpha = p._age * alpha_default;
-      }
-      else
-      {
-         alpha = alpha_default + p._z * 50.0f;
-      }
-
-      const auto col = sf::Color{_particle_color.r, _particle_color.g, _particle_color.b, static_cast<uint8_t>(alpha)};
-
-      sf::Vertex quad[] = {
-         sf::Vertex(sf::Vector2f(pos.x,                     pos.y                    ), col),
-         sf::Vertex(sf::Vector2f(pos.x,                     pos.y + _particle_size_px), col),
-         sf::Vertex(sf::Vector2f(pos.x + _particle_size_px, pos.y + _particle_size_px), col),
-         sf::Vertex(sf::Vector2f(pos.x + _particle_size_px, pos.y                    ), col)
-      };
-
-      sf::RenderStates states;
-      states.blendMode = sf::BlendAlpha;
-      target.draw(quad, 4, sf::Quads, states);
+      return;
    }
+
+   sf::RenderStates states;
+   states.blendMode = sf::BlendAlpha;
+   _emitter->draw(target, states);
 }
 
 
@@ -92,6 +43,7 @@ std::shared_ptr<Dust> Dust::deserialize(GameNode* parent, const GameDeserializeD
    dust->setObjectId(data._tmx_object->_name);
 
    std::string flowfield_texture = "data/effects/flowfield_3.png";
+   auto particle_count = 0;
 
    dust->_clip_rect = sf::FloatRect {
       data._tmx_object->_x_px,
@@ -123,13 +75,7 @@ std::shared_ptr<Dust> Dust::deserialize(GameNode* parent, const GameDeserializeD
 
       if (particle_count_it != data._tmx_object->_properties->_map.end())
       {
-         const auto particle_count = particle_count_it->second->_value_int.value();
-         for (auto i = 0; i < particle_count; i++)
-         {
-            Particle p;
-            p.spawn(dust->_clip_rect);
-            dust->_particles.push_back(p);
-         }
+         particle_count = particle_count_it->second->_value_int.value();
       }
 
       if (wind_dir_x_it != data._tmx_object->_properties->_map.end())
@@ -159,20 +105,19 @@ std::shared_ptr<Dust> Dust::deserialize(GameNode* parent, const GameDeserializeD
       }
    }
 
-   sf::Texture flow_field;
-   flow_field.loadFromFile(flowfield_texture);
-   dust->_flow_field_image = flow_field.copyToImage();
+   dust->_flow_field_texture = TexturePool::getInstance().get(flowfield_texture);
 
-   return dust;
-}
+   // the particles are animated by the shader, the emitter just needs to know the dust's parameters once
+   dust->_emitter = std::make_unique<GpuParticleEmitter>("data/shaders/particles_dust.vert", "data/shaders/particles.frag", particle_count);
+   dust->_emitter->setUniform("u_clip_rect", sf::Glsl::Vec4{dust->_clip_rect.left, dust->_clip_rect.top, dust->_clip_rect.width, dust->_clip_rect.height});
+   dust->_emitter->setUniform("u_wind_direction", sf::Glsl::Vec2{dust->_wind_direction.x, dust->_wind_direction.y});
+   dust->_emitter->setUniform("u_velocity", dust->_particle_velocity);
+   dust->_emitter->setUniform("u_size", static_cast<float>(dust->_particle_size_px));
+   dust->_emitter->setUniform("u_color", sf::Glsl::Vec4{dust->_particle_color});
+   dust->_emitter->setUniform("u_flow_field", dust->_flow_field_texture);
 
+   const auto flow_field_size = dust->_flow_field_texture->getSize();
+   dust->_emitter->setUniform("u_flow_field_size", sf::Glsl::Vec2{static_cast<float>(flow_field_size.x), static_cast<float>(flow_field_size.y)});
 
-void Dust::Particle::spawn(sf::FloatRect& rect)
-{
-   _position.x = rect.left + std::rand() % static_cast<int32_t>(rect.width);
-   _position.y = rect.top + std::rand() % static_cast<int32_t>(rect.height);
-   _age = 0.0f;
-   _lifetime = 5.0f + (std::rand() % 100) * 0.1f;
+   return dust;
 }
-
-
@@ -3,10 +3,9 @@
 #include "gamedeserializedata.h"
 #include "game/gamemechanism.h"
 #include "game/gamenode.h"
+#include "gpuparticleemitter.h"
 
 #include <SFML/Graphics.hpp>
-#include <array>
-#include <deque>
 #include <memory>
 
 
@@ -14,17 +13,6 @@ struct TmxObject;
 
 class Dust : public GameMechanism, public GameNode
 {
-   struct Particle
-   {
-      void spawn(sf::FloatRect& rect);
-      sf::Vector3f _position;
-      sf::Vector3f _direction;
-      float _age = 0.0f;
-      float _lifetime = 0.0f;
-      float _z = 0.0f;
-   };
-
-
    public:
 
       Dust(GameNode* parent = nullptr);
@@ -37,12 +25,11 @@ class Dust : public GameMechanism, public GameNode
 
    private:
 
-      std::vector<Particle> _particles;
+      std::unique_ptr<GpuParticleEmitter> _emitter;
       sf::FloatRect _clip_rect;
-      sf::Image _flow_field_image;
+      std::shared_ptr<sf::Texture> _flow_field_texture;
       sf::Vector3f _wind_direction;
       sf::Color _particle_color = {255, 255, 255, 255};
       float _particle_velocity = 100.0f;
       uint8_t _particle_size_px = 2;
 };
-
@@ -0,0 +1,133 @@
+#include "gpuparticleemitter.h"
+
+#include "framework/tools/log.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <type_traits>
+
+
+//-----------------------------------------------------------------------------
+GpuParticleEmitter::GpuParticleEmitter(
+   const std::string& vertex_shader_path,
+   const std::string& fragment_shader_path,
+   int32_t particle_count
+)
+ : _shader(getShader(vertex_shader_path, fragment_shader_path)),
+   _vertex_buffer(sf::Quads, sf::VertexBuffer::Static)
+{
+   // each vertex only knows its particle's seed (0..1) and its quad corner (0..3)
+   _vertices.reserve(static_cast<size_t>(particle_count) * 4);
+   for (auto particle = 0; particle < particle_count; particle++)
+   {
+      const auto seed = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+
+      for (auto corner = 0; corner < 4; corner++)
+      {
+         _vertices.emplace_back(sf::Vector2f{}, sf::Vector2f{seed, static_cast<float>(corner)});
+      }
+   }
+
+   if (sf::VertexBuffer::isAvailable() && !_vertices.empty())
+   {
+      _vertex_buffer.create(_vertices.size());
+      _vertex_buffer.update(_vertices.data());
+      _vertices.clear();
+      _vertices.shrink_to_fit();
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<sf::Shader> GpuParticleEmitter::getShader(const std::string& vertex_shader_path, const std::string& fragment_shader_path)
+{
+   static std::mutex __mutex;
+   static std::map<std::string, std::weak_ptr<sf::Shader>> __pool;
+
+   std::lock_guard<std::mutex> hold(__mutex);
+
+   const auto key = vertex_shader_path + "|" + fragment_shader_path;
+   auto shader = __pool[key].lock();
+   if (!shader)
+   {
+      __pool[key] = shader = std::make_shared<sf::Shader>();
+      if (!shader->loadFromFile(vertex_shader_path, fragment_shader_path))
+      {
+         Log::Error() << "error loading particle shader " << vertex_shader_path;
+      }
+   }
+
+   return shader;
+}
+
+
+//-----------------------------------------------------------------------------
+void GpuParticleEmitter::update(const sf::Time& dt)
+{
+   _time_s += dt.asSeconds();
+}
+
+
+//-----------------------------------------------------------------------------
+void GpuParticleEmitter::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+   _shader->setUniform("u_time", _time_s);
+
+   for (const auto& [name, value] : _uniforms)
+   {
+      std::visit(
+         [this, &name = name](const auto& uniform)
+         {
+            using T = std::decay_t<decltype(uniform)>;
+            if constexpr (std::is_same_v<T, std::shared_ptr<sf::Texture>>)
+            {
+               _shader->setUniform(name, *uniform);
+            }
+            else
+            {
+               _shader->setUniform(name, uniform);
+            }
+         },
+         value
+      );
+   }
+
+   states.shader = _shader.get();
+
+   if (_vertex_buffer.getVertexCount() > 0)
+   {
+      target.draw(_vertex_buffer, states);
+   }
+   else if (!_vertices.empty())
+   {
+      target.draw(_vertices.data(), _vertices.size(), sf::Quads, states);
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+void GpuParticleEmitter::setUniform(const std::string& name, float value)
+{
+   _uniforms[name] = value;
+}
+
+
+//-----------------------------------------------------------------------------
+void GpuParticleEmitter::setUniform(const std::string& name, const sf::Glsl::Vec2& value)
+{
+   _uniforms[name] = value;
+}
+
+
+//-----------------------------------------------------------------------------
+void GpuParticleEmitter::setUniform(const std::string& name, const sf::Glsl::Vec4& value)
+{
+   _uniforms[name] = value;
+}
+
+
+//-----------------------------------------------------------------------------
+void GpuParticleEmitter::setUniform(const std::string& name, const std::shared_ptr<sf::Texture>& texture)
+{
+   _uniforms[name] = texture;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+/*! \brief Particles that are animated entirely inside a vertex shader
+ *
+ *  Each particle is a quad whose vertices carry nothing but the particle's random seed and the quad corner
+ *  (texture coordinates x and y). The vertices are uploaded once when the emitter is created; from then on the
+ *  vertex shader derives position, age and color of each particle from the seed, the emitter time and the
+ *  emitter's uniforms. So animating an emitter costs the same on the cpu no matter how many particles it has,
+ *  and each emitter is drawn in a single call.
+ *
+ *  Shaders are shared between emitters of the same kind, the uniforms of each emitter are applied right before
+ *  it is drawn.
+ *
+ *  Particles that need to interact with the level (collisions, surfaces) can't be stateless and remain on the cpu.
+ */
+class GpuParticleEmitter
+{
+public:
+
+   GpuParticleEmitter(const std::string& vertex_shader_path, const std::string& fragment_shader_path, int32_t particle_count);
+
+   void update(const sf::Time& dt);
+   void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+
+   void setUniform(const std::string& name, float value);
+   void setUniform(const std::string& name, const sf::Glsl::Vec2& value);
+   void setUniform(const std::string& name, const sf::Glsl::Vec4& value);
+   void setUniform(const std::string& name, const std::shared_ptr<sf::Texture>& texture);
+
+
+private:
+
+   using Uniform = std::variant<float, sf::Glsl::Vec2, sf::Glsl::Vec4, std::shared_ptr<sf::Texture>>;
+
+   static std::shared_ptr<sf::Shader> getShader(const std::string& vertex_shader_path, const std::string& fragment_shader_path);
+
+   std::shared_ptr<sf::Shader> _shader;
+   std::map<std::string, Uniform> _uniforms;
+
+   // the vertex buffer keeps the particles in video memory; without driver support they're submitted each draw
+   sf::VertexBuffer _vertex_buffer;
+   std::vector<sf::Vertex> _vertices;
+
+   float _time_s = 0.0f;
+};
@@ -8,8 +8,10 @@
 #include "game/debugdraw.h"
 #include "game/level.h"
 #include "game/player/player.h"
+#include "game/worldquery.h"
 #include "texturepool.h"
 
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 
@@ -20,6 +22,17 @@
 namespace
 {
 static constexpr auto max_distance_m2 = 100.0f; // depends on the view dimensions
+
+// only fixtures within reach of a light can cast shadows
+b2AABB computeShadowBounds(const b2Vec2& light_pos_m)
+{
+   const auto max_distance_m = std::sqrt(max_distance_m2);
+
+   b2AABB aabb;
+   aabb.lowerBound = light_pos_m - b2Vec2(max_distance_m, max_distance_m);
+   aabb.upperBound = light_pos_m + b2Vec2(max_distance_m, max_distance_m);
+   return aabb;
+}
 }
 
 
@@ -45,148 +58,149 @@ LightSystem::LightSystem()
 
 
 //-----------------------------------------------------------------------------
-void LightSystem::drawShadowQuads(sf::RenderTarget& target, std::shared_ptr<LightSystem::LightInstance> light) const
+void LightSystem::drawShadowQuads(
+   sf::RenderTarget& target,
+   std::shared_ptr<LightSystem::LightInstance> light,
+   std::vector<b2Fixture*>& fixtures
+) const
 {
    // do not draw lights that are too far away
    auto player_body = Player::getCurrent()->getBody();
 
    auto light_pos_m = light->_pos_m + light->_center_offset_m;
 
-   for (auto body = Level::getCurrentLevel()->getWorld()->GetBodyList(); body; body = body->GetNext())
+   // chains have a broadphase proxy per edge, so they're reported once for every edge in range.
+   // large level outlines are split into chunks, so only the chunks close by are walked below.
+   std::sort(fixtures.begin(), fixtures.end());
+   fixtures.erase(std::unique(fixtures.begin(), fixtures.end()), fixtures.end());
+
+   for (auto fixture : fixtures)
    {
+      auto body = fixture->GetBody();
       if (body == player_body)
+      {
          continue;
+      }
 
-      if (!body->IsActive())
+      // if something doesn't collide, it probably shouldn't have any impact on lighting, too
+      if (fixture->IsSensor())
       {
          continue;
       }
 
-      for (auto fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
-      {
-         // if something doesn't collide, it probably shouldn't have any impact on lighting, too
-         if (fixture->IsSensor())
-         {
-            continue;
-         }
+      auto shape = fixture->GetShape();
 
-         auto shape = fixture->GetShape();
+      auto shape_polygon = dynamic_cast<b2PolygonShape*>(shape);
+      auto shape_chain = dynamic_cast<b2ChainShape*>(shape);
+      auto shape_circle = dynamic_cast<b2CircleShape*>(shape);
 
-         auto shape_polygon = dynamic_cast<b2PolygonShape*>(shape);
-         auto shape_chain = dynamic_cast<b2ChainShape*>(shape);
-         auto shape_circle = dynamic_cast<b2CircleShape*>(shape);
+      if (shape_circle)
+      {
+         auto center = shape_circle->GetVertex(0) + body->GetTransform().p;
+         if ((light_pos_m - center).LengthSquared() > max_distance_m2)
+            continue;
 
-         if (shape_circle)
+         std::array<b2Vec2, segments> circle_positions;
+         for (auto i = 0u; i < segments; i++)
          {
-            auto center = shape_circle->GetVertex(0) + body->GetTransform().p;
-            if ((light_pos_m - center).LengthSquared() > max_distance_m2)
-               continue;
+            circle_positions[i] = b2Vec2{
+               center.x + _unit_circle[i].x * shape_circle->m_radius * 1.2f,
+               center.y + _unit_circle[i].y * shape_circle->m_radius * 1.2f
+            };
+         }
 
-            std::array<b2Vec2, segments> circle_positions;
-            for (auto i = 0u; i < segments; i++)
+         for (auto pos_current = 0u; pos_current < circle_positions.size(); pos_current++)
+         {
+            auto pos_next = pos_current + 1;
+            if (pos_next == circle_positions.size())
             {
-               circle_positions[i] = b2Vec2{
-                  center.x + _unit_circle[i].x * shape_circle->m_radius * 1.2f,
-                  center.y + _unit_circle[i].y * shape_circle->m_radius * 1.2f
-               };
+               pos_next = 0;
             }
 
-            for (auto pos_current = 0u; pos_current < circle_positions.size(); pos_current++)
+            auto v0 = circle_positions[pos_current];
+            auto v1 = circle_positions[pos_next];
+
+            auto v0far = 10000.0f * (v0 - light_pos_m);
+            auto v1far = 10000.0f * (v1 - light_pos_m);
+
+            sf::Vertex quad[] =
             {
-               auto pos_next = pos_current + 1;
-               if (pos_next == circle_positions.size())
-               {
-                  pos_next = 0;
-               }
-
-               auto v0 = circle_positions[pos_current];
-               auto v1 = circle_positions[pos_next];
-
-               auto v0far = 10000.0f * (v0 - light_pos_m);
-               auto v1far = 10000.0f * (v1 - light_pos_m);
-
-               sf::Vertex quad[] =
-               {
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
-               };
-
-               target.draw(quad, 4, sf::Quads);
-            }
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
+            };
+
+            target.draw(quad, 4, sf::Quads);
          }
-         else if (shape_chain)
+      }
+      else if (shape_chain)
+      {
+         // for now it is assumed that chainshapes are static objects only.
+         // therefore no transform is applied to chainshape based objects.
+         // loops repeat their first vertex at the end, chunks of a loop are open, so there's no wrapping around.
+
+         for (auto pos_current = 0; pos_current < shape_chain->m_count - 1; pos_current++)
          {
-            // for now it is assumed that chainshapes are static objects only.
-            // therefore no transform is applied to chainshape based objects.
+            auto pos_next = pos_current + 1;
+
+            auto v0 = shape_chain->m_vertices[pos_current];
+            auto v1 = shape_chain->m_vertices[pos_next];
+
+            // printf("%f\n", (lightPos - v0).LengthSquared());
 
-            for (auto pos_current = 0; pos_current < shape_chain->m_count; pos_current++)
+            if (
+                  (light_pos_m - v0).LengthSquared() > max_distance_m2
+               && (light_pos_m - v1).LengthSquared() > max_distance_m2
+            )
             {
-               auto pos_next = pos_current + 1;
-               if (pos_next == shape_chain->m_count)
-               {
-                  pos_next = 0;
-               }
-
-               auto v0 = shape_chain->m_vertices[pos_current];
-               auto v1 = shape_chain->m_vertices[pos_next];
-
-               // printf("%f\n", (lightPos - v0).LengthSquared());
-
-               if (
-                     (light_pos_m - v0).LengthSquared() > max_distance_m2
-                  && (light_pos_m - v1).LengthSquared() > max_distance_m2
-               )
-               {
-                  continue;
-               }
-
-               auto v0_far = 10000.0f * (v0 - light_pos_m);
-               auto v1_far = 10000.0f * (v1 - light_pos_m);
-
-               sf::Vertex quad[] =
-               {
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v0_far.x, v0_far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1_far.x, v1_far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
-               };
-
-               target.draw(quad, 4, sf::Quads);
+               continue;
             }
+
+            auto v0_far = 10000.0f * (v0 - light_pos_m);
+            auto v1_far = 10000.0f * (v1 - light_pos_m);
+
+            sf::Vertex quad[] =
+            {
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v0_far.x, v0_far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1_far.x, v1_far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
+            };
+
+            target.draw(quad, 4, sf::Quads);
          }
-         else if (shape_polygon)
+      }
+      else if (shape_polygon)
+      {
+         for (auto pos_current = 0; pos_current < shape_polygon->GetVertexCount(); pos_current++)
          {
-            for (auto pos_current = 0; pos_current < shape_polygon->GetVertexCount(); pos_current++)
+            auto pos_next = pos_current + 1;
+            if (pos_next == shape_polygon->GetVertexCount())
             {
-               auto pos_next = pos_current + 1;
-               if (pos_next == shape_polygon->GetVertexCount())
-               {
-                  pos_next = 0;
-               }
+               pos_next = 0;
+            }
 
-               auto v0 = shape_polygon->GetVertex(pos_current) + body->GetTransform().p;
+            auto v0 = shape_polygon->GetVertex(pos_current) + body->GetTransform().p;
 
-               // printf("%f\n", (lightPos - v0).LengthSquared());
+            // printf("%f\n", (lightPos - v0).LengthSquared());
 
-               if ((light_pos_m - v0).LengthSquared() > max_distance_m2)
-                  continue;
+            if ((light_pos_m - v0).LengthSquared() > max_distance_m2)
+               continue;
 
-               auto v1 = shape_polygon->GetVertex(pos_next) + body->GetTransform().p;
-               auto v0far = 10000.0f * (v0 - light_pos_m);
-               auto v1far = 10000.0f * (v1 - light_pos_m);
+            auto v1 = shape_polygon->GetVertex(pos_next) + body->GetTransform().p;
+            auto v0far = 10000.0f * (v0 - light_pos_m);
+            auto v1far = 10000.0f * (v1 - light_pos_m);
 
-               sf::Vertex quad[] =
-               {
-                  sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
-                  sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
-               };
+            sf::Vertex quad[] =
+            {
+               sf::Vertex(sf::Vector2f(v0.x, v0.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v0far.x, v0far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1far.x, v1far.y) * PPM, sf::Color::Black),
+               sf::Vertex(sf::Vector2f(v1.x, v1.y) * PPM, sf::Color::Black)
+            };
 
-               target.draw(quad, 4, sf::Quads);
-            }
+            target.draw(quad, 4, sf::Quads);
          }
       }
    }
@@ -312,6 +326,7 @@ void LightSystem::updateLightShader(sf::RenderTarget& target)
 void LightSystem::draw(sf::RenderTarget& target, sf::RenderStates /*states*/) const
 {
    _active_lights.clear();
+   _active_light_bounds.clear();
 
    auto player_body = Player::getCurrent()->getBody();
 
@@ -326,6 +341,15 @@ void LightSystem::draw(sf::RenderTarget& target, sf::RenderStates /*states*/) co
       }
 
       _active_lights.push_back(light);
+      _active_light_bounds.push_back(computeShadowBounds(light->_pos_m + light->_center_offset_m));
+   }
+
+   // all active lights are close to the player, so their occluders are gathered in a single walk over the broadphase
+   WorldQuery::queryFixtures(Level::getCurrentLevel()->getWorld(), _active_light_bounds, _active_light_fixtures);
+
+   for (auto light_index = 0u; light_index < _active_lights.size(); light_index++)
+   {
+      const auto& light = _active_lights[light_index];
 
       // fill stencil buffer
       glClear(GL_STENCIL_BUFFER_BIT);
@@ -334,7 +358,7 @@ void LightSystem::draw(sf::RenderTarget& target, sf::RenderStates /*states*/) co
       glStencilFunc(GL_ALWAYS, 1, 1);
       glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
 
-      drawShadowQuads(target, light);
+      drawShadowQuads(target, light, _active_light_fixtures[light_index]);
 
       // draw light quads with stencil boundaries
       glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -363,6 +387,13 @@ void LightSystem::draw(
    _light_shader.setUniform("color_map", color_map->getTexture());
    _light_shader.setUniform("light_map", light_map->getTexture());
    _light_shader.setUniform("normal_map", normal_map->getTexture());
+   _light_shader.setUniform(
+      "u_light_map_size",
+      sf::Glsl::Vec2(
+         static_cast<float>(light_map->getSize().x),
+         static_cast<float>(light_map->getSize().y)
+      )
+   );
 
    // update shader uniforms
    updateLightShader(target);
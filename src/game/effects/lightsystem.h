@@ -66,10 +66,12 @@ public:
 
 private:
 
-   void drawShadowQuads(sf::RenderTarget &target, std::shared_ptr<LightInstance> light) const;
+   void drawShadowQuads(sf::RenderTarget &target, std::shared_ptr<LightInstance> light, std::vector<b2Fixture*>& fixtures) const;
    void updateLightShader(sf::RenderTarget& target);
 
    mutable std::vector<std::shared_ptr<LightInstance>> _active_lights;
+   mutable std::vector<b2AABB> _active_light_bounds;
+   mutable std::vector<std::vector<b2Fixture*>> _active_light_fixtures;
 
    std::array<float, 4> _ambient_color = {1.0f, 1.0f, 1.0f, 1.0f};
    static constexpr auto segments = 20;
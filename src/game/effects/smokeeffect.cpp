@@ -11,6 +11,7 @@
 #include <array>
 #include <filesystem>
 #include <iostream>
+#include <map>
 #include <math.h>
 
 
@@ -24,33 +25,59 @@ SmokeEffect::SmokeEffect(GameNode* parent)
 }
 
 
-void SmokeEffect::drawToZ(sf::RenderTarget &target, sf::RenderStates states, int z)
+std::shared_ptr<sf::RenderTexture> SmokeEffect::getRenderTexture(const sf::Vector2u& size)
 {
-   if (z != _z)
+   // smoke effects are composited one after another, so all effects of the same size share one render texture
+   static std::map<std::pair<uint32_t, uint32_t>, std::weak_ptr<sf::RenderTexture>> __pool;
+
+   const auto key = std::make_pair(size.x, size.y);
+   auto render_texture = __pool[key].lock();
+
+   if (!render_texture)
    {
-       return;
+      render_texture = std::make_shared<sf::RenderTexture>();
+      if (!render_texture->create(size.x, size.y))
+      {
+         return nullptr;
+      }
+
+      render_texture->setSmooth(false);
+      __pool[key] = render_texture;
    }
 
-   sf::RenderTexture render_texture;
+   return render_texture;
+}
+
 
-   if (!render_texture.create(
-         static_cast<int32_t>(_size_px.x / _pixel_ratio),
-         static_cast<int32_t>(_size_px.y / _pixel_ratio)
-      )
-   )
+void SmokeEffect::drawToZ(sf::RenderTarget &target, sf::RenderStates states, int z)
+{
+   if (z != _z)
    {
-      return;
+       return;
    }
 
-   for (auto& particle : _particles)
+   if (!_render_texture)
    {
-      render_texture.draw(particle._sprite, _blend_mode);
+      _render_texture = getRenderTexture({
+            static_cast<uint32_t>(_size_px.x / _pixel_ratio),
+            static_cast<uint32_t>(_size_px.y / _pixel_ratio)
+         }
+      );
+
+      if (!_render_texture)
+      {
+         return;
+      }
    }
 
-   render_texture.setSmooth(false);
-   render_texture.display();
+   // all particles are drawn in a single batch
+   _render_texture->clear(sf::Color::Transparent);
+   sf::RenderStates particle_states(_blend_mode);
+   particle_states.texture = _texture.get();
+   _render_texture->draw(_vertices, particle_states);
+   _render_texture->display();
 
-   sf::Sprite rt_sprite(render_texture.getTexture());
+   sf::Sprite rt_sprite(_render_texture->getTexture());
    rt_sprite.setPosition(_offset_px);
    rt_sprite.scale(_pixel_ratio, _pixel_ratio);
    rt_sprite.setColor(_layer_color);
@@ -64,10 +91,20 @@ void SmokeEffect::update(const sf::Time& time)
    const auto dt = (time.asSeconds() - _last_update_time.asSeconds()) * _velocity;
    _last_update_time = time;
 
-   for (auto& particle : _particles)
+   const auto texture_size = sf::Vector2f{_texture->getSize()};
+   const std::array<sf::Vector2f, 4> corners{
+      sf::Vector2f{0.0f, 0.0f},
+      sf::Vector2f{texture_size.x, 0.0f},
+      sf::Vector2f{texture_size.x, texture_size.y},
+      sf::Vector2f{0.0f, texture_size.y}
+   };
+
+   _vertices.resize(_particles.size() * 4);
+
+   for (auto particle_index = 0u; particle_index < _particles.size(); particle_index++)
    {
+      auto& particle = _particles[particle_index];
       particle._rot += dt * 10.0f * particle._rot_dir;
-      particle._sprite.setRotation(particle._rot);
 
       // fake z rotation
       const auto x_normalized = 0.5f * (1.0f + sin(particle._time_offset + time.asSeconds() * _velocity));
@@ -75,26 +112,39 @@ void SmokeEffect::update(const sf::Time& time)
       const auto x = x_normalized * particle._offset.x;
       const auto y = y_normalized * particle._offset.y;
 
-      particle._sprite.setPosition(
-         particle._center.x + x,
-         particle._center.y + y
-      );
+      const auto position = sf::Vector2f{particle._center.x + x, particle._center.y + y};
 
+      auto color = _particle_color;
       if (_mode == Mode::Fog)
       {
-         particle._sprite.setColor({
-               _particle_color.r,
-               _particle_color.g,
-               _particle_color.b,
-               static_cast<uint8_t>(_particle_color.a * fabs(x_normalized))
-            }
-         );
+         color.a = static_cast<uint8_t>(_particle_color.a * fabs(x_normalized));
       }
 
-      // moved here from deserialize code
-      // origin should always depend on rotation
-      const auto bounds = particle._sprite.getGlobalBounds();
-      particle._sprite.setOrigin(bounds.width / 2, bounds.height / 2);
+      // the origin is half the size of the rotated particle's bounding box, that's what the
+      // sprite-based implementation derived from getGlobalBounds; it makes the particles wobble
+      const auto angle = particle._rot * static_cast<float>(M_PI) / 180.0f;
+      const auto cos_angle = cos(angle);
+      const auto sin_angle = sin(angle);
+      const auto width = texture_size.x * particle._scale.x;
+      const auto height = texture_size.y * particle._scale.y;
+      const auto origin = sf::Vector2f{
+         0.5f * (fabs(width * cos_angle) + fabs(height * sin_angle)),
+         0.5f * (fabs(width * sin_angle) + fabs(height * cos_angle))
+      };
+
+      for (auto corner_index = 0u; corner_index < corners.size(); corner_index++)
+      {
+         const auto& corner = corners[corner_index];
+         const auto local = sf::Vector2f{(corner.x - origin.x) * particle._scale.x, (corner.y - origin.y) * particle._scale.y};
+
+         auto& vertex = _vertices[particle_index * 4 + corner_index];
+         vertex.position = {
+            position.x + local.x * cos_angle - local.y * sin_angle,
+            position.y + local.x * sin_angle + local.y * cos_angle
+         };
+         vertex.texCoords = corner;
+         vertex.color = color;
+      }
    }
 }
 
@@ -239,10 +289,7 @@ std::shared_ptr<SmokeEffect> SmokeEffect::deserialize(GameNode* parent, const Ga
       particle._offset = sf::Vector2f{offset_x_px, offset_y_px};
       particle._time_offset = static_cast<float>(std::rand() % 100) * 0.02f * static_cast<float>(M_PI); // 0 .. 2_PI
 
-      particle._sprite.setScale(sprite_scale_x, sprite_scale_y);
-      particle._sprite.setRotation(static_cast<float>(std::rand() % 360));
-      particle._sprite.setTexture(*smoke_effect->_texture);
-      particle._sprite.setColor(smoke_effect->_particle_color);
+      particle._scale = sf::Vector2f{sprite_scale_x, sprite_scale_y};
 
       smoke_effect->_particles.push_back(particle);
    }
@@ -31,20 +31,24 @@ public:
 
 private:
 
+   static std::shared_ptr<sf::RenderTexture> getRenderTexture(const sf::Vector2u& size);
+
    std::shared_ptr<sf::Texture> _texture;
+   std::shared_ptr<sf::RenderTexture> _render_texture;
 
    struct SmokeParticle
    {
-      sf::Sprite _sprite;
       float _rot = 0.0f;
       float _rot_dir = 1.0f;
       float _time_offset = 0.0f;
 
+      sf::Vector2f _scale;
       sf::Vector2f _offset;
       sf::Vector2f _center;
    };
 
    std::vector<SmokeParticle> _particles;
+   sf::VertexArray _vertices{sf::Quads};
    int32_t _z = 20;
    sf::Time _last_update_time;
 
@@ -1,26 +1,18 @@
 #include "eventserializer.h"
 
+#include "fixedtimestep.h"
 #include "framework/tools/log.h"
 #include "gamestate.h"
 
 #include <iostream>
 #include <ostream>
 #include <fstream>
-#include <thread>
 
 
 namespace
 {
-using HighResDuration = std::chrono::high_resolution_clock::duration;
-using HighResTimePoint = std::chrono::high_resolution_clock::time_point;
-using HighResClockRep = std::chrono::high_resolution_clock::rep;
-using HighResClock = std::chrono::high_resolution_clock;
-}
-
-template<typename R>
-static bool is_ready(std::future<R> const& f)
-{
-   return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+// bump when the binary layout of events.dat changes
+constexpr int32_t file_format_version = 2;
 }
 
 void writeInt32(std::ostream& stream, int32_t value)
@@ -51,38 +43,6 @@ uint8_t readUint8(std::istream& stream)
 }
 
 
-void writeTimePoint(std::ostream& stream, const HighResTimePoint& time_point)
-{
-   using namespace std::chrono_literals;
-   auto const time_point_raw = (time_point + 12h).time_since_epoch().count();
-   stream.write(reinterpret_cast<char const*>(&time_point_raw), sizeof time_point_raw);
-}
-
-
-void writeDuration(std::ostream& stream, const HighResDuration& duration)
-{
-   auto const duration_raw = duration.count();
-   stream.write(reinterpret_cast<char const*>(&duration_raw), sizeof duration_raw);
-}
-
-
-HighResTimePoint readTimePoint(std::istream& stream)
-{
-   HighResClockRep file_time_rep;
-   stream.read(reinterpret_cast<char*>(&file_time_rep), sizeof(file_time_rep));
-   HighResTimePoint time_point{HighResDuration{file_time_rep}};
-   return time_point;
-}
-
-
-HighResDuration readDuration(std::istream& stream)
-{
-   HighResClockRep file_time_rep;
-   stream.read(reinterpret_cast<char*>(&file_time_rep), sizeof(file_time_rep));
-   auto duration = HighResDuration{file_time_rep};
-   return duration;
-}
-
 void EventSerializer::add(const sf::Event& event)
 {
    if (!isEnabled())
@@ -90,7 +50,7 @@ void EventSerializer::add(const sf::Event& event)
       return;
    }
 
-   if (_play_result.has_value() && !is_ready(_play_result.value()))
+   if (_playing)
    {
       return;
    }
@@ -110,8 +70,7 @@ void EventSerializer::add(const sf::Event& event)
       return;
    }
 
-   const auto now = HighResClock::now();
-   _events.push_back({now, event});
+   _events.push_back({FixedTimeStep::getInstance().getTick(), event});
 }
 
 
@@ -183,7 +142,7 @@ sf::Event readEvent(std::istream& stream)
 }
 
 
-void EventSerializer::serialize()
+void EventSerializer::serialize(const std::string& filename)
 {
    if (_events.empty())
    {
@@ -191,48 +150,58 @@ void EventSerializer::serialize()
    }
 
    Log::Info() << "serializing " << _events.size() << " events";
-   std::ofstream out("events.dat", std::ios::out | std::ios::binary);
+   std::ofstream out(filename, std::ios::out | std::ios::binary);
 
+   writeInt32(out, file_format_version);
    writeInt32(out, static_cast<int32_t>(_events.size()));
 
-   auto start_time = _events.front()._time_point;
+   const auto start_tick = _events.front()._tick;
 
    for (auto& event : _events)
    {
-      writeDuration(out, event._time_point - start_time);
+      writeInt32(out, static_cast<int32_t>(event._tick - start_tick));
       writeEvent(out, event._event);
    }
 }
 
 
-void EventSerializer::deserialize()
+bool EventSerializer::deserialize(const std::string& filename)
 {
    _events.clear();
 
-   std::ifstream in("events.dat", std::ios::in | std::ios::binary);
+   std::ifstream in(filename, std::ios::in | std::ios::binary);
+   if (!in.good())
+   {
+      Log::Error() << "could not open " << filename;
+      return false;
+   }
+
+   const auto version = readInt32(in);
+   if (version != file_format_version)
+   {
+      Log::Error() << filename << " has unsupported version " << version;
+      return false;
+   }
 
-   int32_t size = readInt32(in);
+   const auto size = readInt32(in);
 
    for (auto i = 0; i < size; i++)
    {
-      const auto duration = readDuration(in);
+      const auto tick = static_cast<uint32_t>(readInt32(in));
       const auto event = readEvent(in);
 
-      _events.push_back({duration, event});
+      _events.push_back({tick, event});
    }
+
+   return true;
 }
 
 
 void EventSerializer::debug()
 {
-   const auto start = _events.at(0)._time_point;
-
    for (const auto& event : _events)
    {
-      const auto& time_point = event._time_point;
-      const auto dt = time_point - start;
-
-      Log::Info() << dt.count();
+      Log::Info() << "tick " << event._tick << ": " << static_cast<int32_t>(event._event.type);
    }
 }
 
@@ -240,45 +209,47 @@ void EventSerializer::debug()
 void EventSerializer::play()
 {
    // if still busy playing, don't allow calling another time
-   if (_play_result.has_value() && !is_ready(_play_result.value()))
-   {
-      return;
-   }
-
-   if (_events.empty())
+   if (_playing || _events.empty())
    {
       return;
    }
 
-   _play_start_time = HighResClock::now();
-   _play_result = std::async(std::launch::async, [this]{playThread();});
+   _playing = true;
+   _play_start_tick.reset();
+   _play_index = 0;
 }
 
 
-void EventSerializer::playThread()
+void EventSerializer::update(uint32_t tick)
 {
-   using namespace std::chrono_literals;
+   if (!_playing)
+   {
+      return;
+   }
 
-   auto done = false;
+   // playback starts with the first tick after play() has been called
+   if (!_play_start_tick.has_value())
+   {
+      _play_start_tick = tick;
+   }
 
-   int32_t recorded_index = 0;
+   const auto elapsed_ticks = tick - _play_start_tick.value();
+   const auto first_tick = _events.front()._tick;
 
-   while (!done)
+   while (_play_index < _events.size() && _events[_play_index]._tick - first_tick <= elapsed_ticks)
    {
-      const auto now = HighResClock::now();
-      const auto elapsed =  now - _play_start_time;
+      // pass event to given event loop
+      _callback(_events[_play_index]._event);
+      _play_index++;
+   }
 
-      if (elapsed > _events[recorded_index]._duration)
-      {
-         // pass event to given event loop
-         _callback(_events[recorded_index]._event);
+   _playing = (_play_index < _events.size());
+}
 
-         recorded_index++;
-         done = (recorded_index == static_cast<int32_t>(_events.size() - 1));
-      }
 
-      std::this_thread::sleep_for(1ms);
-   }
+bool EventSerializer::isPlaying() const
+{
+   return _playing;
 }
 
 
@@ -2,38 +2,31 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <chrono>
+#include <cstdint>
 #include <functional>
-#include <future>
 #include <optional>
-#include <thread>
+#include <string>
 #include <vector>
 
+/*! \brief Records and replays keyboard input indexed by simulation tick.
+ *
+ *  Events are stored together with the fixed time step tick they were processed in. During playback update() is
+ *  called at the beginning of each simulation tick and passes all events that belong to that tick to the callback.
+ *  Since the simulation runs with a fixed time step, a replay reproduces the recorded run exactly.
+ */
 class EventSerializer
 {
    public:
 
-      using HighResDuration = std::chrono::high_resolution_clock::duration;
-      using HighResTimePoint = std::chrono::high_resolution_clock::time_point;
-
-      struct ChronoEvent
+      struct TickEvent
       {
-         // for playback
-         ChronoEvent(const HighResDuration& duration, const sf::Event& event)
-          : _duration(duration),
-            _event(event)
-         {
-         }
-
-         // for recording
-         ChronoEvent(const HighResTimePoint& time_point, const sf::Event& event)
-          : _time_point(time_point),
+         TickEvent(uint32_t tick, const sf::Event& event)
+          : _tick(tick),
             _event(event)
          {
          }
 
-         HighResTimePoint _time_point;
-         HighResDuration _duration;
+         uint32_t _tick = 0;
          sf::Event _event;
       };
 
@@ -42,11 +35,13 @@ class EventSerializer
       void add(const sf::Event& event);
       void clear();
 
-      void serialize();
-      void deserialize();
+      void serialize(const std::string& filename = "events.dat");
+      bool deserialize(const std::string& filename = "events.dat");
 
       void debug();
       void play();
+      void update(uint32_t tick);
+      bool isPlaying() const;
 
       void setCallback(const EventCallback& callback);
 
@@ -64,13 +59,13 @@ class EventSerializer
 
       EventSerializer() = default;
 
-      void playThread();
       bool filterMovementEvents(const sf::Event& event);
 
       std::optional<size_t> _max_size;
-      std::vector<ChronoEvent> _events;
-      std::optional<std::future<void>> _play_result;
-      HighResTimePoint _play_start_time;
+      std::vector<TickEvent> _events;
+      bool _playing = false;
+      std::optional<uint32_t> _play_start_tick;
+      size_t _play_index = 0;
       bool _enabled = false;
 
       EventCallback _callback;
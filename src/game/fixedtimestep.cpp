@@ -0,0 +1,89 @@
+#include "fixedtimestep.h"
+
+#include "physics/physicsconfiguration.h"
+
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------
+FixedTimeStep& FixedTimeStep::getInstance()
+{
+   static FixedTimeStep __instance;
+   return __instance;
+}
+
+
+//-----------------------------------------------------------------------------
+void FixedTimeStep::accumulate(const sf::Time& dt)
+{
+   const auto& config = PhysicsConfiguration::getInstance();
+
+   _step = sf::seconds(config._time_step);
+   _step_count = 0;
+
+   // drop time that cannot be caught up with, otherwise a single long frame (level load, window drag)
+   // would make the simulation spiral into more and more steps per frame
+   const auto accumulator_max = _step * static_cast<float>(config._max_time_steps_per_frame);
+   _accumulator = std::min(_accumulator + dt, accumulator_max);
+}
+
+
+//-----------------------------------------------------------------------------
+bool FixedTimeStep::consumeStep()
+{
+   if (_step <= sf::Time::Zero || _accumulator < _step)
+   {
+      _alpha = (_step > sf::Time::Zero) ? (_accumulator / _step) : 1.0f;
+      return false;
+   }
+
+   _accumulator -= _step;
+   _step_count++;
+   _tick++;
+   return true;
+}
+
+
+//-----------------------------------------------------------------------------
+void FixedTimeStep::reset()
+{
+   _accumulator = sf::Time::Zero;
+   _step_count = 0;
+   _alpha = 1.0f;
+}
+
+
+//-----------------------------------------------------------------------------
+const sf::Time& FixedTimeStep::getStep() const
+{
+   return _step;
+}
+
+
+//-----------------------------------------------------------------------------
+float FixedTimeStep::getInterpolationAlpha() const
+{
+   return _alpha;
+}
+
+
+//-----------------------------------------------------------------------------
+int32_t FixedTimeStep::getStepCount() const
+{
+   return _step_count;
+}
+
+
+//-----------------------------------------------------------------------------
+uint32_t FixedTimeStep::getTick() const
+{
+   return _tick;
+}
+
+
+//-----------------------------------------------------------------------------
+sf::Vector2f FixedTimeStep::interpolate(const sf::Vector2f& previous, const sf::Vector2f& current)
+{
+   const auto alpha = getInstance()._alpha;
+   return previous + (current - previous) * alpha;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdint>
+
+/*! \brief Drives the game simulation with a fixed time step.
+ *
+ *  The frame time is collected in an accumulator which is then consumed in chunks of the configured physics time step.
+ *  That way Box2D and all game logic advance by the same amount of time, no matter how fast frames are rendered.
+ *  The remainder of the accumulator is exposed as an interpolation factor so renderers can blend between the
+ *  previous and the current simulation state.
+ *  Every consumed step increments a tick counter that never resets; it is used to index recorded input.
+ */
+class FixedTimeStep
+{
+public:
+
+   FixedTimeStep() = default;
+
+   static FixedTimeStep& getInstance();
+
+   void accumulate(const sf::Time& dt);
+   bool consumeStep();
+   void reset();
+
+   const sf::Time& getStep() const;
+   float getInterpolationAlpha() const;
+   int32_t getStepCount() const;
+   uint32_t getTick() const;
+
+   static sf::Vector2f interpolate(const sf::Vector2f& previous, const sf::Vector2f& current);
+
+
+private:
+
+   sf::Time _step;
+   sf::Time _accumulator;
+   int32_t _step_count = 0;
+   uint32_t _tick = 0;
+   float _alpha = 1.0f;
+};
@@ -22,28 +22,27 @@ void FixtureNode::setType(const ObjectType& type)
 }
 
 
-void FixtureNode::setFlag(const std::string& flag, bool value)
+void FixtureNode::setFlag(Flag flag, bool value)
 {
-   _flags[flag]=value;
+   _flags[static_cast<size_t>(flag)] = value;
 }
 
 
-bool FixtureNode::hasFlag(const std::string& flag)
+bool FixtureNode::hasFlag(Flag flag) const
 {
-   bool value = _flags[flag];
-   return value;
+   return _flags[static_cast<size_t>(flag)];
 }
 
 
-void FixtureNode::setProperty(const std::string& key, const Variant& value)
+void FixtureNode::setProperty(Property key, const Variant& value)
 {
-    _properties[key] = value;
+    _properties[static_cast<size_t>(key)] = value;
 }
 
 
-FixtureNode::Variant FixtureNode::getProperty(const std::string& key) const
+const FixtureNode::Variant& FixtureNode::getProperty(Property key) const
 {
-   return _properties.find(key)->second;
+   return _properties[static_cast<size_t>(key)];
 }
 
 
@@ -3,8 +3,9 @@
 #include "constants.h"
 #include "gamenode.h"
 
+#include <array>
+#include <bitset>
 #include <functional>
-#include <map>
 #include <memory>
 #include <string>
 #include <variant>
@@ -17,16 +18,29 @@ class FixtureNode : public GameNode
       using CollisionCallback = std::function<void(void)>;
       using Variant = std::variant<std::string, int32_t, double>;
 
+      enum class Flag
+      {
+         Foot,
+         Head,
+         Count
+      };
+
+      enum class Property
+      {
+         Damage,
+         Count
+      };
+
       FixtureNode(GameNode *parent);
 
       ObjectType getType() const;
       void setType(const ObjectType &type);
 
-      void setFlag(const std::string& flag, bool value);
-      bool hasFlag(const std::string& flag);
+      void setFlag(Flag flag, bool value);
+      bool hasFlag(Flag flag) const;
 
-      void setProperty(const std::string& key, const Variant& value);
-      Variant getProperty(const std::string& key) const;
+      void setProperty(Property key, const Variant& value);
+      const Variant& getProperty(Property key) const;
 
       virtual void collisionWithPlayer();
       void setCollisionCallback(const CollisionCallback& collisionCallback);
@@ -34,9 +48,9 @@ class FixtureNode : public GameNode
 
    protected:
 
+      // flags and properties are read from the contact listener, so they're stored in fixed slots rather than maps
       ObjectType _type = ObjectTypeInvalid;
-      std::map<std::string, bool> _flags;
-      std::map<std::string, Variant> _properties;
+      std::bitset<static_cast<size_t>(Flag::Count)> _flags;
+      std::array<Variant, static_cast<size_t>(Property::Count)> _properties;
       CollisionCallback _collision_callback;
 };
-
@@ -0,0 +1,482 @@
+#include "framecapture.h"
+
+#include "framework/tools/log.h"
+
+#include <SFML/OpenGL.hpp>
+#include <SFML/Window/Context.hpp>
+
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#define POPEN_WRITE_MODE "wb"
+#else
+#define POPEN_WRITE_MODE "w"
+#endif
+
+
+namespace
+{
+
+#ifdef _WIN32
+#define FRAME_CAPTURE_GL_API __stdcall
+#else
+#define FRAME_CAPTURE_GL_API
+#endif
+
+constexpr GLenum gl_pixel_pack_buffer = 0x88EB;
+constexpr GLenum gl_stream_read = 0x88E1;
+constexpr GLenum gl_read_only = 0x88B8;
+
+// pixel buffer objects are part of OpenGL 2.1, the entry points are resolved at runtime
+struct GlPixelBufferFunctions
+{
+   using GenBuffers = void (FRAME_CAPTURE_GL_API*)(GLsizei, GLuint*);
+   using BindBuffer = void (FRAME_CAPTURE_GL_API*)(GLenum, GLuint);
+   using BufferData = void (FRAME_CAPTURE_GL_API*)(GLenum, std::ptrdiff_t, const void*, GLenum);
+   using MapBuffer = void* (FRAME_CAPTURE_GL_API*)(GLenum, GLenum);
+   using UnmapBuffer = GLboolean (FRAME_CAPTURE_GL_API*)(GLenum);
+
+   GlPixelBufferFunctions()
+   {
+      _gen_buffers = reinterpret_cast<GenBuffers>(sf::Context::getFunction("glGenBuffers"));
+      _bind_buffer = reinterpret_cast<BindBuffer>(sf::Context::getFunction("glBindBuffer"));
+      _buffer_data = reinterpret_cast<BufferData>(sf::Context::getFunction("glBufferData"));
+      _map_buffer = reinterpret_cast<MapBuffer>(sf::Context::getFunction("glMapBuffer"));
+      _unmap_buffer = reinterpret_cast<UnmapBuffer>(sf::Context::getFunction("glUnmapBuffer"));
+   }
+
+   bool isAvailable() const
+   {
+      return _gen_buffers && _bind_buffer && _buffer_data && _map_buffer && _unmap_buffer;
+   }
+
+   GenBuffers _gen_buffers = nullptr;
+   BindBuffer _bind_buffer = nullptr;
+   BufferData _buffer_data = nullptr;
+   MapBuffer _map_buffer = nullptr;
+   UnmapBuffer _unmap_buffer = nullptr;
+};
+
+const GlPixelBufferFunctions& glPixelBufferFunctions()
+{
+   static GlPixelBufferFunctions __functions;
+   return __functions;
+}
+
+// screenshots may capture all debug buffers of a frame at once, so there are more readbacks than recording needs
+constexpr auto max_readback_count = 16;
+
+}
+
+
+//-----------------------------------------------------------------------------
+FrameCapture& FrameCapture::getInstance()
+{
+   static FrameCapture __instance;
+   return __instance;
+}
+
+
+//-----------------------------------------------------------------------------
+FrameCapture::FrameCapture()
+{
+   // pointers into the vector are handed around, so it must never re-allocate
+   _readbacks.reserve(max_readback_count);
+   _encoder_thread = std::thread([this](){encode();});
+}
+
+
+//-----------------------------------------------------------------------------
+FrameCapture::~FrameCapture()
+{
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopped = true;
+   }
+
+   _condition.notify_one();
+   _encoder_thread.join();
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::capture(sf::RenderTexture& texture, const std::string& filename)
+{
+   captureFrame(texture, filename, false, 1);
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::captureFrame(sf::RenderTexture& texture, const std::string& filename, bool video_frame, int32_t repeat_count)
+{
+   if (issueReadback(texture, filename, video_frame, repeat_count))
+   {
+      return;
+   }
+
+   // no pixel buffer objects available, read back synchronously
+   const auto image = texture.getTexture().copyToImage();
+
+   Frame frame;
+   frame._filename = filename;
+   frame._size = image.getSize();
+   frame._pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + frame._size.x * frame._size.y * 4);
+   frame._video_frame = video_frame;
+   frame._repeat_count = repeat_count;
+   enqueue(std::move(frame));
+}
+
+
+//-----------------------------------------------------------------------------
+bool FrameCapture::issueReadback(sf::RenderTexture& texture, const std::string& filename, bool video_frame, int32_t repeat_count)
+{
+   const auto& gl = glPixelBufferFunctions();
+   if (!gl.isAvailable())
+   {
+      return false;
+   }
+
+   Readback* readback = nullptr;
+   if (!_readbacks_free.empty())
+   {
+      readback = _readbacks_free.back();
+      _readbacks_free.pop_back();
+   }
+   else if (_readbacks.size() < max_readback_count)
+   {
+      _readbacks.push_back({});
+      readback = &_readbacks.back();
+      gl._gen_buffers(1, &readback->_buffer_id);
+   }
+   else
+   {
+      return false;
+   }
+
+   const auto size = texture.getSize();
+   const auto byte_count = static_cast<size_t>(size.x) * size.y * 4;
+
+   // glReadPixels reads from the render texture's framebuffer, with a pack buffer bound it only enqueues the copy
+   texture.setActive(true);
+   gl._bind_buffer(gl_pixel_pack_buffer, readback->_buffer_id);
+
+   if (readback->_capacity != byte_count)
+   {
+      gl._buffer_data(gl_pixel_pack_buffer, static_cast<std::ptrdiff_t>(byte_count), nullptr, gl_stream_read);
+      readback->_capacity = byte_count;
+   }
+
+   glReadPixels(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+   gl._bind_buffer(gl_pixel_pack_buffer, 0);
+
+   readback->_size = size;
+   readback->_filename = filename;
+   readback->_frame = _frame;
+   readback->_video_frame = video_frame;
+   readback->_repeat_count = repeat_count;
+   _readbacks_pending.push_back(readback);
+
+   return true;
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::update()
+{
+   _frame++;
+
+   if (_readbacks_pending.empty())
+   {
+      return;
+   }
+
+   const auto& gl = glPixelBufferFunctions();
+
+   // the copies are done by the time a couple of frames have been presented, mapping them doesn't wait for the gpu then
+   while (!_readbacks_pending.empty() && _readbacks_pending.front()->_frame + readback_latency_frames <= _frame)
+   {
+      auto readback = _readbacks_pending.front();
+      _readbacks_pending.pop_front();
+
+      gl._bind_buffer(gl_pixel_pack_buffer, readback->_buffer_id);
+      const auto data = static_cast<const uint8_t*>(gl._map_buffer(gl_pixel_pack_buffer, gl_read_only));
+
+      if (data)
+      {
+         Frame frame;
+         frame._filename = readback->_filename;
+         frame._size = readback->_size;
+         frame._pixels.assign(data, data + readback->_capacity);
+         frame._bottom_up = true;
+         frame._video_frame = readback->_video_frame;
+         frame._repeat_count = readback->_repeat_count;
+         enqueue(std::move(frame));
+
+         gl._unmap_buffer(gl_pixel_pack_buffer);
+      }
+
+      gl._bind_buffer(gl_pixel_pack_buffer, 0);
+      _readbacks_free.push_back(readback);
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::startRecording(Output output)
+{
+   _recording = true;
+   _output = output;
+   _dropped_frames = 0;
+   _video_frames_submitted = 0;
+   _recording_clock.restart();
+
+   // every recording gets its own video file
+   if (_output == Output::Ffmpeg)
+   {
+      const auto now = std::time(nullptr);
+      std::ostringstream name;
+      name << "recording_" << std::put_time(std::localtime(&now), "%Y-%m-%d_%H-%M-%S");
+      _video_name = name.str();
+   }
+
+   Log::Info() << "recording started";
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::stopRecording()
+{
+   if (!_recording)
+   {
+      return;
+   }
+
+   _recording = false;
+
+   if (_output == Output::Ffmpeg)
+   {
+      Frame frame;
+      frame._end_of_stream = true;
+      enqueue(std::move(frame));
+   }
+
+   if (_output == Output::Ffmpeg)
+   {
+      Log::Info() << "recording stopped, " << _dropped_frames << " frames dropped and replaced by repeating the next frame";
+   }
+   else
+   {
+      Log::Info() << "recording stopped, " << _dropped_frames << " frames dropped";
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+bool FrameCapture::isRecording() const
+{
+   return _recording;
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::record(sf::RenderTexture& texture)
+{
+   if (!_recording)
+   {
+      return;
+   }
+
+   // videos have a fixed frame rate, so the frames are submitted along the time passed since the recording started.
+   // if the game runs ahead, the frame is not needed; if frames were dropped, the next one fills the gap.
+   auto repeat_count = 1;
+   if (_output == Output::Ffmpeg)
+   {
+      const auto frames_due = static_cast<int64_t>(_recording_clock.getElapsedTime().asSeconds() * video_frame_rate) + 1;
+      if (frames_due <= _video_frames_submitted)
+      {
+         return;
+      }
+
+      repeat_count = static_cast<int32_t>(frames_due - _video_frames_submitted);
+   }
+
+   // back-pressure: skip the frame if the gpu copies or the encoder can't keep up
+   bool encoder_busy = false;
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      encoder_busy = _frames.size() >= encoder_queue_size;
+   }
+
+   if (encoder_busy || _readbacks_pending.size() >= readback_count)
+   {
+      _dropped_frames++;
+      return;
+   }
+
+   if (_output == Output::ImageFiles)
+   {
+      std::ostringstream num;
+      num << std::setfill('0') << std::setw(5) << _recording_counter++;
+      capture(texture, num.str() + ".bmp");
+      return;
+   }
+
+   captureFrame(texture, _video_name, true, repeat_count);
+   _video_frames_submitted += repeat_count;
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::enqueue(Frame&& frame)
+{
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _frames.push_back(std::move(frame));
+   }
+
+   _condition.notify_one();
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::encode()
+{
+   for (;;)
+   {
+      Frame frame;
+
+      {
+         std::unique_lock<std::mutex> lock(_mutex);
+         _condition.wait(lock, [this](){return _stopped || !_frames.empty();});
+
+         if (_frames.empty())
+         {
+            break;
+         }
+
+         frame = std::move(_frames.front());
+         _frames.pop_front();
+      }
+
+      if (frame._end_of_stream)
+      {
+         closeVideo();
+         continue;
+      }
+
+      // rows read from a framebuffer are stored bottom-up
+      if (frame._bottom_up)
+      {
+         const auto row_size = frame._size.x * 4;
+         std::vector<uint8_t> pixels(frame._pixels.size());
+         for (auto y = 0u; y < frame._size.y; y++)
+         {
+            std::memcpy(&pixels[y * row_size], &frame._pixels[(frame._size.y - 1 - y) * row_size], row_size);
+         }
+
+         frame._pixels.swap(pixels);
+      }
+
+      if (frame._video_frame)
+      {
+         writeVideoFrame(frame);
+      }
+      else
+      {
+         sf::Image image;
+         image.create(frame._size.x, frame._size.y, frame._pixels.data());
+         image.saveToFile(frame._filename);
+      }
+   }
+
+   closeVideo();
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::writeVideoFrame(const Frame& frame)
+{
+   // a new recording starts a new video
+   if (_video_pipe_name != frame._filename)
+   {
+      closeVideo();
+      _video_pipe_name = frame._filename;
+      _video_part = 0;
+   }
+
+   // a change in resolution continues the recording in the next file
+   if (_video_pipe && _video_size != frame._size)
+   {
+      closeVideo();
+      _video_part++;
+   }
+
+   // don't try to launch ffmpeg for every single frame
+   if (_video_failed)
+   {
+      return;
+   }
+
+   if (!_video_pipe)
+   {
+      std::ostringstream filename;
+      filename << _video_pipe_name;
+      if (_video_part > 0)
+      {
+         filename << "_" << _video_part;
+      }
+      filename << ".mp4";
+
+      std::ostringstream command;
+      command
+         << "ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgba"
+         << " -s " << frame._size.x << "x" << frame._size.y
+         << " -r " << video_frame_rate << " -i - -c:v libx264 -pix_fmt yuv420p " << filename.str();
+
+#ifndef _WIN32
+      // if ffmpeg goes away, writing to the pipe must fail instead of terminating the game
+      std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+      _video_pipe = popen(command.str().c_str(), POPEN_WRITE_MODE);
+      _video_size = frame._size;
+
+      if (!_video_pipe)
+      {
+         Log::Error() << "unable to start ffmpeg";
+         _video_failed = true;
+         return;
+      }
+   }
+
+   for (auto i = 0; i < frame._repeat_count; i++)
+   {
+      if (fwrite(frame._pixels.data(), 1, frame._pixels.size(), _video_pipe) != frame._pixels.size())
+      {
+         Log::Error() << "unable to write to ffmpeg, the rest of the recording is dropped";
+         pclose(_video_pipe);
+         _video_pipe = nullptr;
+         _video_failed = true;
+         return;
+      }
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+void FrameCapture::closeVideo()
+{
+   _video_failed = false;
+
+   if (_video_pipe)
+   {
+      pclose(_video_pipe);
+      _video_pipe = nullptr;
+   }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*! \brief Captures render textures to image files or to a video without stalling the renderer
+ *
+ *  The texture contents are copied into a ring of OpenGL pixel buffer objects and mapped a couple of frames later
+ *  when the copy is done, so the gpu is never waited for. The pixels are then handed to a single encoder thread that
+ *  writes image files or pipes raw frames into ffmpeg. Both the readback ring and the encoder queue are bounded;
+ *  when either is full, frames are dropped (and counted) rather than blocking the game loop or piling up memory.
+ *  Videos are written at a fixed frame rate, the next frame that makes it through is repeated for every frame
+ *  that was dropped so the video keeps the pace of the game. Each recording goes to its own file.
+ *
+ *  Drivers without pixel buffer objects fall back to a synchronous readback.
+ *
+ *  usage
+ *     FrameCapture::getInstance().capture(render_texture, "screenshot.png");
+ *     ...
+ *     FrameCapture::getInstance().update(); // once per frame
+ */
+class FrameCapture
+{
+public:
+
+   enum class Output
+   {
+      ImageFiles,
+      Ffmpeg
+   };
+
+   static FrameCapture& getInstance();
+   ~FrameCapture();
+
+   void capture(sf::RenderTexture& texture, const std::string& filename);
+   void update();
+
+   void startRecording(Output output);
+   void stopRecording();
+   bool isRecording() const;
+   void record(sf::RenderTexture& texture);
+
+
+private:
+
+   struct Frame
+   {
+      std::string _filename; // image file name, or the video name without extension for video frames
+      sf::Vector2u _size;
+      std::vector<uint8_t> _pixels;
+      bool _bottom_up = false;
+      bool _end_of_stream = false;
+      bool _video_frame = false;
+      int32_t _repeat_count = 1;
+   };
+
+   struct Readback
+   {
+      uint32_t _buffer_id = 0;
+      size_t _capacity = 0;
+      sf::Vector2u _size;
+      std::string _filename;
+      int64_t _frame = 0;
+      bool _video_frame = false;
+      int32_t _repeat_count = 1;
+   };
+
+   FrameCapture();
+
+   void captureFrame(sf::RenderTexture& texture, const std::string& filename, bool video_frame, int32_t repeat_count);
+   bool issueReadback(sf::RenderTexture& texture, const std::string& filename, bool video_frame, int32_t repeat_count);
+   void enqueue(Frame&& frame);
+   void encode();
+   void writeVideoFrame(const Frame& frame);
+   void closeVideo();
+
+   static constexpr auto readback_count = 4;
+   static constexpr auto readback_latency_frames = 2;
+   static constexpr auto encoder_queue_size = 8;
+   static constexpr auto video_frame_rate = 60;
+
+   std::vector<Readback> _readbacks;
+   std::deque<Readback*> _readbacks_pending;
+   std::vector<Readback*> _readbacks_free;
+   int64_t _frame = 0;
+
+   bool _recording = false;
+   Output _output = Output::ImageFiles;
+   int32_t _recording_counter = 0;
+   int32_t _dropped_frames = 0;
+   std::string _video_name;
+   sf::Clock _recording_clock;
+   int64_t _video_frames_submitted = 0;
+
+   // encoder thread
+   std::thread _encoder_thread;
+   std::mutex _mutex;
+   std::condition_variable _condition;
+   std::deque<Frame> _frames;
+   bool _stopped = false;
+   FILE* _video_pipe = nullptr;
+   bool _video_failed = false;
+   sf::Vector2u _video_size;
+   std::string _video_pipe_name;
+   int32_t _video_part = 0;
+};
@@ -5,12 +5,16 @@
 #include "camerapanorama.h"
 #include "debugdraw.h"
 #include "displaymode.h"
+#include "dynamicresolution.h"
 #include "eventserializer.h"
 #include "fadetransitioneffect.h"
+#include "fixedtimestep.h"
+#include "framecapture.h"
 #include "framework/joystick/gamecontroller.h"
 #include "framework/tools/callbackmap.h"
 #include "framework/tools/globalclock.h"
 #include "framework/tools/log.h"
+#include "framework/tools/profiler.h"
 #include "framework/tools/timer.h"
 #include "gameclock.h"
 #include "gameconfiguration.h"
@@ -38,8 +42,10 @@
 #include <SFML/OpenGL.hpp>
 
 #include <time.h>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -135,6 +141,9 @@ void Game::initializeWindow()
    _window->setKeyRepeatEnabled(false);
    _window->setMouseCursorVisible(!game_config._fullscreen);
 
+   // timer queries need the window's gl context
+   DynamicResolution::getInstance().setEnabled(game_config._dynamic_resolution_enabled);
+
    // reset render textures if needed
    if (_window_render_texture)
    {
@@ -225,6 +234,7 @@ void Game::showPauseMenu()
 //----------------------------------------------------------------------------------------------------------------------
 void Game::loadLevel()
 {
+   FixedTimeStep::getInstance().reset();
    _level_loading_finished = false;
    _level_loading_finished_previous = false;
 
@@ -244,7 +254,12 @@ void Game::loadLevel()
          _level = std::make_shared<Level>();
          _level->setDescriptionFilename(level_item._level_name);
          _level->initialize();
-         _level->initializeTextures();
+
+         // render targets and shaders are only needed when something is drawn
+         if (!_headless)
+         {
+            _level->initializeTextures();
+         }
 
          // put the player in there
          _player->setWorld(_level->getWorld());
@@ -378,6 +393,47 @@ void Game::initialize()
          Player::getCurrent()->getPlayerAnimationMutable().loadAnimations();
       }
    );
+
+   Console::getInstance().registerCallback(
+      "/trace", "write a chrome trace of the next 300 frames to profile_trace.json", [] { Profiler::getInstance().startTrace(300); }
+   );
+
+   Console::getInstance().registerCallback(
+      "/gputimers",
+      "toggle gpu timer queries in the profiler",
+      [] { Profiler::getInstance().setGpuTimingEnabled(!Profiler::getInstance().isGpuTimingEnabled()); }
+   );
+
+   Console::getInstance().registerCallback(
+      "/record",
+      "toggle recording the game to recording.mp4 through ffmpeg",
+      []
+      {
+         auto& frame_capture = FrameCapture::getInstance();
+         if (frame_capture.isRecording())
+         {
+            frame_capture.stopRecording();
+         }
+         else
+         {
+            frame_capture.startRecording(FrameCapture::Output::Ffmpeg);
+         }
+      }
+   );
+
+   Console::getInstance().registerCallback(
+      "/dynres",
+      "toggle dynamic resolution scaling of the level textures",
+      [this]
+      {
+         auto& dynamic_resolution = DynamicResolution::getInstance();
+         dynamic_resolution.setEnabled(!dynamic_resolution.isEnabled());
+         if (_level && _level_loading_finished)
+         {
+            _level->initializeTextures();
+         }
+      }
+   );
 }
 
 // frambuffers
@@ -402,7 +458,18 @@ void Game::draw()
 
    if (_level_loading_finished)
    {
+      Profiler::Scope profiler_scope("level draw");
+
+      // re-create the level textures if the gpu time asks for a different render scale
+      auto& dynamic_resolution = DynamicResolution::getInstance();
+      if (dynamic_resolution.update())
+      {
+         _level->initializeTextures();
+      }
+
+      dynamic_resolution.beginFrame();
       _level->draw(_window_render_texture, _screenshot);
+      dynamic_resolution.endFrame();
    }
 
    _screenshot = false;
@@ -472,21 +539,9 @@ void Game::draw()
    _window->popGLStates();
    _window->display();
 
-   if (_recording)
-   {
-      const auto image = window_texture_sprite.getTexture()->copyToImage();
-
-      std::thread record(
-         [this, image]()
-         {
-            std::ostringstream num;
-            num << std::setfill('0') << std::setw(5) << _recording_counter++;
-            image.saveToFile(num.str() + ".bmp");
-         }
-      );
-
-      record.detach();
-   }
+   auto& frame_capture = FrameCapture::getInstance();
+   frame_capture.record(*_window_render_texture.get());
+   frame_capture.update();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -662,7 +717,7 @@ void Game::update()
    const auto dt = _delta_clock.getElapsedTime();
    _delta_clock.restart();
 
-   Timer::update(Timer::Scope::UpdateAlways);
+   Timer::update(Timer::Scope::UpdateAlways, std::chrono::microseconds(dt.asMicroseconds()));
    Audio::getInstance().updateMusic();
 
    // update screen transitions here
@@ -689,24 +744,29 @@ void Game::update()
    }
    else if (GameState::getInstance().getMode() == ExecutionMode::Running)
    {
-      Timer::update(Timer::Scope::UpdateIngame);
-
       if (_level_loading_finished)
       {
-         AnimationPool::getInstance().updateAnimations(dt);
+         // the controller is polled once per frame so no button presses are lost in frames without a step;
+         // all steps of the frame see the same controller state
          updateGameController();
          updateGameControllerForGame();
 
-         _level->update(dt);
-         _player->update(dt);
+         // the simulation is advanced in fixed steps so physics and game logic are independent from the frame rate;
+         // whatever remains in the accumulator is used to interpolate the render state in draw()
+         auto& fixed_time_step = FixedTimeStep::getInstance();
+         fixed_time_step.accumulate(dt);
 
-         if (_draw_states._draw_test_scene)
+         while (fixed_time_step.consumeStep())
          {
-            _test_scene->update(dt);
-         }
+            updateFixedStep(fixed_time_step.getStep());
 
-         // this might trigger level-reloading, so this ought to be the last drawing call in the loop
-         updateGameState(dt);
+            // game state updates might have paused the game or triggered level-reloading
+            if (!_level_loading_finished || GameState::getInstance().getMode() != ExecutionMode::Running)
+            {
+               fixed_time_step.reset();
+               break;
+            }
+         }
       }
    }
 
@@ -714,11 +774,36 @@ void Game::update()
    DisplayMode::getInstance().sync();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void Game::updateFixedStep(const sf::Time& dt)
+{
+   EventSerializer::getInstance().update(FixedTimeStep::getInstance().getTick());
+   Timer::update(Timer::Scope::UpdateIngame, std::chrono::microseconds(dt.asMicroseconds()));
+
+   AnimationPool::getInstance().updateAnimations(dt);
+
+   _level->update(dt);
+
+   {
+      Profiler::Scope profiler_scope("player update");
+      _player->update(dt);
+   }
+
+   if (_draw_states._draw_test_scene)
+   {
+      _test_scene->update(dt);
+   }
+
+   // this might trigger level-reloading, so this ought to be the last drawing call in the loop
+   updateGameState(dt);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 int32_t Game::loop()
 {
    while (_window->isOpen())
    {
+      Profiler::getInstance().beginFrame();
       processEvents();
       update();
       draw();
@@ -727,6 +812,122 @@ int32_t Game::loop()
    return 0;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+int32_t Game::runHeadless(const HeadlessSettings& settings)
+{
+   // no window is created, no frames are drawn and no sound is played; the simulation is ticked
+   // as fast as possible with the fixed time step and fed by a recorded, tick-indexed input log
+   _headless = true;
+   Audio::getInstance().setEnabled(false);
+
+   _player = std::make_shared<Player>();
+   _player->initialize();
+
+   EventSerializer::getInstance().setCallback([this](const sf::Event& event) { processEvent(event); });
+   if (!EventSerializer::getInstance().deserialize(settings._event_filename))
+   {
+      Log::Warning() << "running headless simulation without input";
+   }
+
+   SaveState::getCurrent()._level_index = settings._level_index;
+   loadLevel();
+   _level_loading_thread.wait();
+
+   EventSerializer::getInstance().play();
+
+   struct SubsystemTiming
+   {
+      float _sum_ms = 0.0f;
+      float _max_ms = 0.0f;
+   };
+
+   // the subsystem timings are taken from the profiler scopes, every tick is treated as one profiler frame
+   std::map<std::string, SubsystemTiming> timings;
+   auto& profiler = Profiler::getInstance();
+   profiler.setEnabled(true);
+
+   const auto collect_timings = [&timings, &profiler]()
+   {
+      profiler.beginFrame();
+      for (const auto& [name, history] : profiler.getHistories())
+      {
+         auto& timing = timings[name];
+         timing._sum_ms += history._current_ms;
+         timing._max_ms = std::max(timing._max_ms, history._current_ms);
+      }
+   };
+
+   auto& fixed_time_step = FixedTimeStep::getInstance();
+   const auto step = sf::seconds(PhysicsConfiguration::getInstance()._time_step);
+
+   auto tick_count = 0;
+   for (; tick_count < settings._tick_count; tick_count++)
+   {
+      // respawning reloads the level, wait for it so the reload always happens at the same tick
+      if (!_level_loading_finished)
+      {
+         _level_loading_thread.wait();
+      }
+
+      fixed_time_step.accumulate(step);
+      fixed_time_step.consumeStep();
+
+      {
+         Profiler::Scope profiler_scope("tick");
+
+         // screen transitions drive the respawn, so they are ticked with the simulation rather than the wall clock
+         Timer::update(Timer::Scope::UpdateAlways, std::chrono::microseconds(step.asMicroseconds()));
+         ScreenTransitionHandler::getInstance().update(step);
+         updateFixedStep(step);
+      }
+
+      GameState::getInstance().sync();
+      DisplayMode::getInstance().sync();
+
+      collect_timings();
+   }
+
+   profiler.setEnabled(false);
+
+   // fnv-1a over the state of all bodies in the world
+   uint64_t hash = 14695981039346656037ull;
+   const auto hash_value = [&hash](float value)
+   {
+      uint32_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      for (auto i = 0; i < 4; i++)
+      {
+         hash ^= (bits >> (i * 8)) & 0xff;
+         hash *= 1099511628211ull;
+      }
+   };
+
+   for (auto body = _level->getWorld()->GetBodyList(); body; body = body->GetNext())
+   {
+      hash_value(body->GetPosition().x);
+      hash_value(body->GetPosition().y);
+      hash_value(body->GetAngle());
+      hash_value(body->GetLinearVelocity().x);
+      hash_value(body->GetLinearVelocity().y);
+   }
+
+   hash_value(_player->getPixelPositionFloat().x);
+   hash_value(_player->getPixelPositionFloat().y);
+
+   Log::Info() << "headless simulation finished after " << tick_count << " ticks";
+
+   for (const auto& [name, timing] : timings)
+   {
+      const auto average_us = static_cast<int32_t>(1000.0f * timing._sum_ms / std::max(tick_count, 1));
+      const auto max_us = static_cast<int32_t>(1000.0f * timing._max_ms);
+      Log::Info() << name << ": avg " << average_us << "us, max " << max_us << "us";
+   }
+
+   Log::Info() << "state hash: " << std::hex << hash;
+
+   return 0;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void Game::reset()
 {
@@ -950,6 +1151,7 @@ void Game::processKeyPressedEvents(const sf::Event& event)
       case sf::Keyboard::F4:
       {
          _draw_states._draw_debug_info = !_draw_states._draw_debug_info;
+         Profiler::getInstance().setEnabled(_draw_states._draw_debug_info);
          break;
       }
       case sf::Keyboard::F6:
@@ -990,7 +1192,15 @@ void Game::processKeyPressedEvents(const sf::Event& event)
       }
       case sf::Keyboard::M:
       {
-         _recording = !_recording;
+         auto& frame_capture = FrameCapture::getInstance();
+         if (frame_capture.isRecording())
+         {
+            frame_capture.stopRecording();
+         }
+         else
+         {
+            frame_capture.startRecording(FrameCapture::Output::ImageFiles);
+         }
          break;
       }
       case sf::Keyboard::N:
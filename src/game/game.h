@@ -28,11 +28,19 @@ class Game
 {
 public:
 
+   struct HeadlessSettings
+   {
+      int32_t _tick_count = 3600;
+      int32_t _level_index = 0;
+      std::string _event_filename = "events.dat";
+   };
+
    Game() = default;
    virtual ~Game();
 
    void initialize();
    int32_t loop();
+   int32_t runHeadless(const HeadlessSettings& settings);
    void processEvents();
    void draw();
 
@@ -62,6 +70,7 @@ private:
    void resetAfterDeath(const sf::Time& dt);
 
    void update();
+   void updateFixedStep(const sf::Time& dt);
    void updateGameState(const sf::Time& dt);
    void updateGameController();
    void updateGameControllerForGame();
@@ -109,9 +118,6 @@ private:
    DrawStates _draw_states;
    sf::Vector2u _render_texture_offset;
    int32_t _death_wait_time_ms = 0;
-
-   bool _recording = false;
-   int32_t _recording_counter = 0;
-   std::vector<sf::Image> _recording_images;
+   bool _headless = false;
 };
 
@@ -30,6 +30,9 @@ std::string GameConfiguration::serialize()
             {"fullscreen",          _fullscreen},
             {"brightness",          _brightness},
             {"vsync",               _vsync_enabled},
+            {"render_scale_max",    _render_scale_max},
+            {"dynamic_resolution",  _dynamic_resolution_enabled},
+            {"stencil_alpha_mask",  _stencil_alpha_mask_enabled},
 
             {"audio_volume_master", _audio_volume_master},
             {"audio_volume_sfx",    _audio_volume_sfx},
@@ -37,6 +40,7 @@ std::string GameConfiguration::serialize()
 
             {"text_speed",          _text_speed},
             {"pause_mode",          _pause_mode},
+            {"effect_resolution",   _effect_resolution},
          }
       }
    };
@@ -60,6 +64,27 @@ void GameConfiguration::deserialize(const std::string& data)
        _brightness          = config["GameConfiguration"]["brightness"].get<float>();
        _vsync_enabled       = config["GameConfiguration"]["vsync"].get<bool>();
 
+       // optional, older configurations don't have those
+       if (config["GameConfiguration"].count("render_scale_max") > 0)
+       {
+          _render_scale_max = config["GameConfiguration"]["render_scale_max"].get<int32_t>();
+       }
+
+       if (config["GameConfiguration"].count("dynamic_resolution") > 0)
+       {
+          _dynamic_resolution_enabled = config["GameConfiguration"]["dynamic_resolution"].get<bool>();
+       }
+
+       if (config["GameConfiguration"].count("stencil_alpha_mask") > 0)
+       {
+          _stencil_alpha_mask_enabled = config["GameConfiguration"]["stencil_alpha_mask"].get<bool>();
+       }
+
+       if (config["GameConfiguration"].count("effect_resolution") > 0)
+       {
+          _effect_resolution = static_cast<EffectResolution>(config["GameConfiguration"]["effect_resolution"].get<int32_t>());
+       }
+
        _view_scale_width    = static_cast<float>(_view_width) / static_cast<float>(_video_mode_width);
        _view_scale_height   = static_cast<float>(_view_height) / static_cast<float>(_video_mode_height);
 
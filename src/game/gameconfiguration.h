@@ -14,6 +14,9 @@ struct GameConfiguration
    float _view_scale_height = 1.0f;
    float _brightness = 0.5f;
    bool _vsync_enabled = false;
+   int32_t _render_scale_max = 0; // 0 means the render textures match the window resolution
+   bool _dynamic_resolution_enabled = false;
+   bool _stencil_alpha_mask_enabled = false; // mask stencil tile maps in a shader instead of the stencil buffer
 
    int32_t _audio_volume_master = 50;
    int32_t _audio_volume_sfx = 50;
@@ -25,8 +28,17 @@ struct GameConfiguration
       ManualPause = 1
    };
 
+   // resolution of low-frequency effects (light map, shadows, atmosphere) relative to the level textures
+   enum class EffectResolution
+   {
+      Full = 0,
+      Half = 1,
+      Quarter = 2
+   };
+
    int32_t _text_speed = 2;
    PauseMode _pause_mode = PauseMode::AutomaticPause;
+   EffectResolution _effect_resolution = EffectResolution::Full;
 
    void deserializeFromFile(const std::string& filename = "data/config/game.json");
    void serializeToFile(const std::string& filename = "data/config/game.json");
@@ -23,6 +23,38 @@
 //       so animation can be aligned to detonation angle.
 
 
+GameContactListener::GameContactListener()
+{
+   _begin_handlers[ObjectTypeBouncer] = &GameContactListener::processBouncerContactBegin;
+   _begin_handlers[ObjectTypeBubbleCube] = &GameContactListener::processBubbleCubeContactBegin;
+   _begin_handlers[ObjectTypeCollapsingPlatform] = &GameContactListener::processCollapsingPlatformContactBegin;
+   _begin_handlers[ObjectTypeCrusher] = &GameContactListener::processCrusherContactBegin;
+   _begin_handlers[ObjectTypeDeadly] = &GameContactListener::processDeadlyContactBegin;
+   _begin_handlers[ObjectTypeEnemy] = &GameContactListener::processEnemyContactBegin;
+   _begin_handlers[ObjectTypeMovingPlatform] = &GameContactListener::processMovingPlatformContactBegin;
+   _begin_handlers[ObjectTypePlayer] = &GameContactListener::processPlayerContactBegin;
+   _begin_handlers[ObjectTypePlayerFootSensor] = &GameContactListener::processPlayerFootSensorContactBegin;
+   _begin_handlers[ObjectTypePlayerHeadSensor] = &GameContactListener::processPlayerHeadSensorContactBegin;
+   _begin_handlers[ObjectTypePlayerLeftArmSensor] = &GameContactListener::processPlayerLeftArmSensorContactBegin;
+   _begin_handlers[ObjectTypePlayerRightArmSensor] = &GameContactListener::processPlayerRightArmSensorContactBegin;
+   _begin_handlers[ObjectTypeProjectile] = &GameContactListener::processProjectileContactBegin;
+
+   _end_handlers[ObjectTypeBubbleCube] = &GameContactListener::processBubbleCubeContactEnd;
+   _end_handlers[ObjectTypeCollapsingPlatform] = &GameContactListener::processCollapsingPlatformContactEnd;
+   _end_handlers[ObjectTypeCrusher] = &GameContactListener::processCrusherContactEnd;
+   _end_handlers[ObjectTypeDeadly] = &GameContactListener::processDeadlyContactEnd;
+   _end_handlers[ObjectTypeMovingPlatform] = &GameContactListener::processMovingPlatformContactEnd;
+   _end_handlers[ObjectTypePlayer] = &GameContactListener::processPlayerContactEnd;
+   _end_handlers[ObjectTypePlayerFootSensor] = &GameContactListener::processPlayerFootSensorContactEnd;
+   _end_handlers[ObjectTypePlayerHeadSensor] = &GameContactListener::processPlayerHeadSensorContactEnd;
+   _end_handlers[ObjectTypePlayerLeftArmSensor] = &GameContactListener::processPlayerLeftArmSensorContactEnd;
+   _end_handlers[ObjectTypePlayerRightArmSensor] = &GameContactListener::processPlayerRightArmSensorContactEnd;
+
+   _post_solve_handlers[ObjectTypePlayer] = &GameContactListener::processPostSolveImpulse;
+   _post_solve_handlers[ObjectTypeProjectile] = &GameContactListener::processPostSolveProjectile;
+}
+
+
 int32_t GameContactListener::getPlayerFootContactCount() const
 {
    return _count_foot_contacts;
@@ -55,9 +87,11 @@ bool GameContactListener::isEnemy(FixtureNode* obj) const
 }
 
 
-void GameContactListener::processProjectileContactBegin(FixtureNode* fixture_node_a, FixtureNode* fixture_node_b)
+void GameContactListener::processProjectileContactBegin(const ContactEvent& event)
 {
-   auto damage = std::get<int32_t>(fixture_node_a->getProperty("damage"));
+   auto fixture_node_a = event._node;
+   auto fixture_node_b = event._other_node;
+   auto damage = std::get<int32_t>(fixture_node_a->getProperty(FixtureNode::Property::Damage));
 
    if (isPlayer(fixture_node_b))
    {
@@ -72,7 +106,7 @@ void GameContactListener::processProjectileContactBegin(FixtureNode* fixture_nod
       }
    }
 
-   auto projectile = dynamic_cast<Projectile*>(fixture_node_a);
+   auto projectile = static_cast<Projectile*>(fixture_node_a);
 
    // if it's an arrow, let postsolve handle it. if the impulse is not
    // hard enough, the arrow should just fall on the ground
@@ -83,10 +117,10 @@ void GameContactListener::processProjectileContactBegin(FixtureNode* fixture_nod
 }
 
 
-void GameContactListener::processMovingPlatformContactBegin(b2Fixture* fixture, void* fixture_user_data)
+void GameContactListener::processMovingPlatformContactBegin(const ContactEvent& event)
 {
    // check if platform smashes the player
-   auto fixture_node = static_cast<FixtureNode*>(fixture_user_data);
+   auto fixture_node = event._other_node;
    if (fixture_node && fixture_node->getType() == ObjectType::ObjectTypePlayerHeadSensor)
    {
       if (Player::getCurrent()->isOnGround())
@@ -95,16 +129,16 @@ void GameContactListener::processMovingPlatformContactBegin(b2Fixture* fixture,
       }
    }
 
-   auto platform_body = fixture->GetBody();
+   auto platform_body = event._fixture->GetBody();
    Player::getCurrent()->setPlatformBody(platform_body);
 
    _count_moving_platform_contacts++;
 }
 
 
-void GameContactListener::processCrusherContactBegin(FixtureNode* fixture_node)
+void GameContactListener::processCrusherContactBegin(const ContactEvent& event)
 {
-   if (!isPlayer(fixture_node))
+   if (!isPlayer(event._other_node))
    {
       return;
    }
@@ -112,31 +146,31 @@ void GameContactListener::processCrusherContactBegin(FixtureNode* fixture_node)
    _count_deadly_contacts++;
 }
 
-void GameContactListener::processPlayerFootSensorContactBegin(FixtureNode* fixture_node, b2Fixture* fixture)
+void GameContactListener::processPlayerFootSensorContactBegin(const ContactEvent& event)
 {
-   if (fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
 
-   if (isEnemy(fixture_node))
+   if (isEnemy(event._other_node))
    {
       return;
    }
 
    // store ground body in player
-   if (fixture->GetType() == b2Shape::e_chain)
+   if (event._other_fixture->GetType() == b2Shape::e_chain)
    {
-      Player::getCurrent()->setGroundBody(fixture->GetBody());
+      Player::getCurrent()->setGroundBody(event._other_fixture->GetBody());
    }
 
    _count_foot_contacts++;
 }
 
 
-void GameContactListener::processPlayerHeadSensorContactBegin(b2Fixture* fixture)
+void GameContactListener::processPlayerHeadSensorContactBegin(const ContactEvent& event)
 {
-   if (fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
@@ -145,9 +179,9 @@ void GameContactListener::processPlayerHeadSensorContactBegin(b2Fixture* fixture
 }
 
 
-void GameContactListener::processPlayerLeftArmSensorContactBegin(b2Fixture* fixture)
+void GameContactListener::processPlayerLeftArmSensorContactBegin(const ContactEvent& event)
 {
-   if (fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
@@ -156,9 +190,9 @@ void GameContactListener::processPlayerLeftArmSensorContactBegin(b2Fixture* fixt
 }
 
 
-void GameContactListener::processPlayerRightArmSensorContactBegin(b2Fixture* fixture)
+void GameContactListener::processPlayerRightArmSensorContactBegin(const ContactEvent& event)
 {
-   if (fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
@@ -167,21 +201,15 @@ void GameContactListener::processPlayerRightArmSensorContactBegin(b2Fixture* fix
 }
 
 
-void GameContactListener::processOneWayWallContactBegin(b2Contact* contact, b2Fixture* fixture)
-{
-   OneWayWall::instance().beginContact(contact, fixture);
-}
-
-
-void GameContactListener::processPlayerContactBegin()
+void GameContactListener::processPlayerContactBegin(const ContactEvent& /*event*/)
 {
    _count_player_contacts++;
 }
 
 
-void GameContactListener::processDeadlyContactBegin(FixtureNode* fixture_node)
+void GameContactListener::processDeadlyContactBegin(const ContactEvent& event)
 {
-   if (!isPlayer(fixture_node))
+   if (!isPlayer(event._other_node))
    {
       return;
    }
@@ -190,180 +218,204 @@ void GameContactListener::processDeadlyContactBegin(FixtureNode* fixture_node)
 }
 
 
-void GameContactListener::processEnemyContactBegin(FixtureNode* fixture_node_a, FixtureNode* fixture_node_b)
+void GameContactListener::processEnemyContactBegin(const ContactEvent& event)
 {
-   if (!isPlayer(fixture_node_b))
+   if (!isPlayer(event._other_node))
    {
       return;
    }
 
-   const auto damage = std::get<int32_t>(fixture_node_a->getProperty("damage"));
-   fixture_node_a->collisionWithPlayer();
+   const auto damage = std::get<int32_t>(event._node->getProperty(FixtureNode::Property::Damage));
+   event._node->collisionWithPlayer();
    Player::getCurrent()->damage(damage);
 }
 
 
-void GameContactListener::processBouncerContactBegin(FixtureNode* fixture_node)
+void GameContactListener::processBouncerContactBegin(const ContactEvent& event)
 {
-   dynamic_cast<Bouncer*>(fixture_node)->activate();
+   dynamic_cast<Bouncer*>(event._node)->activate();
 }
 
 
-void GameContactListener::processBubbleCubeContactBegin(b2Contact* contact, FixtureNode* bubble, FixtureNode* other)
+void GameContactListener::processBubbleCubeContactBegin(const ContactEvent& event)
 {
-   dynamic_cast<BubbleCube*>(bubble)->beginContact(contact, other);
+   dynamic_cast<BubbleCube*>(event._node)->beginContact(event._other_node);
 }
 
 
-void GameContactListener::processCollapsingPlatformContactBegin(b2Contact* contact, FixtureNode* platform, FixtureNode* other)
+void GameContactListener::processCollapsingPlatformContactBegin(const ContactEvent& event)
 {
-   dynamic_cast<CollapsingPlatform*>(platform)->beginContact(contact, other);
+   dynamic_cast<CollapsingPlatform*>(event._node)->beginContact(event._other_node);
 }
 
 
-void GameContactListener::processBeginContact(
-   b2Contact* contact,
-   b2Fixture* contact_fixture_a,
-   b2Fixture* contact_fixture_b,
-   FixtureNode* fixture_node_a,
-   FixtureNode* fixture_node_b,
-   void* fixture_user_data_b
-)
+void GameContactListener::pushEvent(const ContactEvent& event, bool in_step)
 {
-   switch (fixture_node_a->getType())
+   if (in_step)
    {
-      case ObjectTypeCrusher:
-      {
-         processCrusherContactBegin(fixture_node_b);
-         break;
-      }
-      case ObjectTypePlayerFootSensor:
-      {
-         processPlayerFootSensorContactBegin(fixture_node_b, contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayerHeadSensor:
-      {
-         processPlayerHeadSensorContactBegin(contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayerLeftArmSensor:
-      {
-         processPlayerLeftArmSensorContactBegin(contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayerRightArmSensor:
-      {
-         processPlayerRightArmSensorContactBegin(contact_fixture_b);
-         break;
-      }
-      case ObjectTypeProjectile:
-      {
-         processProjectileContactBegin(fixture_node_a, fixture_node_b);
-         break;
-      }
-      case ObjectTypeSolidOneWay:
-      {
-         processOneWayWallContactBegin(contact, contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayer:
-      {
-         processPlayerContactBegin();
-         break;
-      }
-      case ObjectTypeDeadly:
+      _events.push_back(event);
+   }
+   else
+   {
+      // the contact ended before its begin event was processed, neither of them is dispatched then
+      if (event._type == ContactEvent::Type::End && cancelPendingBegin(event))
       {
-         processDeadlyContactBegin(fixture_node_b);
-         break;
+         return;
       }
-      case ObjectTypeMovingPlatform:
+
+      dispatch(event);
+   }
+}
+
+
+void GameContactListener::dispatch(const ContactEvent& event)
+{
+   const auto type = static_cast<size_t>(event._node->getType());
+
+   ContactHandler handler = nullptr;
+   switch (event._type)
+   {
+      case ContactEvent::Type::Begin:
       {
-         processMovingPlatformContactBegin(contact_fixture_a, fixture_user_data_b);
+         handler = _begin_handlers[type];
          break;
       }
-      case ObjectTypeBouncer:
+      case ContactEvent::Type::End:
       {
-         processBouncerContactBegin(fixture_node_a);
+         handler = _end_handlers[type];
          break;
       }
-      case ObjectTypeEnemy:
+      case ContactEvent::Type::PostSolve:
       {
-         processEnemyContactBegin(fixture_node_a, fixture_node_b);
+         handler = _post_solve_handlers[type];
          break;
       }
-      case ObjectTypeBubbleCube:
+   }
+
+   if (handler)
+   {
+      (this->*handler)(event);
+   }
+}
+
+
+void GameContactListener::processEvents()
+{
+   // handlers might destroy or deactivate bodies which reports further contacts, those are processed right away
+   // and may drop the events after _next_event
+   while (_next_event < _events.size())
+   {
+      const auto event = _events[_next_event++];
+      if (event._node)
       {
-         processBubbleCubeContactBegin(contact, fixture_node_a, fixture_node_b);
-         break;
+         dispatch(event);
       }
-      case ObjectTypeCollapsingPlatform:
+   }
+
+   _events.clear();
+   _next_event = 0;
+}
+
+
+b2DestructionListener& GameContactListener::getDestructionListener(b2DestructionListener* next)
+{
+   _destruction_listener._next = next;
+   return _destruction_listener;
+}
+
+
+void GameContactListener::DestructionListener::SayGoodbye(b2Joint* joint)
+{
+   if (_next)
+   {
+      _next->SayGoodbye(joint);
+   }
+}
+
+
+void GameContactListener::DestructionListener::SayGoodbye(b2Fixture* fixture)
+{
+   GameContactListener::getInstance().dropEvents(fixture);
+
+   if (_next)
+   {
+      _next->SayGoodbye(fixture);
+   }
+}
+
+
+void GameContactListener::dropEvents(b2Fixture* fixture)
+{
+   for (auto i = _next_event; i < _events.size(); i++)
+   {
+      auto& event = _events[i];
+      if (event._fixture == fixture || event._other_fixture == fixture)
       {
-         processCollapsingPlatformContactBegin(contact, fixture_node_a, fixture_node_b);
-         break;
+         event._node = nullptr;
       }
-      case ObjectTypeDoor:
-      case ObjectTypeConveyorBelt:
-      case ObjectTypeMoveableBox:
-      case ObjectTypeDeathBlock:
-      case ObjectTypeSolid:
-      case ObjectTypeInvalid:
+   }
+}
+
+
+bool GameContactListener::cancelPendingBegin(const ContactEvent& end_event)
+{
+   for (auto i = _next_event; i < _events.size(); i++)
+   {
+      auto& event = _events[i];
+      if (
+            event._node
+         && event._type == ContactEvent::Type::Begin
+         && event._fixture == end_event._fixture
+         && event._other_fixture == end_event._other_fixture
+      )
       {
-         break;
+         event._node = nullptr;
+         return true;
       }
    }
+
+   return false;
 }
 
 
 void GameContactListener::BeginContact(b2Contact* contact)
 {
-   auto fixture_user_data_a = contact->GetFixtureA()->GetUserData();
-   auto fixture_user_data_b = contact->GetFixtureB()->GetUserData();
    auto contact_fixture_a = contact->GetFixtureA();
    auto contact_fixture_b = contact->GetFixtureB();
+   auto fixture_node_a = static_cast<FixtureNode*>(contact_fixture_a->GetUserData());
+   auto fixture_node_b = static_cast<FixtureNode*>(contact_fixture_b->GetUserData());
 
-   FixtureNode* fixture_node_a = nullptr;
-   FixtureNode* fixture_node_b = nullptr;
-
-   if (fixture_user_data_a)
-   {
-      fixture_node_a = static_cast<FixtureNode*>(fixture_user_data_a);
-   }
+   const auto in_step = contact_fixture_a->GetBody()->GetWorld()->IsLocked();
 
-   if (fixture_user_data_b)
+   if (fixture_node_a)
    {
-      fixture_node_b = static_cast<FixtureNode*>(fixture_user_data_b);
-   }
-
-   if (fixture_user_data_a)
-   {
-      processBeginContact(
-         contact,
-         contact_fixture_a,
-         contact_fixture_b,
-         fixture_node_a,
-         fixture_node_b,
-         fixture_user_data_b
-      );
+      if (fixture_node_a->getType() == ObjectTypeSolidOneWay)
+      {
+         OneWayWall::instance().beginContact(contact, contact_fixture_b);
+      }
+      else
+      {
+         pushEvent({ContactEvent::Type::Begin, fixture_node_a, fixture_node_b, contact_fixture_a, contact_fixture_b}, in_step);
+      }
    }
 
-   if (fixture_user_data_b)
+   if (fixture_node_b)
    {
-      processBeginContact(
-         contact,
-         contact_fixture_b,
-         contact_fixture_a,
-         fixture_node_b,
-         fixture_node_a,
-         fixture_user_data_a
-      );
+      if (fixture_node_b->getType() == ObjectTypeSolidOneWay)
+      {
+         OneWayWall::instance().beginContact(contact, contact_fixture_a);
+      }
+      else
+      {
+         pushEvent({ContactEvent::Type::Begin, fixture_node_b, fixture_node_a, contact_fixture_b, contact_fixture_a}, in_step);
+      }
    }
 }
 
 
-void GameContactListener::processCrusherContactEnd(FixtureNode* fixture_node)
+void GameContactListener::processCrusherContactEnd(const ContactEvent& event)
 {
-   if (!isPlayer(fixture_node))
+   if (!isPlayer(event._other_node))
    {
       return;
    }
@@ -371,15 +423,15 @@ void GameContactListener::processCrusherContactEnd(FixtureNode* fixture_node)
    _count_deadly_contacts--;
 }
 
-void GameContactListener::processPlayerFootSensorContactEnd(FixtureNode* fixture_node, b2Fixture* fixture)
+void GameContactListener::processPlayerFootSensorContactEnd(const ContactEvent& event)
 {
-   if (fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
 
    // contact with enemies is not taken into regard for foot sensor because that'd enable him to jump off enemies
-   if (isEnemy(fixture_node))
+   if (isEnemy(event._other_node))
    {
       return;
    }
@@ -388,9 +440,9 @@ void GameContactListener::processPlayerFootSensorContactEnd(FixtureNode* fixture
 }
 
 
-void GameContactListener::processPlayerHeadSensorContactEnd(auto contact_fixture_b)
+void GameContactListener::processPlayerHeadSensorContactEnd(const ContactEvent& event)
 {
-   if (contact_fixture_b->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
@@ -398,9 +450,9 @@ void GameContactListener::processPlayerHeadSensorContactEnd(auto contact_fixture
    _count_head_contacts--;
 }
 
-void GameContactListener::processPlayerLeftArmSensorContactEnd(b2Fixture* contact_fixture)
+void GameContactListener::processPlayerLeftArmSensorContactEnd(const ContactEvent& event)
 {
-   if (contact_fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
@@ -409,9 +461,9 @@ void GameContactListener::processPlayerLeftArmSensorContactEnd(b2Fixture* contac
 }
 
 
-void GameContactListener::processPlayerRightArmSensorContactEnd(b2Fixture* contact_fixture)
+void GameContactListener::processPlayerRightArmSensorContactEnd(const ContactEvent& event)
 {
-   if (contact_fixture->IsSensor())
+   if (event._other_fixture->IsSensor())
    {
       return;
    }
@@ -420,21 +472,15 @@ void GameContactListener::processPlayerRightArmSensorContactEnd(b2Fixture* conta
 }
 
 
-void GameContactListener::processPlayerContactEnd()
+void GameContactListener::processPlayerContactEnd(const ContactEvent& /*event*/)
 {
    _count_player_contacts--;
 }
 
 
-void GameContactListener::processOneWayWallContactEnd(b2Contact* contact)
-{
-   OneWayWall::instance().endContact(contact);
-}
-
-
-void GameContactListener::processDeadlyContactEnd(FixtureNode* fixture_node)
+void GameContactListener::processDeadlyContactEnd(const ContactEvent& event)
 {
-   if (!isPlayer(fixture_node))
+   if (!isPlayer(event._other_node))
    {
       return;
    }
@@ -443,135 +489,55 @@ void GameContactListener::processDeadlyContactEnd(FixtureNode* fixture_node)
 }
 
 
-void GameContactListener::processMovingPlatformContactEnd()
+void GameContactListener::processMovingPlatformContactEnd(const ContactEvent& /*event*/)
 {
    _count_moving_platform_contacts--;
 }
 
 
-void GameContactListener::processBubbleCubeContactEnd(FixtureNode* fixture_node_bubble, FixtureNode* fixture_node_other)
+void GameContactListener::processBubbleCubeContactEnd(const ContactEvent& event)
 {
-   dynamic_cast<BubbleCube*>(fixture_node_bubble)->endContact(fixture_node_other);
+   dynamic_cast<BubbleCube*>(event._node)->endContact(event._other_node);
 }
 
 
-void GameContactListener::processCollapsingPlatformContactEnd(FixtureNode* fixture_node_platform, FixtureNode* fixture_node_other)
+void GameContactListener::processCollapsingPlatformContactEnd(const ContactEvent& event)
 {
-   dynamic_cast<CollapsingPlatform*>(fixture_node_platform)->endContact(fixture_node_other);
+   dynamic_cast<CollapsingPlatform*>(event._node)->endContact(event._other_node);
 }
 
 
-void GameContactListener::processEndContact(
-   b2Contact* contact,
-   FixtureNode* fixture_node_a,
-   FixtureNode* fixture_node_b,
-   b2Fixture* contact_fixture_b
-)
+void GameContactListener::EndContact(b2Contact* contact)
 {
-   switch (fixture_node_a->getType())
+   auto contact_fixture_a = contact->GetFixtureA();
+   auto contact_fixture_b = contact->GetFixtureB();
+   auto fixture_node_a = static_cast<FixtureNode*>(contact_fixture_a->GetUserData());
+   auto fixture_node_b = static_cast<FixtureNode*>(contact_fixture_b->GetUserData());
+
+   const auto in_step = contact_fixture_a->GetBody()->GetWorld()->IsLocked();
+
+   if (fixture_node_a)
    {
-      case ObjectTypeCrusher:
-      {
-         processCrusherContactEnd(fixture_node_b);
-         break;
-      }
-      case ObjectTypePlayerFootSensor:
-      {
-         processPlayerFootSensorContactEnd(fixture_node_b, contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayerHeadSensor:
-      {
-         processPlayerHeadSensorContactEnd(contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayerLeftArmSensor:
-      {
-         processPlayerLeftArmSensorContactEnd(contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayerRightArmSensor:
-      {
-         processPlayerRightArmSensorContactEnd(contact_fixture_b);
-         break;
-      }
-      case ObjectTypePlayer:
-      {
-         processPlayerContactEnd();
-         break;
-      }
-      case ObjectTypeSolidOneWay:
+      if (fixture_node_a->getType() == ObjectTypeSolidOneWay)
       {
-         processOneWayWallContactEnd(contact);
-         break;
-      }
-      case ObjectTypeDeadly:
-      {
-         processDeadlyContactEnd(fixture_node_b);
-         break;
+         OneWayWall::instance().endContact(contact);
       }
-      case ObjectTypeMovingPlatform:
+      else
       {
-         processMovingPlatformContactEnd();
-         break;
+         pushEvent({ContactEvent::Type::End, fixture_node_a, fixture_node_b, contact_fixture_a, contact_fixture_b}, in_step);
       }
-      case ObjectTypeBubbleCube:
+   }
+
+   if (fixture_node_b)
+   {
+      if (fixture_node_b->getType() == ObjectTypeSolidOneWay)
       {
-         processBubbleCubeContactEnd(fixture_node_a, fixture_node_b);
-         break;
+         OneWayWall::instance().endContact(contact);
       }
-      case ObjectTypeCollapsingPlatform:
+      else
       {
-         processCollapsingPlatformContactEnd(fixture_node_a, fixture_node_b);
-         break;
+         pushEvent({ContactEvent::Type::End, fixture_node_b, fixture_node_a, contact_fixture_b, contact_fixture_a}, in_step);
       }
-      default:
-      {
-         break;
-      }
-   }
-}
-
-
-void GameContactListener::EndContact(b2Contact* contact)
-{
-   auto fixture_user_data_a = contact->GetFixtureA()->GetUserData();
-   auto fixture_user_data_b = contact->GetFixtureB()->GetUserData();
-
-   FixtureNode* fixture_node_a = nullptr;
-   FixtureNode* fixture_node_b = nullptr;
-
-   if (fixture_user_data_a)
-   {
-      fixture_node_a = static_cast<FixtureNode*>(fixture_user_data_a);
-   }
-
-   if (fixture_user_data_b)
-   {
-      fixture_node_b = static_cast<FixtureNode*>(fixture_user_data_b);
-   }
-
-   auto contact_fixture_a = contact->GetFixtureA();
-   auto contact_fixture_b = contact->GetFixtureB();
-
-   if (fixture_user_data_a)
-   {
-      processEndContact(
-         contact,
-         fixture_node_a,
-         fixture_node_b,
-         contact_fixture_b
-      );
-   }
-
-   if (fixture_user_data_b)
-   {
-      processEndContact(
-         contact,
-         fixture_node_b,
-         fixture_node_a,
-         contact_fixture_a
-      );
    }
 }
 
@@ -582,19 +548,6 @@ void GameContactListener::PreSolve(b2Contact* contact, const b2Manifold* /*oldMa
 }
 
 
-void GameContactListener::processPostSolve(FixtureNode* node, float impulse)
-{
-   if (node->getType() == ObjectTypePlayer)
-   {
-      processPostSolveImpulse(impulse);
-   }
-   else if (node->getType() == ObjectTypeProjectile)
-   {
-      processPostSolveProjectile(node, impulse);
-   }
-}
-
-
 void GameContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* contact_impulse)
 {
    // normal impulse
@@ -628,21 +581,20 @@ void GameContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse*
 
    // check if the player hits something at a heigh speed or
    // if something hits the player at a nigh speed
-   auto user_data_a = contact->GetFixtureA()->GetUserData();
-   auto user_data_b = contact->GetFixtureB()->GetUserData();
+   auto node_a = static_cast<FixtureNode*>(contact->GetFixtureA()->GetUserData());
+   auto node_b = static_cast<FixtureNode*>(contact->GetFixtureB()->GetUserData());
 
    const auto impulse = contact_impulse->normalImpulses[0];
 
-   if (user_data_a)
+   // post solve is reported for every contact in every step, only record what's handled
+   if (node_a && _post_solve_handlers[node_a->getType()])
    {
-      auto node_a = static_cast<FixtureNode*>(user_data_a);
-      processPostSolve(node_a, impulse);
+      _events.push_back({ContactEvent::Type::PostSolve, node_a, node_b, contact->GetFixtureA(), contact->GetFixtureB(), impulse});
    }
 
-   if (user_data_b)
+   if (node_b && _post_solve_handlers[node_b->getType()])
    {
-      auto node_b = static_cast<FixtureNode*>(user_data_b);
-      processPostSolve(node_b, impulse);
+      _events.push_back({ContactEvent::Type::PostSolve, node_b, node_a, contact->GetFixtureB(), contact->GetFixtureA(), impulse});
    }
 }
 
@@ -659,21 +611,21 @@ void GameContactListener::debug()
 }
 
 
-void GameContactListener::processPostSolveImpulse(float impulse)
+void GameContactListener::processPostSolveImpulse(const ContactEvent& event)
 {
    // filter just ordinary ground contact
-   if (impulse < 0.03f)
+   if (event._impulse < 0.03f)
    {
       return;
    }
 
-   Player::getCurrent()->impulse(impulse);
+   Player::getCurrent()->impulse(event._impulse);
 }
 
 
-void GameContactListener::processPostSolveProjectile(FixtureNode* node, float impulse)
+void GameContactListener::processPostSolveProjectile(const ContactEvent& event)
 {
-   auto projectile = dynamic_cast<Projectile*>(node);
+   auto projectile = static_cast<Projectile*>(event._node);
 
    if (!projectile->isSticky())
    {
@@ -699,7 +651,7 @@ void GameContactListener::processPostSolveProjectile(FixtureNode* node, float im
 
    projectile->setScheduledForRemoval(true);
 
-   if (impulse > 0.0003f)
+   if (event._impulse > 0.0003f)
    {
       // Log::Info() << "arrow hit with " << impulse;
       projectile->setScheduledForInactivity(true);
@@ -741,6 +693,8 @@ void GameContactListener::reset()
    _count_deadly_contacts = 0;
    _count_moving_platform_contacts = 0;
    _smashed = false;
+   _events.clear();
+   _next_event = 0;
    OneWayWall::instance().clear();
 }
 
@@ -1,10 +1,25 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include "Box2D/Box2D.h"
 
+#include "constants.h"
+
 class FixtureNode;
 
+/*! \brief Collects the box2d contacts and keeps track of the player's contact state
+ *
+ *  Contacts reported during the world step are only recorded into a compact event queue; they are processed
+ *  in order by processEvents() once the step is done. Each event is dispatched through handler tables indexed
+ *  by the object type of the fixture it's reported for, so no gameplay logic runs inside the box2d solver.
+ *  Contacts that are reported outside of the step (when bodies are destroyed or deactivated) are processed
+ *  right away since their fixtures might not exist anymore later on. If that happens while the queue is
+ *  processed, the queued events of destroyed fixtures are dropped and an end event cancels the queued begin
+ *  event of the same contact, so the contact counters stay balanced.
+ *
+ *  One-way walls need to disable the contact itself, so they are still handled within the step.
+ */
 class GameContactListener : public b2ContactListener
 {
 public:
@@ -23,59 +38,93 @@ public:
    void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
 
+   void processEvents();
+
+   //! drops the queued events of destroyed fixtures, then passes them on to the next listener
+   b2DestructionListener& getDestructionListener(b2DestructionListener* next);
+
    void debug();
    void reset();
 
    static GameContactListener& getInstance();
 
-   void processPlayerHeadSensorContactEnd(auto contact_fixture_b);
-
 protected:
    bool isPlayer(FixtureNode* obj) const;
    bool isEnemy(FixtureNode* obj) const;
 
 private:
-   GameContactListener() = default;
-
-   void processBeginContact(
-      b2Contact* contact,
-      b2Fixture* contact_fixture_a,
-      b2Fixture* contact_fixture_b,
-      FixtureNode* fixture_node_a,
-      FixtureNode* fixture_node_b,
-      void* fixture_user_data_b
-   );
-
-   void processEndContact(b2Contact* contact, FixtureNode* fixture_node_a, FixtureNode* fixture_node_b, b2Fixture* contact_fixture_b);
-   void processPostSolve(FixtureNode* node, float impulse);
-   void processBouncerContactBegin(FixtureNode* fixture_node);
-   void processBubbleCubeContactBegin(b2Contact* contact, FixtureNode* bubble, FixtureNode* other);
-   void processCollapsingPlatformContactBegin(b2Contact* contact, FixtureNode* fixture_node, FixtureNode* other);
-   void processCrusherContactBegin(FixtureNode* fixture_node);
-   void processDeadlyContactBegin(FixtureNode* fixture_node);
-   void processEnemyContactBegin(FixtureNode* fixture_node_a, FixtureNode* fixture_node_b);
-   void processMovingPlatformContactBegin(b2Fixture* fixture, void* fixture_user_data);
-   void processOneWayWallContactBegin(b2Contact* contact, b2Fixture* fixture);
-   void processPlayerContactBegin();
-   void processPlayerFootSensorContactBegin(FixtureNode* fixture_node, b2Fixture* fixture);
-   void processPlayerHeadSensorContactBegin(b2Fixture* fixture);
-   void processPlayerLeftArmSensorContactBegin(b2Fixture* fixture);
-   void processPlayerRightArmSensorContactBegin(b2Fixture* fixture);
-   void processProjectileContactBegin(FixtureNode* fixture_node_a, FixtureNode* fixture_node_b);
-
-   void processBubbleCubeContactEnd(FixtureNode* bubble, FixtureNode* other);
-   void processCollapsingPlatformContactEnd(FixtureNode* fixture_node_platform, FixtureNode* fixture_node_other);
-   void processCrusherContactEnd(FixtureNode* fixture_node);
-   void processDeadlyContactEnd(FixtureNode* fixture_node);
-   void processMovingPlatformContactEnd();
-   void processOneWayWallContactEnd(b2Contact* contact);
-   void processPlayerContactEnd();
-   void processPlayerFootSensorContactEnd(FixtureNode* fixture_node, b2Fixture* fixture);
-   void processPlayerLeftArmSensorContactEnd(b2Fixture* contact_fixture);
-   void processPlayerRightArmSensorContactEnd(b2Fixture* contact_fixture);
-
-   void processPostSolveImpulse(float impulse);
-   void processPostSolveProjectile(FixtureNode* node, float impulse);
+
+   struct ContactEvent
+   {
+      enum class Type : uint8_t
+      {
+         Begin,
+         End,
+         PostSolve
+      };
+
+      Type _type = Type::Begin;
+      FixtureNode* _node = nullptr;       //!< the node the event is dispatched for
+      FixtureNode* _other_node = nullptr;
+      b2Fixture* _fixture = nullptr;
+      b2Fixture* _other_fixture = nullptr;
+      float _impulse = 0.0f;
+   };
+
+   class DestructionListener : public b2DestructionListener
+   {
+      public:
+
+         void SayGoodbye(b2Joint* joint) override;
+         void SayGoodbye(b2Fixture* fixture) override;
+
+         b2DestructionListener* _next = nullptr;
+   };
+
+   using ContactHandler = void (GameContactListener::*)(const ContactEvent&);
+   using ContactHandlerTable = std::array<ContactHandler, static_cast<size_t>(ObjectTypeCollapsingPlatform) + 1>;
+
+   GameContactListener();
+
+   void pushEvent(const ContactEvent& event, bool in_step);
+   void dispatch(const ContactEvent& event);
+   void dropEvents(b2Fixture* fixture);
+   bool cancelPendingBegin(const ContactEvent& end_event);
+
+   void processBouncerContactBegin(const ContactEvent& event);
+   void processBubbleCubeContactBegin(const ContactEvent& event);
+   void processCollapsingPlatformContactBegin(const ContactEvent& event);
+   void processCrusherContactBegin(const ContactEvent& event);
+   void processDeadlyContactBegin(const ContactEvent& event);
+   void processEnemyContactBegin(const ContactEvent& event);
+   void processMovingPlatformContactBegin(const ContactEvent& event);
+   void processPlayerContactBegin(const ContactEvent& event);
+   void processPlayerFootSensorContactBegin(const ContactEvent& event);
+   void processPlayerHeadSensorContactBegin(const ContactEvent& event);
+   void processPlayerLeftArmSensorContactBegin(const ContactEvent& event);
+   void processPlayerRightArmSensorContactBegin(const ContactEvent& event);
+   void processProjectileContactBegin(const ContactEvent& event);
+
+   void processBubbleCubeContactEnd(const ContactEvent& event);
+   void processCollapsingPlatformContactEnd(const ContactEvent& event);
+   void processCrusherContactEnd(const ContactEvent& event);
+   void processDeadlyContactEnd(const ContactEvent& event);
+   void processMovingPlatformContactEnd(const ContactEvent& event);
+   void processPlayerContactEnd(const ContactEvent& event);
+   void processPlayerFootSensorContactEnd(const ContactEvent& event);
+   void processPlayerHeadSensorContactEnd(const ContactEvent& event);
+   void processPlayerLeftArmSensorContactEnd(const ContactEvent& event);
+   void processPlayerRightArmSensorContactEnd(const ContactEvent& event);
+
+   void processPostSolveImpulse(const ContactEvent& event);
+   void processPostSolveProjectile(const ContactEvent& event);
+
+   ContactHandlerTable _begin_handlers = {};
+   ContactHandlerTable _end_handlers = {};
+   ContactHandlerTable _post_solve_handlers = {};
+   std::vector<ContactEvent> _events;
+   size_t _next_event = 0;
+   DestructionListener _destruction_listener;
 
    int32_t _count_foot_contacts = 0;
    int32_t _count_head_contacts = 0;
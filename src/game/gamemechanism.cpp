@@ -39,3 +39,19 @@ void GameMechanism::setEnabled(bool enabled)
 {
    _enabled = enabled;
 }
+
+
+std::optional<sf::FloatRect> GameMechanism::getBoundingBoxPx()
+{
+   return std::nullopt;
+}
+
+
+void GameMechanism::setDormant(bool /*dormant*/)
+{
+}
+
+
+void GameMechanism::fastForward(const sf::Time& /*dormant_time*/, const sf::Time& /*dt*/)
+{
+}
@@ -6,6 +6,7 @@
 #include "SFML/Graphics.hpp"
 
 #include <cstdint>
+#include <optional>
 
 
 class GameMechanism
@@ -24,6 +25,13 @@ class GameMechanism
       virtual int32_t getZ() const;
       virtual void setZ(const int32_t& z);
 
+      //! mechanisms that return a bounding box are put to sleep when they're far away from the player
+      virtual std::optional<sf::FloatRect> getBoundingBoxPx();
+      virtual void setDormant(bool dormant);
+
+      //! called right before a dormant mechanism wakes up; must not have any side effects outside the mechanism
+      virtual void fastForward(const sf::Time& dormant_time, const sf::Time& dt);
+
       virtual void serializeState(nlohmann::json&){}
       virtual void deserializeState(const nlohmann::json&){}
       virtual bool isSerialized() const;
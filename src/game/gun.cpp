@@ -14,6 +14,8 @@ namespace
 uint16_t category_bits = CategoryEnemyCollideWith;                 // I am a ...
 uint16_t mask_bits_standing = CategoryBoundary | CategoryFriendly; // I collide with ...
 int16_t group_index = 0;                                           // 0 is default
+
+constexpr auto max_pooled_body_count = 64u;
 }
 
 
@@ -46,6 +48,73 @@ Gun::Gun(std::unique_ptr<b2Shape> shape, int32_t user_interval_ms, int32_t damag
 }
 
 
+Gun::~Gun()
+{
+   // the pooled bodies are only destroyed if their world still exists
+   auto world = _body_pool->_world.lock();
+   if (world)
+   {
+      for (auto body : _body_pool->_bodies)
+      {
+         world->DestroyBody(body);
+      }
+   }
+
+   _body_pool->_bodies.clear();
+}
+
+
+b2Body* Gun::acquirePooledBody(const std::shared_ptr<b2World>& world, const b2Vec2& pos, float angle)
+{
+   // bodies can't be carried over from one level to the next
+   if (_body_pool->_world.lock() != world)
+   {
+      _body_pool->_bodies.clear();
+      _body_pool->_world = world;
+   }
+
+   if (_body_pool->_bodies.empty())
+   {
+      return nullptr;
+   }
+
+   auto body = _body_pool->_bodies.back();
+   _body_pool->_bodies.pop_back();
+
+   body->SetTransform(pos, angle);
+   body->SetLinearVelocity({0.0f, 0.0f});
+   body->SetAngularVelocity(0.0f);
+   body->SetActive(true);
+   body->SetAwake(true);
+
+   return body;
+}
+
+
+void Gun::setupBodyRecycling(Projectile* projectile)
+{
+   projectile->setBodyRecycler([pool = _body_pool](b2Body* body){
+         auto world = pool->_world.lock();
+         if (!world || world.get() != body->GetWorld())
+         {
+            return;
+         }
+
+         if (pool->_bodies.size() >= max_pooled_body_count)
+         {
+            world->DestroyBody(body);
+            return;
+         }
+
+         // deactivating the body removes its contacts, after that the projectile can be detached
+         body->SetActive(false);
+         body->GetFixtureList()->SetUserData(nullptr);
+         pool->_bodies.push_back(body);
+      }
+   );
+}
+
+
 void Gun::copyReferenceAnimation(Projectile* projectile)
 {
    Animation animation(_projectile_reference_animation._animation);
@@ -63,21 +132,28 @@ void Gun::use(
    const b2Vec2& dir
 )
 {
-   b2BodyDef body_definition;
-   body_definition.type = b2_dynamicBody;
-   body_definition.position.Set(pos.x, pos.y);
+   auto bullet_body = acquirePooledBody(world, pos);
+
+   if (!bullet_body)
+   {
+      b2BodyDef body_definition;
+      body_definition.type = b2_dynamicBody;
+      body_definition.position.Set(pos.x, pos.y);
 
-   auto bullet_body = world->CreateBody(&body_definition);
-   bullet_body->SetBullet(true);
-   bullet_body->SetGravityScale(0.0f);
+      bullet_body = world->CreateBody(&body_definition);
+      bullet_body->SetBullet(true);
+      bullet_body->SetGravityScale(0.0f);
 
-   b2FixtureDef fixture_definition;
-   fixture_definition.shape = _shape.get();
-   fixture_definition.density = 0.0f;
+      b2FixtureDef fixture_definition;
+      fixture_definition.shape = _shape.get();
+      fixture_definition.density = 0.0f;
 
-   fixture_definition.filter.groupIndex   = group_index;
-   fixture_definition.filter.maskBits     = mask_bits_standing;
-   fixture_definition.filter.categoryBits = category_bits;
+      fixture_definition.filter.groupIndex   = group_index;
+      fixture_definition.filter.maskBits     = mask_bits_standing;
+      fixture_definition.filter.categoryBits = category_bits;
+
+      bullet_body->CreateFixture(&fixture_definition);
+   }
 
    bullet_body->ApplyLinearImpulse(dir, pos, true);
 
@@ -85,8 +161,9 @@ void Gun::use(
    auto projectile = new Projectile();
    copyReferenceAnimation(projectile);
 
-   projectile->setProperty("damage", _damage);
+   projectile->setProperty(FixtureNode::Property::Damage, _damage);
    projectile->setBody(bullet_body);
+   setupBodyRecycling(projectile);
 
    projectile->addDestroyedCallback([this, projectile](){
       _projectiles.erase(std::remove(_projectiles.begin(), _projectiles.end(), projectile), _projectiles.end());
@@ -97,8 +174,7 @@ void Gun::use(
       projectile->setProjectileIdentifier(_projectile_reference_animation._identifier.value());
    }
 
-   auto fixture = bullet_body->CreateFixture(&fixture_definition);
-   fixture->SetUserData(static_cast<void*>(projectile));
+   bullet_body->GetFixtureList()->SetUserData(static_cast<void*>(projectile));
 
    // store projectile
    _projectiles.push_back(projectile);
@@ -155,10 +231,48 @@ void Gun::updateProjectiles(const sf::Time& time)
 
 void Gun::drawProjectiles(sf::RenderTarget& target)
 {
+   if (_projectiles.empty())
+   {
+      return;
+   }
+
+   // the projectiles of a gun usually share the same texture, so consecutive projectiles with the same texture
+   // are drawn with a single call; animations with children are drawn on their own since only their own quad
+   // would end up in the batch
+   const sf::Texture* batch_texture = nullptr;
+   _projectile_vertices.clear();
+
+   const auto flush = [&]()
+   {
+      if (_projectile_vertices.getVertexCount() > 0)
+      {
+         target.draw(_projectile_vertices, batch_texture);
+         _projectile_vertices.clear();
+      }
+   };
+
    for (auto projectile : _projectiles)
    {
-      target.draw(projectile->getAnimation());
+      const auto& animation = projectile->getAnimation();
+      const auto texture = animation._color_texture.get();
+
+      if (texture != batch_texture || !animation._children.empty())
+      {
+         flush();
+         batch_texture = texture;
+      }
+
+      if (animation._children.empty())
+      {
+         animation.appendVertices(_projectile_vertices);
+      }
+      else
+      {
+         target.draw(animation);
+      }
    }
+
+   flush();
 }
 
 
@@ -251,11 +365,29 @@ void Gun::setProjectileAnimation(const AnimationFrameData& frame_data)
 
 void Gun::drawProjectileHitAnimations(sf::RenderTarget& target)
 {
-   // draw projectile hits
-   const auto& hit_animations = ProjectileHitAnimation::getHitAnimations();
-   for (auto hit_animation : hit_animations)
+   // draw projectile hits, consecutive hits with the same texture are batched into one draw call
+   static sf::VertexArray vertices(sf::Quads);
+   const sf::Texture* texture = nullptr;
+
+   const auto flush = [&target, &texture](){
+         if (vertices.getVertexCount() > 0)
+         {
+            target.draw(vertices, texture);
+            vertices.clear();
+         }
+      };
+
+   for (const auto& hit_animation : ProjectileHitAnimation::getHitAnimations())
    {
-      target.draw(*hit_animation);
+      if (hit_animation._color_texture.get() != texture)
+      {
+         flush();
+         texture = hit_animation._color_texture.get();
+      }
+
+      hit_animation.appendVertices(vertices);
    }
+
+   flush();
 }
 
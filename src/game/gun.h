@@ -31,6 +31,7 @@ public:
 
    Gun();
    Gun(std::unique_ptr<b2Shape>, int32_t use_interval, int32_t damage);
+   ~Gun() override;
 
    virtual void useInIntervals(
       const std::shared_ptr<b2World>& world,
@@ -65,11 +66,24 @@ public:
 
 protected:
 
+   //! bodies of removed projectiles, they're deactivated and handed out again for the next shots;
+   //! projectiles that outlive their gun keep the pool alive
+   struct BodyPool
+   {
+      std::weak_ptr<b2World> _world;
+      std::vector<b2Body*> _bodies;
+   };
+
    void drawProjectiles(sf::RenderTarget& target);
    void updateProjectiles(const sf::Time& time);
    void copyReferenceAnimation(Projectile* projectile);
 
+   b2Body* acquirePooledBody(const std::shared_ptr<b2World>& world, const b2Vec2& pos, float angle = 0.0f);
+   void setupBodyRecycling(Projectile* projectile);
+
    std::vector<Projectile*> _projectiles;
+   std::shared_ptr<BodyPool> _body_pool = std::make_shared<BodyPool>();
+   sf::VertexArray _projectile_vertices{sf::Quads};
 
    ProjectileAnimation _projectile_reference_animation;
 
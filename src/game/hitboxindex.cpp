@@ -0,0 +1,214 @@
+#include "hitboxindex.h"
+
+#include "luanode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace
+{
+// a few tiles, most enemies only ever cover one or two cells
+constexpr auto cell_size_px = 128.0f;
+}
+
+
+//-----------------------------------------------------------------------------
+HitboxIndex& HitboxIndex::getInstance()
+{
+   static HitboxIndex __instance;
+   return __instance;
+}
+
+
+//-----------------------------------------------------------------------------
+int64_t HitboxIndex::key(int32_t x, int32_t y)
+{
+   return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+
+//-----------------------------------------------------------------------------
+HitboxIndex::CellRange HitboxIndex::computeCellRange(const sf::FloatRect& rect_px) const
+{
+   CellRange range;
+   range._x0 = static_cast<int32_t>(std::floor(rect_px.left / cell_size_px));
+   range._y0 = static_cast<int32_t>(std::floor(rect_px.top / cell_size_px));
+   range._x1 = static_cast<int32_t>(std::floor((rect_px.left + rect_px.width) / cell_size_px));
+   range._y1 = static_cast<int32_t>(std::floor((rect_px.top + rect_px.height) / cell_size_px));
+   return range;
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::insertIntoCells(LuaNode* node, const CellRange& range)
+{
+   for (auto y = range._y0; y <= range._y1; y++)
+   {
+      for (auto x = range._x0; x <= range._x1; x++)
+      {
+         _cells[key(x, y)].push_back(node);
+      }
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::removeFromCells(LuaNode* node, const CellRange& range)
+{
+   for (auto y = range._y0; y <= range._y1; y++)
+   {
+      for (auto x = range._x0; x <= range._x1; x++)
+      {
+         auto it = _cells.find(key(x, y));
+         if (it == _cells.end())
+         {
+            continue;
+         }
+
+         auto& nodes = it->second;
+         nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+
+         if (nodes.empty())
+         {
+            _cells.erase(it);
+         }
+      }
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::update(LuaNode* node)
+{
+   if (node->_hitboxes.empty())
+   {
+      remove(node);
+      return;
+   }
+
+   // register the node with the bounds of all its hitboxes
+   auto left = std::numeric_limits<float>::max();
+   auto top = std::numeric_limits<float>::max();
+   auto right = std::numeric_limits<float>::lowest();
+   auto bottom = std::numeric_limits<float>::lowest();
+
+   for (const auto& hitbox : node->_hitboxes)
+   {
+      const auto rect = hitbox.getRectTranslated();
+      left = std::min(left, rect.left);
+      top = std::min(top, rect.top);
+      right = std::max(right, rect.left + rect.width);
+      bottom = std::max(bottom, rect.top + rect.height);
+   }
+
+   const auto range = computeCellRange({left, top, right - left, bottom - top});
+
+   auto it = _entries.find(node);
+   if (it == _entries.end())
+   {
+      _entries[node]._cells = range;
+      insertIntoCells(node, range);
+      return;
+   }
+
+   // most of the time nodes move within their cells
+   if (it->second._cells == range)
+   {
+      return;
+   }
+
+   removeFromCells(node, it->second._cells);
+   insertIntoCells(node, range);
+   it->second._cells = range;
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::remove(LuaNode* node)
+{
+   auto it = _entries.find(node);
+   if (it == _entries.end())
+   {
+      return;
+   }
+
+   removeFromCells(node, it->second._cells);
+   _entries.erase(it);
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::clear()
+{
+   _cells.clear();
+   _entries.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::query(const sf::FloatRect& rect_px, std::vector<LuaNode*>& nodes)
+{
+   query(&rect_px, 1, nodes);
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::query(const std::vector<sf::FloatRect>& rects_px, std::vector<LuaNode*>& nodes)
+{
+   query(rects_px.data(), rects_px.size(), nodes);
+}
+
+
+//-----------------------------------------------------------------------------
+void HitboxIndex::query(const sf::FloatRect* rects_px, size_t rect_count, std::vector<LuaNode*>& nodes)
+{
+   nodes.clear();
+
+   // nodes covering several cells are only tested once per query
+   _query_id++;
+
+   for (auto rect_index = 0u; rect_index < rect_count; rect_index++)
+   {
+      const auto range = computeCellRange(rects_px[rect_index]);
+
+      for (auto y = range._y0; y <= range._y1; y++)
+      {
+         for (auto x = range._x0; x <= range._x1; x++)
+         {
+            const auto cell_it = _cells.find(key(x, y));
+            if (cell_it == _cells.end())
+            {
+               continue;
+            }
+
+            for (auto node : cell_it->second)
+            {
+               auto& entry = _entries[node];
+               if (entry._query_id == _query_id)
+               {
+                  continue;
+               }
+
+               entry._query_id = _query_id;
+
+               const auto hit = std::any_of(node->_hitboxes.begin(), node->_hitboxes.end(), [rects_px, rect_count](const auto& hitbox)
+                  {
+                     const auto hitbox_rect = hitbox.getRectTranslated();
+                     return std::any_of(rects_px, rects_px + rect_count, [&hitbox_rect](const auto& rect) {
+                           return hitbox_rect.intersects(rect);
+                        }
+                     );
+                  }
+               );
+
+               if (hit)
+               {
+                  nodes.push_back(node);
+               }
+            }
+         }
+      }
+   }
+}
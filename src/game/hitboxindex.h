@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct LuaNode;
+
+
+/*! \brief Uniform grid over the hitboxes of all lua nodes
+ *
+ *  Each node is registered in the cells covered by the bounds of its hitboxes. Nodes update their entry whenever
+ *  they move, which is cheap as long as they stay within the same cells. Queries only look at the nodes in the
+ *  cells overlapping the search area, so hit detection scales with the number of nodes nearby rather than with
+ *  all nodes of the level.
+ */
+class HitboxIndex
+{
+
+public:
+
+   static HitboxIndex& getInstance();
+
+   void update(LuaNode* node);
+   void remove(LuaNode* node);
+   void clear();
+
+   // the nodes with a hitbox intersecting any of the rects are written to nodes, which is cleared first
+   void query(const sf::FloatRect& rect_px, std::vector<LuaNode*>& nodes);
+   void query(const std::vector<sf::FloatRect>& rects_px, std::vector<LuaNode*>& nodes);
+
+
+private:
+
+   struct CellRange
+   {
+      int32_t _x0 = 0;
+      int32_t _y0 = 0;
+      int32_t _x1 = -1;
+      int32_t _y1 = -1;
+
+      bool operator==(const CellRange& other) const
+      {
+         return _x0 == other._x0 && _y0 == other._y0 && _x1 == other._x1 && _y1 == other._y1;
+      }
+   };
+
+   struct Entry
+   {
+      CellRange _cells;
+      uint32_t _query_id = 0;
+   };
+
+   HitboxIndex() = default;
+
+   CellRange computeCellRange(const sf::FloatRect& rect_px) const;
+   void insertIntoCells(LuaNode* node, const CellRange& range);
+   void removeFromCells(LuaNode* node, const CellRange& range);
+   void query(const sf::FloatRect* rects_px, size_t rect_count, std::vector<LuaNode*>& nodes);
+
+   static int64_t key(int32_t x, int32_t y);
+
+   std::unordered_map<int64_t, std::vector<LuaNode*>> _cells;
+   std::unordered_map<LuaNode*, Entry> _entries;
+   uint32_t _query_id = 0;
+};
@@ -7,6 +7,7 @@
 #include "gameconfiguration.h"
 #include "framework/image/psd.h"
 #include "framework/tools/globalclock.h"
+#include "framework/tools/profiler.h"
 #include "player/player.h"
 #include "player/playerinfo.h"
 #include "savestate.h"
@@ -190,8 +191,51 @@ void InfoLayer::drawDebugInfo(sf::RenderTarget& window)
    stream_tl << "player tl: " << static_cast<int>(pos.x / PIXELS_PER_TILE) << ", " << static_cast<int>(pos.y / PIXELS_PER_TILE);
    stream_px << "player px: " << static_cast<int>(pos.x) << ", " << static_cast<int>(pos.y);
 
-   _font.draw(window, _font.getCoords(stream_tl.str()), 500, 5);
-   _font.draw(window, _font.getCoords(stream_px.str()), 500, 20);
+   _font.draw(window, stream_tl.str(), 500, 5);
+   _font.draw(window, stream_px.str(), 500, 20);
+
+   drawProfiler(window);
+}
+
+
+void InfoLayer::drawProfiler(sf::RenderTarget& window)
+{
+   static constexpr auto offset_x = 5;
+   static constexpr auto offset_y = 40;
+   static constexpr auto row_height = 14;
+   static constexpr auto histogram_x = 250;
+   static constexpr auto histogram_height = 12.0f;
+   static constexpr auto frame_budget_ms = 1000.0f / 60.0f;
+
+   const auto& histories = Profiler::getInstance().getHistories();
+   const auto history_index = Profiler::getInstance().getHistoryIndex();
+
+   // all histograms go into a single vertex array, one line per sample; same for the labels which change every frame
+   sf::VertexArray histograms(sf::Lines);
+   sf::VertexArray labels(sf::Quads);
+
+   auto y = offset_y;
+   for (const auto& [name, history] : histories)
+   {
+      _font.append(labels, fmt::format("{} {:.2f} {:.2f}", name, history._average_ms, history._max_ms), offset_x, y);
+
+      const auto bottom = static_cast<float>(y + row_height - 2);
+      // oldest sample on the left
+      for (auto i = 0u; i < history._values_ms.size(); i++)
+      {
+         const auto value_ms = history._values_ms[(history_index + i) % history._values_ms.size()];
+         const auto height = std::min(value_ms / frame_budget_ms, 1.0f) * histogram_height;
+         const auto color = (value_ms > frame_budget_ms) ? sf::Color::Red : sf::Color::Green;
+         const auto x = static_cast<float>(histogram_x + i);
+         histograms.append(sf::Vertex{{x, bottom}, color});
+         histograms.append(sf::Vertex{{x, bottom - height}, color});
+      }
+
+      y += row_height;
+   }
+
+   window.draw(labels, _font._texture.get());
+   window.draw(histograms);
 }
 
 
@@ -222,18 +266,17 @@ void InfoLayer::drawConsole(sf::RenderTarget& window, sf::RenderStates states)
    auto y = 0;
    for (auto it = commands.crbegin(); it != commands.crend(); ++it)
    {
-      _font.draw(window, _font.getCoords(*it), offset_x, offset_y - ( (y + 1) * 14));
+      _font.draw(window, *it, offset_x, offset_y - ( (y + 1) * 14));
       y++;
    }
 
-   auto bitmap_font = _font.getCoords(command);
-   _font.draw(window, bitmap_font, offset_x, h_screen - 28);
+   _font.draw(window, command, offset_x, h_screen - 28);
 
    // draw cursor
    auto elapsed = GlobalClock::getInstance().getElapsedTime();
    if (static_cast<int32_t>(elapsed.asSeconds()) % 2 == 0)
    {
-      _font.draw(window, _font.getCoords("_"), _font._text_width + offset_x, h_screen - 28);
+      _font.draw(window, "_", _font._text_width + offset_x, h_screen - 28);
    }
 }
 
@@ -27,6 +27,7 @@ public:
 private:
 
    void playHeartAnimation();
+   void drawProfiler(sf::RenderTarget& window);
    void drawHeartAnimation(sf::RenderTarget& window);
 
    BitmapFont _font;
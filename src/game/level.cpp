@@ -8,15 +8,18 @@
 #include "constants.h"
 #include "debugdraw.h"
 #include "displaymode.h"
+#include "dynamicresolution.h"
 #include "effects/dust.h"
 #include "extraitem.h"
 #include "extramanager.h"
 #include "fixturenode.h"
+#include "framecapture.h"
 #include "framework/math/maptools.h"
 #include "framework/math/sfmlmath.h"
 #include "framework/tools/checksum.h"
 #include "framework/tools/globalclock.h"
 #include "framework/tools/log.h"
+#include "framework/tools/profiler.h"
 #include "framework/tools/timer.h"
 #include "gameconfiguration.h"
 #include "gamecontactlistener.h"
@@ -33,6 +36,7 @@
 #include "mechanisms/door.h"
 #include "mechanisms/lever.h"
 #include "meshtools.h"
+#include "physics/chainchunks.h"
 #include "physics/physicsconfiguration.h"
 #include "player/player.h"
 #include "savestate.h"
@@ -43,6 +47,7 @@
 #include "tilemap.h"
 #include "tilemapfactory.h"
 #include "weather.h"
+#include "worldquery.h"
 
 // sfml
 #include <SFML/Graphics/RenderWindow.hpp>
@@ -62,6 +67,7 @@
 #include "framework/tmxparser/tmxtileset.h"
 #include "framework/tmxparser/tmxtools.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
@@ -107,70 +113,96 @@ void Level::initializeTextures()
 {
    const auto& game_config = GameConfiguration::getInstance();
 
-   // since stencil buffers are used, it is required to enable them explicitly
-   sf::ContextSettings stencil_context_settings;
-   stencil_context_settings.stencilBits = 8;
-   // stencil_context_settings.antialiasingLevel = 8; // makes texture tearing much more reproducable
-
-   _render_texture_level_background.reset();
-
    _atmosphere_shader.reset();
    _gamma_shader.reset();
    _blur_shader.reset();
 
+   _render_texture_level.reset();
+   _render_texture_level_background.reset();
+   _render_texture_lighting.reset();
+   _render_texture_normal.reset();
+   _render_texture_deferred.reset();
+   _render_target_pool.clear();
+
    // this the render texture size derived from the window dimensions. as opposed to the window
-   // dimensions this one takes the view dimensions into regard and preserves an integer multiplier
+   // dimensions this one takes the view dimensions into regard and preserves an integer multiplier.
+   // the multiplier can be capped so high window resolutions don't multiply memory and fill cost;
+   // the final level texture is scaled up to the window texture in that case.
    const auto ratio_width = game_config._video_mode_width / game_config._view_width;
    const auto ratio_height = game_config._video_mode_height / game_config._view_height;
-   const auto size_ratio = std::min(ratio_width, ratio_height);
+   const auto window_ratio = std::max(std::min(ratio_width, ratio_height), 1);
+   auto size_ratio = window_ratio;
+   if (game_config._render_scale_max > 0)
+   {
+      size_ratio = std::min(size_ratio, game_config._render_scale_max);
+   }
+
+   // the dynamic resolution may go below that if the gpu can't keep up
+   auto& dynamic_resolution = DynamicResolution::getInstance();
+   dynamic_resolution.setMaximumScale(size_ratio);
+   if (dynamic_resolution.isEnabled())
+   {
+      size_ratio = dynamic_resolution.getScale();
+   }
+
    _view_to_texture_scale = 1.0f / size_ratio;
 
-   const auto texture_width = static_cast<int32_t>(size_ratio * game_config._view_width);
-   const auto texture_height = static_cast<int32_t>(size_ratio * game_config._view_height);
+   const auto texture_width = static_cast<uint32_t>(size_ratio * game_config._view_width);
+   const auto texture_height = static_cast<uint32_t>(size_ratio * game_config._view_height);
 
-   _render_texture_level_background = std::make_shared<sf::RenderTexture>();
-   _render_texture_level_background->create(static_cast<uint32_t>(texture_width), static_cast<uint32_t>(texture_height));
+   // lighting and atmosphere are low-frequency, they may be rendered at half or quarter resolution.
+   // the light map is upsampled by the light shader guided by the normal map, the atmosphere texture
+   // is a mask and is just sampled with nearest filtering by the atmosphere shader
+   const auto effect_divisor = 1u << static_cast<uint32_t>(game_config._effect_resolution);
+   const auto effect_width = std::max(texture_width / effect_divisor, 1u);
+   const auto effect_height = std::max(texture_height / effect_divisor, 1u);
 
-   _render_texture_level = std::make_shared<sf::RenderTexture>();
-   _render_texture_level->create(
-      static_cast<uint32_t>(texture_width),
-      static_cast<uint32_t>(texture_height),
-      stencil_context_settings  // the lights require stencils
-   );
+   // declare which pass uses which render target, the pool aliases targets that are not alive at the same time.
+   // since stencil buffers are used by the lights, they are requested explicitly
+   const auto pass = [](RenderPass pass){return static_cast<int32_t>(pass);};
+   const RenderTargetPool::Descriptor color{texture_width, texture_height, false};
+   const RenderTargetPool::Descriptor color_stencil{texture_width, texture_height, true};
+   const RenderTargetPool::Descriptor effect{effect_width, effect_height, false};
+   const RenderTargetPool::Descriptor effect_stencil{effect_width, effect_height, true};
 
-   _render_texture_lighting = std::make_shared<sf::RenderTexture>();
-   _render_texture_lighting->create(
-      static_cast<uint32_t>(texture_width),
-      static_cast<uint32_t>(texture_height),
-      stencil_context_settings  // the lights require stencils
-   );
+   const auto atmosphere = _render_target_pool.declare("atmosphere", effect, pass(RenderPass::Atmosphere), pass(RenderPass::Background));
 
-   _render_texture_normal = std::make_shared<sf::RenderTexture>();
-   _render_texture_normal->create(static_cast<uint32_t>(texture_width), static_cast<uint32_t>(texture_height));
+#ifdef GLOW_ENABLED
+   const auto blur = _render_target_pool.declare("blur", color_stencil, pass(RenderPass::Glow), pass(RenderPass::Background));
+   const auto blur_scaled = _render_target_pool.declare("blur scaled", {960, 540, true}, pass(RenderPass::Background), pass(RenderPass::Background));
+#endif
 
-   _render_texture_deferred = std::make_shared<sf::RenderTexture>();
-   _render_texture_deferred->create(static_cast<uint32_t>(texture_width), static_cast<uint32_t>(texture_height));
+   const auto level_background = _render_target_pool.declare("level background", color, pass(RenderPass::Background), pass(RenderPass::Background));
+   const auto normal = _render_target_pool.declare("normal", color, pass(RenderPass::Background), pass(RenderPass::Light));
+   const auto level = _render_target_pool.declare("level", color_stencil, pass(RenderPass::Background), pass(RenderPass::Light));
+   const auto lighting = _render_target_pool.declare("lighting", effect_stencil, pass(RenderPass::Light), pass(RenderPass::Light));
+   const auto deferred = _render_target_pool.declare("deferred", color, pass(RenderPass::Light), pass(RenderPass::Gamma));
 
-   _atmosphere_shader = std::make_unique<AtmosphereShader>(texture_width, texture_height);
-   _gamma_shader = std::make_unique<GammaShader>();
-   _blur_shader = std::make_unique<BlurShader>(texture_width, texture_height);
+   _render_target_pool.compile();
 
-   // keep track of those textures
-   _render_textures.clear();
-   _render_textures.push_back(_render_texture_level);
-   _render_textures.push_back(_render_texture_level_background);
-   _render_textures.push_back(_render_texture_lighting);
-   _render_textures.push_back(_render_texture_normal);
-   _render_textures.push_back(_render_texture_deferred);
+   _render_texture_level = _render_target_pool.get(level);
+   _render_texture_level_background = _render_target_pool.get(level_background);
+   _render_texture_lighting = _render_target_pool.get(lighting);
+   _render_texture_normal = _render_target_pool.get(normal);
+   _render_texture_deferred = _render_target_pool.get(deferred);
 
-   for (const auto& fb : _render_textures)
-   {
-      Log::Info() << "created render texture: " << fb->getSize().x << " x " << fb->getSize().y;
-   }
+   // the deferred texture is scaled up to the window texture by a non-integer factor if the level is
+   // rendered at a lower scale than the window, so filter it in that case
+   _render_texture_deferred->setSmooth(size_ratio != window_ratio);
+
+   _atmosphere_shader = std::make_unique<AtmosphereShader>(_render_target_pool.get(atmosphere));
+   _gamma_shader = std::make_unique<GammaShader>();
+
+#ifdef GLOW_ENABLED
+   _blur_shader = std::make_unique<BlurShader>(_render_target_pool.get(blur), _render_target_pool.get(blur_scaled));
+#endif
 
    _atmosphere_shader->initialize();
    _gamma_shader->initialize();
+
+#ifdef GLOW_ENABLED
    _blur_shader->initialize();
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -186,10 +218,26 @@ Level::Level() : GameNode(nullptr)
    // clear those here so the world destructor doesn't double-delete them
    Projectile::clear();
 
+   ChainShapeAnalyzer::clear();
+
    _world = std::make_shared<b2World>(gravity);
 
+   // a new world may be allocated where a previous one was, don't hand out results cached for that one
+   WorldQuery::resetCache();
+
+   // solve the islands of busy rooms on all cores if configured
+   auto solver_thread_count = PhysicsConfiguration::getInstance()._solver_thread_count;
+   if (solver_thread_count == 0)
+   {
+      solver_thread_count = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+   }
+   _world->SetSolverThreadCount(solver_thread_count);
+
    GameContactListener::getInstance().reset();
    _world->SetContactListener(&GameContactListener::getInstance());
+   _world->SetDestructionListener(
+      &GameContactListener::getInstance().getDestructionListener(&WorldQuery::getCacheDestructionListener())
+   );
 
    __current_level = this;
 
@@ -262,6 +310,9 @@ Level::~Level()
 {
    Log::Info() << "deleting current level";
 
+   // the world's destructor doesn't call the destruction listener, cached query results must not outlive it
+   WorldQuery::resetCache();
+
    // stop active timers because their callbacks being called after destruction of the level/world can be nasty
    for (auto& enemy : _enemies)
    {
@@ -804,7 +855,24 @@ void Level::updateViews()
 
    CameraRoomLock::setViewRect(view_rect);
 
-   _level_view->reset(view_rect);
+   resetViews(level_view_x, level_view_y);
+}
+
+//-----------------------------------------------------------------------------
+void Level::interpolateViews()
+{
+   // the camera follows the player once per simulation step, the views are placed in between the
+   // last two steps just like the sprites so the camera doesn't snap while everything else moves smoothly
+   const auto& look_vector = CameraPanorama::getInstance().getLookVector();
+   const auto& camera_system = CameraSystem::getInstance();
+
+   resetViews(camera_system.getXInterpolated() + look_vector.x, camera_system.getYInterpolated() + look_vector.y);
+}
+
+//-----------------------------------------------------------------------------
+void Level::resetViews(float level_view_x, float level_view_y)
+{
+   _level_view->reset(sf::FloatRect{level_view_x, level_view_y, _view_width, _view_height});
 
    for (const auto& parallax : _parallax_layers)
    {
@@ -837,6 +905,7 @@ void Level::syncRoom()
 void Level::updateCameraSystem(const sf::Time& dt)
 {
    auto& camera_system = CameraSystem::getInstance();
+   camera_system.storePreviousPosition();
 
    // update room
    const auto prev_room = _room_current;
@@ -1066,7 +1135,7 @@ void Level::takeScreenshot(const std::string& basename, sf::RenderTexture& textu
    std::ostringstream ss;
    ss << basename << "_" << std::setw(2) << std::setfill('0') << _screenshot_counters[basename] << ".png";
    _screenshot_counters[basename]++;
-   texture.getTexture().copyToImage().saveToFile(ss.str());
+   FrameCapture::getInstance().capture(texture, ss.str());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1178,69 +1247,100 @@ void Level::draw(const std::shared_ptr<sf::RenderTexture>& window, bool screensh
 {
    _screenshot = screenshot;
 
+   interpolateViews();
+
+   StencilTileMap::nextFrame();
+
    // render atmosphere to atmosphere texture, that texture is used in the shader only
-   _atmosphere_shader->getRenderTexture()->clear();
-   drawAtmosphereLayer(*_atmosphere_shader->getRenderTexture().get());
-   _atmosphere_shader->getRenderTexture()->display();
-   takeScreenshot("texture_atmosphere", *_atmosphere_shader->getRenderTexture().get());
+   {
+      Profiler::Scope profiler_scope("draw atmosphere");
+      Profiler::GpuScope profiler_gpu_scope("draw atmosphere");
+      _atmosphere_shader->getRenderTexture()->clear();
+      drawAtmosphereLayer(*_atmosphere_shader->getRenderTexture().get());
+      _atmosphere_shader->getRenderTexture()->display();
+      takeScreenshot("texture_atmosphere", *_atmosphere_shader->getRenderTexture().get());
+   }
 
    // render glowing elements
-   drawGlowLayer();
+   {
+      Profiler::Scope profiler_scope("draw glow");
+      Profiler::GpuScope profiler_gpu_scope("draw glow");
+      drawGlowLayer();
+   }
 
    // render layers affected by the atmosphere
-   _render_texture_level_background->clear();
-   _render_texture_normal->clear();
-
-   drawLayers(
-      *_render_texture_level_background.get(),
-      *_render_texture_normal.get(),
-      static_cast<int32_t>(ZDepth::BackgroundMin),
-      static_cast<int32_t>(ZDepth::BackgroundMax)
-   );
-   _render_texture_level_background->display();
-   takeScreenshot("texture_level_background", *_render_texture_level_background.get());
-
-   // draw the atmospheric parts into the level texture using the atmosphere shader
-   sf::Sprite background_sprite(_render_texture_level_background->getTexture());
-   _atmosphere_shader->update();
-   _render_texture_level->draw(background_sprite, &_atmosphere_shader->getShader());
-
-   drawGlowSprite();
+   {
+      Profiler::Scope profiler_scope("draw background layers");
+      Profiler::GpuScope profiler_gpu_scope("draw background layers");
+      _render_texture_level_background->clear();
+      _render_texture_normal->clear();
+
+      drawLayers(
+         *_render_texture_level_background.get(),
+         *_render_texture_normal.get(),
+         static_cast<int32_t>(ZDepth::BackgroundMin),
+         static_cast<int32_t>(ZDepth::BackgroundMax)
+      );
+      _render_texture_level_background->display();
+      takeScreenshot("texture_level_background", *_render_texture_level_background.get());
+
+      // draw the atmospheric parts into the level texture using the atmosphere shader
+      sf::Sprite background_sprite(_render_texture_level_background->getTexture());
+      _atmosphere_shader->update();
+      _render_texture_level->draw(background_sprite, &_atmosphere_shader->getShader());
+
+      drawGlowSprite();
+   }
 
    // draw the level layers into the level texture
-   drawLayers(
-      *_render_texture_level.get(),
-      *_render_texture_normal.get(),
-      static_cast<int32_t>(ZDepth::ForegroundMin),
-      static_cast<int32_t>(ZDepth::ForegroundMax)
-   );
+   {
+      Profiler::Scope profiler_scope("draw foreground layers");
+      Profiler::GpuScope profiler_gpu_scope("draw foreground layers");
+      drawLayers(
+         *_render_texture_level.get(),
+         *_render_texture_normal.get(),
+         static_cast<int32_t>(ZDepth::ForegroundMin),
+         static_cast<int32_t>(ZDepth::ForegroundMax)
+      );
 
-   Gun::drawProjectileHitAnimations(*_render_texture_level.get());
-   AnimationPlayer::getInstance().draw(*_render_texture_level.get());
+      Gun::drawProjectileHitAnimations(*_render_texture_level.get());
+      AnimationPlayer::getInstance().draw(*_render_texture_level.get());
 
-   drawDebugInformation();
+      drawDebugInformation();
 
-   displayTextures();
+      displayTextures();
+   }
 
-   drawLightMap();
+   {
+      Profiler::Scope profiler_scope("draw light");
+      Profiler::GpuScope profiler_gpu_scope("draw light");
+      drawLightMap();
 
-   _light_system->draw(*_render_texture_deferred.get(), _render_texture_level, _render_texture_lighting, _render_texture_normal);
+      // the deferred texture may be shared with an earlier pass, so start off clean
+      _render_texture_deferred->setView(_render_texture_deferred->getDefaultView());
+      _render_texture_deferred->clear();
+      _light_system->draw(*_render_texture_deferred.get(), _render_texture_level, _render_texture_lighting, _render_texture_normal);
 
-   _render_texture_deferred->display();
+      _render_texture_deferred->display();
+   }
 
    takeScreenshot("texture_map_color", *_render_texture_level.get());
    takeScreenshot("texture_map_light", *_render_texture_lighting.get());
    takeScreenshot("texture_map_normal", *_render_texture_normal.get());
    takeScreenshot("texture_map_deferred", *_render_texture_deferred.get());
 
-   auto level_texture_sprite = sf::Sprite(_render_texture_deferred->getTexture());
-   _gamma_shader->setTexture(_render_texture_deferred->getTexture());
+   {
+      Profiler::Scope profiler_scope("draw gamma");
+      Profiler::GpuScope profiler_gpu_scope("draw gamma");
+      auto level_texture_sprite = sf::Sprite(_render_texture_deferred->getTexture());
+      _gamma_shader->setTexture(_render_texture_deferred->getTexture());
 
-   level_texture_sprite.setPosition(_boom_effect._boom_offset_x, _boom_effect._boom_offset_y);
-   level_texture_sprite.scale(_view_to_texture_scale, _view_to_texture_scale);
+      level_texture_sprite.setPosition(_boom_effect._boom_offset_x, _boom_effect._boom_offset_y);
+      level_texture_sprite.scale(_view_to_texture_scale, _view_to_texture_scale);
 
-   _gamma_shader->update();
-   window->draw(level_texture_sprite, &_gamma_shader->getGammaShader());
+      _gamma_shader->update();
+      window->draw(level_texture_sprite, &_gamma_shader->getGammaShader());
+   }
 
    if (DisplayMode::getInstance().isSet(Display::Map))
    {
@@ -1268,6 +1368,8 @@ const std::shared_ptr<LightSystem>& Level::getLightSystem() const
 //-----------------------------------------------------------------------------
 void Level::update(const sf::Time& dt)
 {
+   Profiler::Scope profiler_scope_update("level update");
+
    Projectile::update(dt);
 
    updateCameraSystem(dt);
@@ -1277,27 +1379,59 @@ void Level::update(const sf::Time& dt)
    // i.e. all objects on the belt are cleared here, then in Step() they are re-collected
    ConveyorBelt::resetBeltState();
 
-   _world->Step(PhysicsConfiguration::getInstance()._time_step, 8, 3);
+   {
+      Profiler::Scope profiler_scope("box2d step");
+      _world->Step(PhysicsConfiguration::getInstance()._time_step, 8, 3);
+   }
+
+   // everything has moved, so the queries of the last tick are outdated
+   WorldQuery::resetCache();
+
+   {
+      Profiler::Scope profiler_scope("contacts");
+      GameContactListener::getInstance().processEvents();
+   }
+
+   // box2d measures its internal stages itself
+   auto& profiler = Profiler::getInstance();
+   if (profiler.isEnabled())
+   {
+      const auto& profile = _world->GetProfile();
+      profiler.addSample("box2d collide", profile.collide);
+      profiler.addSample("box2d solve", profile.solve);
+      profiler.addSample("box2d solve toi", profile.solveTOI);
+      profiler.addSample("box2d broadphase", profile.broadphase);
+   }
 
    CameraPanorama::getInstance().update();
    _boom_effect.update(dt);
 
    AnimationPlayer::getInstance().update(dt);
 
-   for (auto& tile_map : _tile_maps)
    {
-      tile_map->update(dt);
+      Profiler::Scope profiler_scope("tile maps");
+      for (auto& tile_map : _tile_maps)
+      {
+         tile_map->update(dt);
+      }
    }
 
-   for (const auto& mechanism_vector : _mechanisms_list)
+   // only simulate what's close to the player
+   _simulation_lod.update(
+      {_level_view->getCenter() - _level_view->getSize() * 0.5f, _level_view->getSize()},
+      _room_current
+   );
+
    {
-      for (const auto& mechanism : *mechanism_vector)
-      {
-         mechanism->update(dt);
-      }
+      Profiler::Scope profiler_scope("mechanisms");
+      _simulation_lod.updateMechanisms(_mechanisms_list, dt);
    }
 
-   LuaInterface::instance().update(dt);
+   {
+      Profiler::Scope profiler_scope("lua");
+      _simulation_lod.updateEnemies(_enemies);
+      LuaInterface::instance().update(dt);
+   }
 
    updatePlayerLight();
 
@@ -1315,6 +1449,19 @@ const std::shared_ptr<b2World>& Level::getWorld() const
    return _world;
 }
 
+//-----------------------------------------------------------------------------
+const std::vector<std::vector<b2Vec2>>& Level::getWorldChains() const
+{
+   return _world_chains;
+}
+
+//-----------------------------------------------------------------------------
+const Level::WorldChainChunk* Level::getWorldChainChunk(b2Fixture* fixture) const
+{
+   const auto it = _world_chain_chunks.find(fixture);
+   return (it != _world_chain_chunks.end()) ? &it->second : nullptr;
+}
+
 //-----------------------------------------------------------------------------
 void Level::addChainToWorld(const std::vector<b2Vec2>& chain, ObjectType object_type)
 {
@@ -1330,25 +1477,54 @@ void Level::addChainToWorld(const std::vector<b2Vec2>& chain, ObjectType object_
    // it's easier to store all the physics chains in a separate data structure
    // than to parse the box2d world every time we want those loops.
    _world_chains.push_back(chain);
+   const auto chain_index = _world_chains.size() - 1;
 
-   b2ChainShape chain_shape;
-   chain_shape.CreateLoop(&chain.at(0), static_cast<int32_t>(chain.size()));
-
-   b2FixtureDef fixture_def;
-   fixture_def.density = 0.0f;
-   fixture_def.friction = 0.2f;
-   fixture_def.shape = &chain_shape;
+   // vertices shared with chains of another type are picked up right away rather than by scanning the world later
+   ChainShapeAnalyzer::addChain(static_cast<int32_t>(chain_index), chain, object_type);
 
    b2BodyDef body_def;
    body_def.position.Set(0, 0);
    body_def.type = b2_staticBody;
 
    auto body = _world->CreateBody(&body_def);
-   auto fixture = body->CreateFixture(&fixture_def);
-   auto object_data = new FixtureNode(this);
-   object_data->setObjectId(fmt::format("world_chain_{}", _world_chains.size() - 1));
-   object_data->setType(object_type);
-   fixture->SetUserData(static_cast<void*>(object_data));
+
+   auto add_fixture = [&](const b2ChainShape& chain_shape, int32_t offset)
+   {
+      b2FixtureDef fixture_def;
+      fixture_def.density = 0.0f;
+      fixture_def.friction = 0.2f;
+      fixture_def.shape = &chain_shape;
+
+      auto fixture = body->CreateFixture(&fixture_def);
+      auto object_data = new FixtureNode(this);
+      object_data->setObjectId(fmt::format("world_chain_{}", chain_index));
+      object_data->setType(object_type);
+      fixture->SetUserData(static_cast<void*>(object_data));
+
+      _world_chain_chunks[fixture] = {chain_index, offset};
+   };
+
+   // large outlines are split into chunks, one fixture each, so everything that walks chain vertices near a
+   // position only has to look at the chunks close by. the ghost vertices keep the seams between chunks smooth.
+   const auto chunk_size_m = PhysicsConfiguration::getInstance()._chain_chunk_size_tiles * PIXELS_PER_TILE / PPM;
+   const auto chunks = ChainChunks::split(chain, chunk_size_m);
+
+   if (chunks.empty())
+   {
+      b2ChainShape chain_shape;
+      chain_shape.CreateLoop(&chain.at(0), static_cast<int32_t>(chain.size()));
+      add_fixture(chain_shape, 0);
+      return;
+   }
+
+   for (const auto& chunk : chunks)
+   {
+      b2ChainShape chain_shape;
+      chain_shape.CreateChain(chunk._vertices.data(), static_cast<int32_t>(chunk._vertices.size()));
+      chain_shape.SetPrevVertex(chunk._prev_vertex);
+      chain_shape.SetNextVertex(chunk._next_vertex);
+      add_fixture(chain_shape, chunk._offset);
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -1556,8 +1732,6 @@ void Level::parsePhysicsTiles(
    //
    //      addPathsToWorld(layer->mOffsetX, layer->mOffsetY, deadly.mPaths, ObjectTypeDeadly);
    //   }
-
-   ChainShapeAnalyzer::analyze(_world);
 }
 
 //-----------------------------------------------------------------------------
@@ -13,7 +13,9 @@
 #include "luanode.h"
 #include "mechanisms/portal.h"
 #include "physics/physics.h"
+#include "rendertargetpool.h"
 #include "room.h"
+#include "simulationlod.h"
 #include "shaders/atmosphereshader.h"
 #include "shaders/blurshader.h"
 #include "shaders/gammashader.h"
@@ -65,6 +67,7 @@ public:
 
    void update(const sf::Time& dt);
    void updateViews();
+   void interpolateViews();
    void updateCameraSystem(const sf::Time& dt);
 
    void spawnEnemies();
@@ -77,6 +80,16 @@ public:
    const std::unordered_map<void*, b2Vec2*>& getPointMap() const;
    const std::unordered_map<void*, size_t>& getPointSizeMap() const;
 
+   // large world chains are split into several fixtures, each one covers the vertices of its loop from an offset on
+   struct WorldChainChunk
+   {
+      size_t _chain_index = 0;
+      int32_t _offset = 0;
+   };
+
+   const std::vector<std::vector<b2Vec2>>& getWorldChains() const;
+   const WorldChainChunk* getWorldChainChunk(b2Fixture* fixture) const;
+
    std::shared_ptr<Portal> getNearbyPortal() const;
    std::shared_ptr<Bouncer> getNearbyBouncer() const;
    const std::vector<std::shared_ptr<GameMechanism>>& getCheckpoints() const;
@@ -99,6 +112,17 @@ public:
    void syncRoom();
 
 protected:
+   // the passes of draw(), in order; used to declare the lifetime of render targets
+   enum class RenderPass : int32_t
+   {
+      Atmosphere,
+      Glow,
+      Background,
+      Foreground,
+      Light,
+      Gamma
+   };
+
    void addDebugRect(void* body, float x, float y, float w, float h);
 
    void parsePhysicsTiles(
@@ -122,6 +146,7 @@ protected:
    void takeScreenshot(const std::string& basename, sf::RenderTexture& texture);
    void updatePlayerLight();
    void updateRoom();
+   void resetViews(float level_view_x, float level_view_y);
 
    void drawLightAndShadows(sf::RenderTarget& target);
    void drawParallaxMaps(sf::RenderTarget& target, int32_t z_index);
@@ -147,7 +172,8 @@ protected:
    std::shared_ptr<sf::RenderTexture> _render_texture_lighting;
    std::shared_ptr<sf::RenderTexture> _render_texture_normal;
    std::shared_ptr<sf::RenderTexture> _render_texture_deferred;
-   std::vector<std::shared_ptr<sf::RenderTexture>> _render_textures;
+   RenderTargetPool _render_target_pool;
+   SimulationLod _simulation_lod;
 
    float _view_to_texture_scale = 1.0f;
    std::shared_ptr<sf::View> _level_view;
@@ -234,6 +260,7 @@ protected:
 
    std::shared_ptr<b2World> _world = nullptr;
    std::vector<std::vector<b2Vec2>> _world_chains;
+   std::unordered_map<b2Fixture*, WorldChainChunk> _world_chain_chunks;
 
    static Level* __current_level;
 };
@@ -71,8 +71,46 @@ void LevelMap::loadLevelTextures(
    _level_outline_texture = TexturePool::getInstance().get(outlines.string());
    _level_outline_sprite.setTexture(*_level_outline_texture);
 
-   // that render texture should have the same size as our level textures
-   _level_render_texture.create(_level_grid_texture->getSize().x, _level_grid_texture->getSize().y);
+   _static_render_texture_dirty = true;
+}
+
+
+void LevelMap::bakeStaticLayers()
+{
+   const auto size = _level_grid_texture->getSize();
+
+   if (_static_render_texture.getSize() != size)
+   {
+      _static_render_texture.create(size.x, size.y);
+   }
+
+   _level_grid_sprite.setColor(sf::Color{70, 70, 140, 255});
+   _level_outline_sprite.setColor(sf::Color{255, 255, 255, 80});
+
+   _static_render_texture.clear();
+   _static_render_texture.draw(_level_grid_sprite, sf::BlendMode{sf::BlendAdd});
+   _static_render_texture.draw(_level_outline_sprite, sf::BlendMode{sf::BlendAdd});
+
+   // draw grid
+   sf::VertexArray grid_lines(sf::Lines);
+   const auto grid_color = sf::Color{255, 255, 255, 30};
+
+   for (auto y = 0u; y < size.y; y += 16)
+   {
+      grid_lines.append(sf::Vertex(sf::Vector2f(0.0f, static_cast<float>(y)), grid_color));
+      grid_lines.append(sf::Vertex(sf::Vector2f(static_cast<float>(size.x), static_cast<float>(y)), grid_color));
+   }
+
+   for (auto x = 0u; x < size.x; x += 16)
+   {
+      grid_lines.append(sf::Vertex(sf::Vector2f(static_cast<float>(x), 0.0f), grid_color));
+      grid_lines.append(sf::Vertex(sf::Vector2f(static_cast<float>(x), static_cast<float>(size.y)), grid_color));
+   }
+
+   _static_render_texture.draw(grid_lines);
+   _static_render_texture.display();
+
+   _static_render_texture_dirty = false;
 }
 
 
@@ -93,13 +131,24 @@ void LevelMap::draw(sf::RenderTarget& window, sf::RenderStates states)
    level_view.setSize(static_cast<float>(_level_grid_sprite.getTexture()->getSize().x), static_cast<float>(_level_grid_sprite.getTexture()->getSize().y));
    level_view.setCenter(center);
    level_view.zoom(_zoom); // 1.5f works well, too
-   _level_grid_sprite.setColor(sf::Color{70, 70, 140, 255});
-   _level_outline_sprite.setColor(sf::Color{255, 255, 255, 80});
+
+   // those render textures should have the same size as our level textures; they're only created
+   // once the map is shown so they don't occupy video memory otherwise
+   if (_static_render_texture_dirty)
+   {
+      bakeStaticLayers();
+   }
+
+   if (_level_render_texture.getSize() != _level_grid_texture->getSize())
+   {
+      _level_render_texture.create(_level_grid_texture->getSize().x, _level_grid_texture->getSize().y);
+   }
+
+   // zoom and pan only move the view across the baked layers, only the level items are drawn from scratch
+   _level_render_texture.setView(level_view);
    _level_render_texture.clear();
-   _level_render_texture.draw(_level_grid_sprite, sf::BlendMode{sf::BlendAdd});
-   _level_render_texture.draw(_level_outline_sprite, sf::BlendMode{sf::BlendAdd});
+   _level_render_texture.draw(sf::Sprite(_static_render_texture.getTexture()));
    drawLevelItems(_level_render_texture);
-   _level_render_texture.setView(level_view);
    _level_render_texture.display();
 
    auto level_texture_sprite = sf::Sprite(_level_render_texture.getTexture());
@@ -158,79 +207,41 @@ void LevelMap::setPortals(const std::vector<std::shared_ptr<GameMechanism>>& por
 
 void LevelMap::drawLevelItems(sf::RenderTarget& target, sf::RenderStates)
 {
-   float scale = 3.0f;
-
-   // draw grid
-   for (auto y = 0u; y < target.getSize().y; y += 16)
-   {
-      sf::Vertex a(sf::Vector2f(0.0f, static_cast<float>(y)));
-      sf::Vertex b(sf::Vector2f(static_cast<float>(target.getSize().x), static_cast<float>(y)));
-      a.color.a = 30;
-      b.color.a = 30;
-
-      sf::Vertex line[] = {a, b};
-
-      target.draw(line, 2, sf::Lines);
-   }
-
-   for (auto x = 0u; x < target.getSize().x; x += 16)
-   {
-      sf::Vertex a(sf::Vector2f(static_cast<float>(x), 0.0f));
-      sf::Vertex b(sf::Vector2f(static_cast<float>(x), static_cast<float>(target.getSize().y)));
-      a.color.a = 30;
-      b.color.a = 30;
+   constexpr auto scale = 3.0f;
 
-      sf::Vertex line[] = {a, b};
+   _level_item_vertices.clear();
 
-      target.draw(line, 2, sf::Lines);
-   }
+   const auto append_quad = [this](const sf::Vector2f& pos, float width, float height, const sf::Color& color){
+         _level_item_vertices.append(sf::Vertex(sf::Vector2f(pos.x,         pos.y),          color));
+         _level_item_vertices.append(sf::Vertex(sf::Vector2f(pos.x + width, pos.y),          color));
+         _level_item_vertices.append(sf::Vertex(sf::Vector2f(pos.x + width, pos.y + height), color));
+         _level_item_vertices.append(sf::Vertex(sf::Vector2f(pos.x,         pos.y + height), color));
+      };
 
    // draw doors
-   float doorWidth = 2.0f;
-   float doorHeight = 9.0f;
+   constexpr auto door_width = 2.0f;
+   constexpr auto door_height = 9.0f;
 
    for (auto& d : _doors)
    {
       auto door = std::dynamic_pointer_cast<Door>(d);
-
-      sf::VertexArray quad(sf::Quads, 4);
-      quad[0].color = sf::Color::White;
-      quad[1].color = sf::Color::White;
-      quad[2].color = sf::Color::White;
-      quad[3].color = sf::Color::White;
-
-      auto pos = sf::Vector2f(static_cast<float>(door->getTilePosition().x), static_cast<float>(door->getTilePosition().y));
-
-      quad[0].position = sf::Vector2f(static_cast<float>(pos.x * scale),             static_cast<float>(pos.y * scale));
-      quad[1].position = sf::Vector2f(static_cast<float>(pos.x * scale + doorWidth), static_cast<float>(pos.y * scale));
-      quad[2].position = sf::Vector2f(static_cast<float>(pos.x * scale + doorWidth), static_cast<float>(pos.y * scale + doorHeight));
-      quad[3].position = sf::Vector2f(static_cast<float>(pos.x * scale),             static_cast<float>(pos.y * scale + doorHeight));
-
-      target.draw(&quad[0], 4, sf::Quads);
+      const auto pos = sf::Vector2f(static_cast<float>(door->getTilePosition().x), static_cast<float>(door->getTilePosition().y));
+      append_quad(pos * scale, door_width, door_height, sf::Color::White);
    }
 
    // draw portals
-   float portalWidth = 3.0f;
-   float portalHeight = 6.0f;
+   constexpr auto portal_width = 3.0f;
+   constexpr auto portal_height = 6.0f;
+
    for (auto& p : _portals)
    {
-      sf::VertexArray quad(sf::Quads, 4);
-      quad[0].color = sf::Color::Red;
-      quad[1].color = sf::Color::Red;
-      quad[2].color = sf::Color::Red;
-      quad[3].color = sf::Color::Red;
-
       auto portal = std::dynamic_pointer_cast<Portal>(p);
-      auto pos = sf::Vector2f(portal->getTilePosition().x, portal->getTilePosition().y);
-
-      quad[0].position = sf::Vector2f(static_cast<float>(pos.x * scale),               static_cast<float>(pos.y * scale));
-      quad[1].position = sf::Vector2f(static_cast<float>(pos.x * scale + portalWidth), static_cast<float>(pos.y * scale));
-      quad[2].position = sf::Vector2f(static_cast<float>(pos.x * scale + portalWidth), static_cast<float>(pos.y * scale + portalHeight));
-      quad[3].position = sf::Vector2f(static_cast<float>(pos.x * scale),               static_cast<float>(pos.y * scale + portalHeight));
-
-      target.draw(&quad[0], 4, sf::Quads);
+      const auto pos = sf::Vector2f(static_cast<float>(portal->getTilePosition().x), static_cast<float>(portal->getTilePosition().y));
+      append_quad(pos * scale, portal_width, portal_height, sf::Color::Red);
    }
 
+   target.draw(_level_item_vertices);
+
    // draw player
    auto playerWidth = 5.0f;
    auto playerHeight = 4;
@@ -240,6 +251,3 @@ void LevelMap::drawLevelItems(sf::RenderTarget& target, sf::RenderStates)
    square.setFillColor(sf::Color::White);
    target.draw(square);
 }
-
-
-
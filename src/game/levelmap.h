@@ -31,6 +31,7 @@ class LevelMap
 
    private:
 
+      void bakeStaticLayers();
       void drawLevelItems(sf::RenderTarget& window, sf::RenderStates = sf::RenderStates::Default);
 
       BitmapFont _font;
@@ -38,6 +39,13 @@ class LevelMap
 
       sf::RenderTexture _level_render_texture;
 
+      // grid, outlines and grid lines don't change while the level is loaded, so they're composed once
+      sf::RenderTexture _static_render_texture;
+      bool _static_render_texture_dirty = true;
+
+      // doors, portals and the player go into one vertex array that's re-built every frame
+      sf::VertexArray _level_item_vertices{sf::Quads};
+
       std::shared_ptr<sf::Texture> _level_grid_texture;
       sf::Sprite _level_grid_sprite;
 
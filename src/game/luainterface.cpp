@@ -1,5 +1,7 @@
 #include "luainterface.h"
 
+#include "hitboxindex.h"
+
 // lua
 #include "lua/lua.hpp"
 
@@ -24,6 +26,7 @@ std::shared_ptr<LuaNode> LuaInterface::addObject(GameNode* parent, const std::st
 
 void LuaInterface::removeObject(const std::shared_ptr<LuaNode>& node)
 {
+   HitboxIndex::getInstance().remove(node.get());
    _object_list.erase(std::remove(_object_list.begin(), _object_list.end(), node), _object_list.end());
 }
 
@@ -34,6 +37,13 @@ void LuaInterface::update(const sf::Time& dt)
    {
       auto object = *it;
 
+      // far away objects are put to sleep by the simulation lod
+      if (object->isDormant())
+      {
+         ++it;
+         continue;
+      }
+
       object->luaMovedTo();
       object->luaPlayerMovedTo();
       object->luaUpdate(dt);
@@ -43,6 +53,7 @@ void LuaInterface::update(const sf::Time& dt)
 
       if (!object->_body)
       {
+         HitboxIndex::getInstance().remove(object.get());
          it = _object_list.erase(it);
       }
       else
@@ -82,6 +93,7 @@ const std::vector<std::shared_ptr<LuaNode>>& LuaInterface::getObjectList()
 void LuaInterface::reset()
 {
    _object_list.clear();
+   HitboxIndex::getInstance().clear();
 }
 
 
@@ -14,17 +14,20 @@
 #include "audio.h"
 #include "constants.h"
 #include "detonationanimation.h"
+#include "fixedtimestep.h"
 #include "fixturenode.h"
 #include "framework/math/sfmlmath.h"
 #include "framework/tools/log.h"
 #include "framework/tools/timer.h"
 #include "gun.h"
+#include "hitboxindex.h"
 #include "level.h"
 #include "luaconstants.h"
 #include "luainterface.h"
 #include "player/player.h"
 #include "texturepool.h"
 #include "weaponfactory.h"
+#include "worldquery.h"
 
 namespace
 {
@@ -1757,6 +1760,11 @@ void LuaNode::setGravityScale(float scale)
 void LuaNode::setTransform(const b2Vec2& position, float32 angle)
 {
    _body->SetTransform(position, angle);
+
+   // don't interpolate from where the node was before it was moved
+   _position_px.x = position.x * PPM;
+   _position_px.y = position.y * PPM;
+   _position_previous_px = _position_px;
 }
 
 void LuaNode::addSprite()
@@ -1793,7 +1801,7 @@ void LuaNode::setDamageToPlayer(int32_t damage)
       }
 
       auto fixture_node = static_cast<FixtureNode*>(fixture->GetUserData());
-      fixture_node->setProperty("damage", damage);
+      fixture_node->setProperty(FixtureNode::Property::Damage, damage);
    }
 }
 
@@ -1807,53 +1815,17 @@ void LuaNode::makeStatic()
    _body->SetType(b2_staticBody);
 }
 
-class LuaQueryCallback : public b2QueryCallback
-{
-public:
-   std::vector<b2Body*> _bodies;
-
-   bool ReportFixture(b2Fixture* fixture)
-   {
-      _bodies.push_back(fixture->GetBody());
-
-      // to keep going to find all fixtures in the query area
-      return true;
-   }
-};
-
 int32_t LuaNode::queryAABB(const b2AABB& aabb)
 {
-   LuaQueryCallback query_callback;
-   Level::getCurrentLevel()->getWorld()->QueryAABB(&query_callback, aabb);
-
-   // Log::Info() << queryCallback.mBodies.size();
-   return static_cast<int32_t>(query_callback._bodies.size());
+   // enemies tend to ask for the same areas within a tick, so the results are shared
+   const auto& fixtures = WorldQuery::queryFixturesCached(Level::getCurrentLevel()->getWorld(), aabb);
+   return static_cast<int32_t>(fixtures.size());
 }
 
-class LuaRaycastCallback : public b2RayCastCallback
-{
-public:
-   std::vector<b2Body*> _bodies;
-
-   float ReportFixture(
-      b2Fixture* fixture,
-      const b2Vec2& /*point*/,
-      const b2Vec2& /*normal*/,
-      float32 /*fraction*/
-   )
-   {
-      _bodies.push_back(fixture->GetBody());
-      return 0.0f;
-   }
-};
-
 int32_t LuaNode::queryRaycast(const b2Vec2& point1, const b2Vec2& point2)
 {
-   LuaRaycastCallback query_callback;
-   Level::getCurrentLevel()->getWorld()->RayCast(&query_callback, point1, point2);
-
-   // Log::Info() << queryCallback.mBodies.size();
-   return static_cast<int32_t>(query_callback._bodies.size());
+   const auto& fixtures = WorldQuery::rayCastCached(Level::getCurrentLevel()->getWorld(), point1, point2);
+   return static_cast<int32_t>(fixtures.size());
 }
 
 bool LuaNode::getPropertyBool(const std::string& key, bool default_value)
@@ -1917,7 +1889,7 @@ void LuaNode::setupBody()
       auto fixture = _body->CreateFixture(&fd);
       auto fixture_node = new FixtureNode(this);
       fixture_node->setType(ObjectTypeEnemy);
-      fixture_node->setProperty("damage", damage);
+      fixture_node->setProperty(FixtureNode::Property::Damage, damage);
       fixture_node->setCollisionCallback([this]() { luaCollisionWithPlayer(); });
       fixture->SetUserData(static_cast<void*>(fixture_node));
 
@@ -1972,6 +1944,29 @@ void LuaNode::stopScript()
    }
 }
 
+void LuaNode::setDormant(bool dormant)
+{
+   if (_dormant == dormant)
+   {
+      return;
+   }
+
+   _dormant = dormant;
+
+   if (_body)
+   {
+      _body->SetActive(!dormant);
+   }
+
+   // the script isn't updated while dormant, so its timeouts shouldn't fire either
+   Timer::setPausedByCaller(this, dormant);
+}
+
+bool LuaNode::isDormant() const
+{
+   return _dormant;
+}
+
 int32_t LuaNode::getDamageFromPlayer() const
 {
    return _damage_from_player;
@@ -2042,6 +2037,9 @@ void LuaNode::updatePosition()
    auto x_px = _body->GetPosition().x * PPM;
    auto y_px = _body->GetPosition().y * PPM;
 
+   // remember where the node was during the previous simulation step so drawing can interpolate
+   _position_previous_px = _position_previous_px.has_value() ? _position_px : sf::Vector2f{x_px, y_px};
+
    _position_px.x = x_px;
    _position_px.y = y_px;
 
@@ -2051,6 +2049,8 @@ void LuaNode::updatePosition()
       hitbox._rect_px.left = x_px;
       hitbox._rect_px.top = y_px;
    }
+
+   HitboxIndex::getInstance().update(this);
 }
 
 void LuaNode::updateSpriteRect(int32_t id, int32_t x_px, int32_t y_px, int32_t w_px, int32_t h_px)
@@ -2102,12 +2102,14 @@ void LuaNode::draw(sf::RenderTarget& target)
       w->draw(target);
    }
 
+   const auto position_px = FixedTimeStep::interpolate(_position_previous_px.value_or(_position_px), _position_px);
+
    for (auto i = 0u; i < _sprites.size(); i++)
    {
       auto& sprite = _sprites[i];
       const auto& offset = _sprite_offsets_px[i];
       const auto center = sf::Vector2f(sprite.getTextureRect().width / 2.0f, sprite.getTextureRect().height / 2.0f);
-      sprite.setPosition(_position_px - center + offset);
+      sprite.setPosition(position_px - center + offset);
       target.draw(sprite, &_flash_shader);
    }
 }
@@ -149,6 +149,10 @@ struct LuaNode : public GameNode
    void setupBody();
    void stopScript();
 
+   //! dormant nodes are not updated and their body is taken out of the simulation
+   void setDormant(bool dormant);
+   bool isDormant() const;
+
    // members
    int32_t _id = -1;
    int32_t _keys_pressed = 0;
@@ -162,6 +166,7 @@ struct LuaNode : public GameNode
    std::vector<sf::Sprite> _sprites = {{}};                  // have 1 base sprite
    std::vector<sf::Vector2f> _sprite_offsets_px = {{0, 0}};  // have 1 base sprite offset
    sf::Vector2f _position_px;
+   std::optional<sf::Vector2f> _position_previous_px;
    int32_t _z_index = static_cast<int32_t>(ZDepth::Player);
    std::vector<sf::Vector2f> _movement_path_px;
    sf::Shader _flash_shader;
@@ -169,6 +174,7 @@ struct LuaNode : public GameNode
 
    // physics
    b2Body* _body = nullptr;
+   bool _dormant = false;
    b2BodyDef* _body_def = nullptr;
    std::vector<b2Shape*> _shapes_m;
    std::vector<std::unique_ptr<Weapon>> _weapons;
@@ -137,6 +137,12 @@ void Bouncer::update(const sf::Time& /*dt*/)
 }
 
 
+std::optional<sf::FloatRect> Bouncer::getBoundingBoxPx()
+{
+   return sf::FloatRect(_rect);
+}
+
+
 bool Bouncer::isPlayerAtBouncer()
 {
    return _player_at_bouncer;
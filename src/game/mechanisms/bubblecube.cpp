@@ -8,6 +8,7 @@
 #include "level.h"
 #include "player/player.h"
 #include "texturepool.h"
+#include "worldquery.h"
 
 #include <iostream>
 
@@ -364,59 +365,46 @@ void BubbleCube::updatePoppedCondition()
 }
 
 
-struct BubbleQueryCallback : public b2QueryCallback
+namespace
 {
-   std::vector<b2Body*> _bodies;
-   b2Body* _body = nullptr;
-   std::optional<size_t> _max_count;
-
-   bool checkBelongsToPlayer(b2Fixture* fixture) const
+bool belongsToPlayer(b2Fixture* fixture)
+{
+   auto fixture_node = static_cast<FixtureNode*>(fixture->GetUserData());
+   if (!fixture_node)
    {
-      auto fixture_node = static_cast<FixtureNode*>(fixture->GetUserData());
-      if (!fixture_node)
-      {
-         return false;
-      }
-
-      return dynamic_cast<Player*>(fixture_node->getParent());
+      return false;
    }
 
-   bool ReportFixture(b2Fixture* fixture)
-   {
-      // filter out player fixtures and the bubble body
-      if (checkBelongsToPlayer(fixture))
-      {
-         return true;
-      }
-      else if (fixture->GetBody() == _body)
-      {
-         return true;
-      }
-
-      _bodies.push_back(fixture->GetBody());
-
-      if (_max_count.has_value() && _bodies.size() > _max_count)
-      {
-         // abort query
-         return false;
-      }
-
-      return true;
-   }
-};
+   return dynamic_cast<Player*>(fixture_node->getParent());
+}
+}
 
 
 void BubbleCube::updatePopOnCollisionCondition()
 {
    // make the bubble pop when it's moved into another body
    auto countBodies = [this]() -> size_t {
-      BubbleQueryCallback query_callback;
-      query_callback._max_count = _colliding_body_count;
-      query_callback._body = _body;
       b2AABB aabb;
       _fixture->GetShape()->ComputeAABB(&aabb, _body->GetTransform(), 0);
-      Level::getCurrentLevel()->getWorld()->QueryAABB(&query_callback, aabb);
-      return query_callback._bodies.size();
+
+      size_t count = 0;
+      for (auto fixture : WorldQuery::queryFixturesCached(Level::getCurrentLevel()->getWorld(), aabb))
+      {
+         // filter out player fixtures and the bubble body
+         if (belongsToPlayer(fixture) || fixture->GetBody() == _body)
+         {
+            continue;
+         }
+
+         // no need to count any further than the reference count
+         count++;
+         if (_colliding_body_count.has_value() && count > _colliding_body_count)
+         {
+            break;
+         }
+      }
+
+      return count;
    };
 
    // this is going to be the reference count of bodies for future checks
@@ -470,7 +458,7 @@ void BubbleCube::pop()
 
 // the box2d code path is no longer required and only kept for debugging purposes
 
-void BubbleCube::beginContact(b2Contact* /*contact*/, FixtureNode* other)
+void BubbleCube::beginContact(FixtureNode* other)
 {
    if (other->getType() != ObjectTypePlayerFootSensor)
    {
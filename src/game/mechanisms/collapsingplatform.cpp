@@ -302,7 +302,7 @@ void CollapsingPlatform::update(const sf::Time& dt)
 }
 
 
-void CollapsingPlatform::beginContact(b2Contact* /*contact*/, FixtureNode* other)
+void CollapsingPlatform::beginContact(FixtureNode* other)
 {
    if (other->getType() != ObjectTypePlayerFootSensor)
    {
@@ -67,6 +67,12 @@ void ConveyorBelt::update(const sf::Time& dt)
 }
 
 
+std::optional<sf::FloatRect> ConveyorBelt::getBoundingBoxPx()
+{
+   return sf::FloatRect(_belt_pixel_rect);
+}
+
+
 void ConveyorBelt::setEnabled(bool enabled)
 {
    GameMechanism::setEnabled(enabled);
@@ -244,7 +250,7 @@ void ConveyorBelt::processFixtureNode(
    {
       auto player_body = Player::getCurrent()->getBody();
 
-      auto belt = dynamic_cast<ConveyorBelt*>(fixture_node);
+      auto belt = static_cast<ConveyorBelt*>(fixture_node);
 
       if (!belt->isEnabled())
       {
@@ -24,6 +24,7 @@ class ConveyorBelt : public FixtureNode, public GameMechanism
 
       void draw(sf::RenderTarget& color, sf::RenderTarget& normal) override;
       void update(const sf::Time& dt) override;
+      std::optional<sf::FloatRect> getBoundingBoxPx() override;
       void setEnabled(bool enabled) override;
 
       sf::IntRect getPixelRect() const;
@@ -172,6 +172,12 @@ void Fan::update(const sf::Time& dt)
 }
 
 
+std::optional<sf::FloatRect> Fan::getBoundingBoxPx()
+{
+   return sf::FloatRect(_pixel_rect);
+}
+
+
 void Fan::load(const GameDeserializeData& data)
 {
    static const sf::Vector2f vector_up{0.0f, 1.0f};
@@ -43,6 +43,7 @@ class Fan : public GameMechanism, public GameNode
 
       void draw(sf::RenderTarget& color, sf::RenderTarget& normal) override;
       void update(const sf::Time& dt) override;
+      std::optional<sf::FloatRect> getBoundingBoxPx() override;
       const sf::Rect<int32_t>& getPixelRect() const;
       void setEnabled(bool enabled) override;
 
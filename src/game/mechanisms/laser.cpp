@@ -209,6 +209,13 @@ void Laser::update(const sf::Time& dt)
 }
 
 
+//-----------------------------------------------------------------------------
+std::optional<sf::FloatRect> Laser::getBoundingBoxPx()
+{
+   return sf::FloatRect(_pixel_rect);
+}
+
+
 //-----------------------------------------------------------------------------
 void Laser::reset()
 {
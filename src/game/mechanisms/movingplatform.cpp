@@ -2,6 +2,7 @@
 #include "movingplatform.h"
 
 #include "constants.h"
+#include "fixedtimestep.h"
 #include "fixturenode.h"
 #include "framework/math/sfmlmath.h"
 #include "framework/tmxparser/tmximage.h"
@@ -17,6 +18,7 @@
 #include "physics/physicsconfiguration.h"
 #include "texturepool.h"
 
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 
@@ -40,6 +42,11 @@ MovingPlatform::MovingPlatform(GameNode *parent)
 //-----------------------------------------------------------------------------
 void MovingPlatform::draw(sf::RenderTarget& color, sf::RenderTarget& normal)
 {
+   // sprites are positioned at the current simulation step, shift them back to the interpolated position
+   const auto position_px = FixedTimeStep::interpolate(_position_previous_px.value_or(_position_px), _position_px);
+   sf::RenderStates states;
+   states.transform.translate(position_px - _position_px);
+
    for (auto& sprite : _sprites)
    {
       sprite.setTexture(*_texture_map.get());
@@ -47,7 +54,7 @@ void MovingPlatform::draw(sf::RenderTarget& color, sf::RenderTarget& normal)
 
    for (const auto& sprite : _sprites)
    {
-      color.draw(sprite);
+      color.draw(sprite, states);
    }
 
    for (auto& sprite : _sprites)
@@ -57,7 +64,7 @@ void MovingPlatform::draw(sf::RenderTarget& color, sf::RenderTarget& normal)
 
    for (const auto& sprite : _sprites)
    {
-      normal.draw(sprite);
+      normal.draw(sprite, states);
    }
 }
 
@@ -572,6 +579,10 @@ void MovingPlatform::update(const sf::Time& dt)
 
     _body->SetLinearVelocity(_velocity);
 
+   const auto position_px = sf::Vector2f{_body->GetPosition().x * PPM, _body->GetPosition().y * PPM};
+   _position_previous_px = _position_previous_px.has_value() ? _position_px : position_px;
+   _position_px = position_px;
+
    // update sprite animation
    //
    //   0123 4567
@@ -648,3 +659,57 @@ void MovingPlatform::update(const sf::Time& dt)
    }
 }
 
+
+//-----------------------------------------------------------------------------
+std::optional<sf::FloatRect> MovingPlatform::getBoundingBoxPx()
+{
+   if (_pixel_path.empty())
+   {
+      return std::nullopt;
+   }
+
+   const auto [min_x, max_x] = std::minmax_element(_pixel_path.begin(), _pixel_path.end(), [](const auto& a, const auto& b){return a.x < b.x;});
+   const auto [min_y, max_y] = std::minmax_element(_pixel_path.begin(), _pixel_path.end(), [](const auto& a, const auto& b){return a.y < b.y;});
+
+   // the path is followed by the platform's top left corner, one tile is added around it for the perspective tile
+   return sf::FloatRect{
+      min_x->x - PIXELS_PER_TILE,
+      min_y->y - PIXELS_PER_TILE,
+      max_x->x - min_x->x + (_element_count + 2) * PIXELS_PER_TILE,
+      max_y->y - min_y->y + 3 * PIXELS_PER_TILE
+   };
+}
+
+
+//-----------------------------------------------------------------------------
+void MovingPlatform::setDormant(bool dormant)
+{
+   _body->SetActive(!dormant);
+}
+
+
+//-----------------------------------------------------------------------------
+void MovingPlatform::fastForward(const sf::Time& dormant_time, const sf::Time& dt)
+{
+   if (dt <= sf::Time::Zero)
+   {
+      return;
+   }
+
+   // same movement as in update but without the player and sprite updates, replayed in the same fixed steps
+   // the level is updated with; the body is inactive while fast-forwarding, so it's moved by hand just like
+   // box2d would move it
+   const auto step_count = static_cast<int32_t>(dormant_time.asMicroseconds() / dt.asMicroseconds());
+   auto pos = _body->GetPosition();
+
+   for (auto i = 0; i < step_count; i++)
+   {
+      updateLeverLag(dt);
+      _interpolation.update(pos);
+      _velocity = _lever_lag * TIMESTEP_ERROR * (PPM / 60.0f) * _interpolation.getVelocity();
+      pos += dt.asSeconds() * _velocity;
+   }
+
+   _body->SetTransform(pos, _body->GetAngle());
+}
+
@@ -8,6 +8,7 @@
 
 #include "Box2D/Box2D.h"
 #include <filesystem>
+#include <optional>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -32,6 +33,9 @@ public:
 
    void draw(sf::RenderTarget& color, sf::RenderTarget& normal) override;
    void update(const sf::Time& dt) override;
+   std::optional<sf::FloatRect> getBoundingBoxPx() override;
+   void setDormant(bool dormant) override;
+   void fastForward(const sf::Time& dormant_time, const sf::Time& dt) override;
 
    void setupBody(const std::shared_ptr<b2World>& world);
    void addSprite(const sf::Sprite&);
@@ -72,5 +76,7 @@ private:
    PathInterpolation<b2Vec2> _interpolation;
    b2Vec2 _velocity;
    std::vector<sf::Vector2f> _pixel_path;
+   sf::Vector2f _position_px;
+   std::optional<sf::Vector2f> _position_previous_px;
 };
 
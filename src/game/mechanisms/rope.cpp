@@ -10,6 +10,12 @@
 #include <array>
 #include <iostream>
 
+namespace
+{
+// the wind is tuned to the mass of the box2d bodies that made up the rope segments before
+constexpr auto segment_mass_kg = 20.0f * 0.025f * 0.025f;
+}
+
 int32_t Rope::_instance_counter = 0;
 
 
@@ -18,16 +24,8 @@ Rope::Rope(GameNode* parent)
 {
    setClassName(typeid(Rope).name());
 
-   _joint_def.collideConnected = false;
-
    setZ(16);
 
-   // chain element setup
-   _rope_element_shape.SetAsBox(0.0125f, 0.0125f);
-   _rope_element_fixture_def.shape = &_rope_element_shape;
-   _rope_element_fixture_def.density = 20.0f;
-   _rope_element_fixture_def.friction = 0.2f;
-
    _texture = TexturePool::getInstance().get("data/level-demo/tilesheets/catacombs-level-diffuse.png");
 
    // rope 1
@@ -54,75 +52,43 @@ Rope::Rope(GameNode* parent)
 
 void Rope::draw(sf::RenderTarget& color, sf::RenderTarget& /*normal*/)
 {
-   std::optional<b2Vec2> q1_prev;
-   std::optional<b2Vec2> q4_prev;
-
-   std::vector<sf::Vertex> quads;
+   static constexpr auto thickness_m = 0.025f;
 
-   for (auto i = 0u; i < _chain_elements.size() - 1; i++)
-   {
-      const auto c1 = _chain_elements[i];
-      const auto c2 = _chain_elements[i + 1];
+   const auto& positions = _simulation._positions;
+   const auto particle_count = positions.size();
 
-      const auto c1_pos_m = c1->GetPosition();
-      const auto c2_pos_m = c2->GetPosition();
+   // the whole rope is a single triangle strip with a vertex on either side of each particle
+   _vertices.resize(particle_count * 2);
 
-      static constexpr auto thickness_m = 0.025f;
+   for (auto i = 0u; i < particle_count; i++)
+   {
+      // take the direction from both neighbours so the segments join without gaps
+      const auto& prev_m = positions[i > 0 ? i - 1 : i];
+      const auto& next_m = positions[i < particle_count - 1 ? i + 1 : i];
 
-      const auto dist = (c2_pos_m - c1_pos_m);
+      const auto dist = (next_m - prev_m);
       auto normal = b2Vec2(dist.y, -dist.x);
       normal.Normalize();
 
-      const auto q1 = q1_prev.value_or(c1_pos_m - (thickness_m * normal));
-      const auto q2 = c2_pos_m - (thickness_m * normal);
-      const auto q3 = c2_pos_m + (thickness_m * normal);
-      const auto q4 = q4_prev.value_or(c1_pos_m + (thickness_m * normal));
-
-      q1_prev = q2;
-      q4_prev = q3;
+      const auto q1 = positions[i] - (thickness_m * normal);
+      const auto q2 = positions[i] + (thickness_m * normal);
 
-      auto u0 = static_cast<float>(i    ) / static_cast<float>(_segment_count);
-      auto u1 = static_cast<float>(i + 1) / static_cast<float>(_segment_count);
+      const auto v = _texture_rect_px.top + (static_cast<float>(i) / static_cast<float>(_segment_count)) * _texture_rect_px.height;
 
-      const auto v1 = sf::Vertex(
+      _vertices[i * 2] = sf::Vertex(
          sf::Vector2f(q1.x * PPM, q1.y * PPM),
-         sf::Vector2f(
-            static_cast<float>(_texture_rect_px.left),
-            static_cast<float>(_texture_rect_px.top + u0 * _texture_rect_px.height)
-         )
+         sf::Vector2f(static_cast<float>(_texture_rect_px.left), v)
       );
-      const auto v2 = sf::Vertex(
+
+      _vertices[i * 2 + 1] = sf::Vertex(
          sf::Vector2f(q2.x * PPM, q2.y * PPM),
-         sf::Vector2f(
-            static_cast<float>(_texture_rect_px.left),
-            static_cast<float>(_texture_rect_px.top + u1 * _texture_rect_px.height)
-         )
+         sf::Vector2f(static_cast<float>(_texture_rect_px.left + _texture_rect_px.width), v)
       );
-      const auto v3 = sf::Vertex(
-         sf::Vector2f(q3.x * PPM, q3.y * PPM),
-         sf::Vector2f(
-            static_cast<float>(_texture_rect_px.left + _texture_rect_px.width),
-            static_cast<float>(_texture_rect_px.top + u1 * _texture_rect_px.height)
-         )
-      );
-      const auto v4 = sf::Vertex(
-         sf::Vector2f(q4.x * PPM, q4.y * PPM),
-         sf::Vector2f(
-            static_cast<float>(_texture_rect_px.left + _texture_rect_px.width),
-            static_cast<float>(_texture_rect_px.top + u0 * _texture_rect_px.height)
-         )
-      );
-
-      quads.push_back(v1);
-      quads.push_back(v2);
-      quads.push_back(v3);
-      quads.push_back(v4);
    }
 
-   // render out those quads
    sf::RenderStates states;
    states.texture = _texture.get();
-   color.draw(quads.data(), quads.size(), sf::Quads, states);
+   color.draw(_vertices.data(), _vertices.size(), sf::TriangleStrip, states);
 }
 
 
@@ -135,29 +101,24 @@ void Rope::update(const sf::Time& dt)
       return;
    }
 
-   if (!_wind_enabled)
+   if (_wind_enabled)
    {
-      return;
-   }
-
-   // slightly push the rope all the way while it's moving from the right to the left
-   _push_time_s += dt.asSeconds();
+      // slightly push the rope all the way while it's moving from the right to the left
+      _push_time_s += dt.asSeconds();
 
-   if (_push_time_s > _push_interval_s)
-   {
-      auto f = _push_strength * dt.asSeconds();
+      if (_push_time_s > _push_interval_s)
+      {
+         auto f = _push_strength * dt.asSeconds();
+         _simulation.applyVelocity(b2Vec2{-f / segment_mass_kg, 0.0f});
+      }
 
-      auto last_element = _chain_elements.back();
-      for (auto element : _chain_elements)
+      if (_push_time_s > _push_interval_s + _push_duration_s)
       {
-         element->ApplyLinearImpulse(b2Vec2{-f, 0.0f}, last_element->GetWorldCenter(), true);
+         _push_time_s = 0.0f;
       }
    }
 
-   if (_push_time_s > _push_interval_s + _push_duration_s)
-   {
-      _push_time_s = 0.0f;
-   }
+   _simulation.step(dt.asSeconds());
 }
 
 
@@ -204,32 +165,21 @@ void Rope::setup(const GameDeserializeData& data)
 
    // pin the rope to the starting point (anchor)
    auto pos_m = b2Vec2{static_cast<float>(_position_px.x * MPP), static_cast<float>(_position_px.y * MPP)};
-   _anchor_a_body = data._world->CreateBody(&_anchor_a_def);
-   _anchor_a_shape.Set(b2Vec2(pos_m.x - 0.1f, pos_m.y), b2Vec2(pos_m.x + 0.1f, pos_m.y));
-   auto anchor_fixture =_anchor_a_body->CreateFixture(&_anchor_a_shape, 0.0f);
-   anchor_fixture->SetSensor(true);
+   _simulation.setup(pos_m, _segment_count, _segment_length_m, data._world->GetGravity());
+}
 
-   auto previous_body = _anchor_a_body;
 
-   for (auto i = 0; i < _segment_count; ++i)
-   {
-      // create chain element
-      b2BodyDef chain_body_def;
-      chain_body_def.type = b2_dynamicBody;
-      chain_body_def.position.Set(pos_m.x, pos_m.y + 0.01f + i * _segment_length_m);
-      auto chain_body = data._world->CreateBody(&chain_body_def);
-      auto chain_fixture = chain_body->CreateFixture(&_rope_element_fixture_def);
-      chain_fixture->SetSensor(true);
-
-      // attach chain element to the previous one
-      b2Vec2 anchor(pos_m.x, pos_m.y + i * _segment_length_m);
-      _joint_def.Initialize(previous_body, chain_body, anchor);
-      data._world->CreateJoint(&_joint_def);
-
-      // store chain elements
-      previous_body = chain_body;
-      _chain_elements.push_back(chain_body);
-   }
+std::optional<sf::FloatRect> Rope::getBoundingBoxPx()
+{
+   // the rope can swing all around its anchor, but never further than its length
+   const auto length_px = _segment_count * _segment_length_m * PPM;
+
+   return sf::FloatRect{
+      _position_px.x - length_px,
+      _position_px.y - length_px,
+      2.0f * length_px,
+      2.0f * length_px
+   };
 }
 
 
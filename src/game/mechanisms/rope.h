@@ -3,10 +3,12 @@
 #include "gamedeserializedata.h"
 #include "gamemechanism.h"
 #include "gamenode.h"
+#include "physics/ropesimulation.h"
 
 #include <Box2D/Box2D.h>
 
 #include <cstdint>
+#include <optional>
 
 
 class GameNode;
@@ -20,6 +22,7 @@ class Rope : public GameMechanism, public GameNode
 
       void draw(sf::RenderTarget& color, sf::RenderTarget& normal) override;
       void update(const sf::Time& dt) override;
+      std::optional<sf::FloatRect> getBoundingBoxPx() override;
 
       virtual void setup(const GameDeserializeData& data);
 
@@ -32,7 +35,7 @@ class Rope : public GameMechanism, public GameNode
       int32_t _segment_count = 7;
       float _segment_length_m = 0.01f;
 
-      std::vector<b2Body*> _chain_elements;
+      RopeSimulation _simulation;
       std::shared_ptr<sf::Texture> _texture;
 
 
@@ -40,17 +43,8 @@ class Rope : public GameMechanism, public GameNode
 
       sf::Vector2i _position_px;
 
-      // attachment of the 1st end of the rope
-      b2BodyDef _anchor_a_def;
-      b2Body* _anchor_a_body = nullptr;
-      b2EdgeShape _anchor_a_shape;
-
-      // rope
-      b2PolygonShape _rope_element_shape;
-      b2FixtureDef _rope_element_fixture_def;
-      b2RevoluteJointDef _joint_def;
-
       sf::IntRect _texture_rect_px;
+      std::vector<sf::Vertex> _vertices;
 
       // wind
       bool _wind_enabled = true;
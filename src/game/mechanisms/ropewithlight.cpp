@@ -39,11 +39,13 @@ void RopeWithLight::update(const sf::Time& dt)
 {
    Rope::update(dt);
 
-   _light->_pos_m = _chain_elements.back()->GetPosition();
+   const auto& positions = _simulation._positions;
+
+   _light->_pos_m = positions.back();
    _light->updateSpritePosition();
 
-   const auto c1_pos_m = _chain_elements[_chain_elements.size() - 2]->GetPosition();
-   const auto c2_pos_m = _chain_elements[_chain_elements.size() - 1]->GetPosition();
+   const auto c1_pos_m = positions[positions.size() - 2];
+   const auto c2_pos_m = positions[positions.size() - 1];
    const auto c_m = (c1_pos_m - c2_pos_m);
 
    const auto angle_rad = static_cast<float>(atan2(c_m.y, c_m.x));
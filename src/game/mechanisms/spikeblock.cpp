@@ -177,6 +177,12 @@ void SpikeBlock::update(const sf::Time& dt)
 }
 
 
+std::optional<sf::FloatRect> SpikeBlock::getBoundingBoxPx()
+{
+   return sf::FloatRect(_rectangle);
+}
+
+
 void SpikeBlock::setEnabled(bool enabled)
 {
    GameMechanism::setEnabled(enabled);
@@ -37,6 +37,7 @@ class SpikeBlock : public GameMechanism, public GameNode
 
       void draw(sf::RenderTarget& target, sf::RenderTarget& normal) override;
       void update(const sf::Time& dt) override;
+      std::optional<sf::FloatRect> getBoundingBoxPx() override;
       void setEnabled(bool enabled) override;
 
       const sf::IntRect& getPixelRect() const;
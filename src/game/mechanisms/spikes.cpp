@@ -261,6 +261,12 @@ void Spikes::update(const sf::Time& dt)
 }
 
 
+std::optional<sf::FloatRect> Spikes::getBoundingBoxPx()
+{
+   return sf::FloatRect(_pixel_rect);
+}
+
+
 std::vector<std::shared_ptr<Spikes>> Spikes::load(
    GameNode* parent,
    const GameDeserializeData& data,
@@ -37,6 +37,7 @@ public:
 
    void draw(sf::RenderTarget& color, sf::RenderTarget& normal) override;
    void update(const sf::Time& dt) override;
+   std::optional<sf::FloatRect> getBoundingBoxPx() override;
 
    static std::vector<std::shared_ptr<Spikes>> load(
       GameNode* parent,
@@ -9,7 +9,9 @@
 #include "worldquery.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <iostream>
 #include <ctime>
 
@@ -20,6 +22,7 @@ namespace
 static const auto max_age_s = 1.0f;            // time for raindrop to move through all screens
 static const auto randomize_factor_y = 0.02f;  // randomized to 0..2
 static const auto fixed_direction_y = 1000.0f;
+static const auto bucket_width_px = 32.0f;
 
 
 sf::Vector2f vecB2S(const b2Vec2 &vector)
@@ -27,42 +30,44 @@ sf::Vector2f vecB2S(const b2Vec2 &vector)
    return{vector.x * PPM, vector.y * PPM};
 }
 
-
-b2Vec2 vecS2B(const sf::Vector2f& vector)
-{
-   return{vector.x * MPP, vector.y * MPP};
 }
 
 
-std::vector<b2Body*> retrieveBodiesOnScreen(const std::shared_ptr<b2World>& world, const sf::FloatRect& screen)
+RainOverlay::RainOverlay()
+ : _texture(TexturePool::getInstance().get("data/sprites/rain.png"))
 {
-   b2AABB aabb;
+   std::srand(static_cast<uint32_t>(std::time(nullptr))); // use current time as seed for random generator
 
-   const auto l = screen.left;
-   const auto r = screen.left + screen.width;
-   const auto t = screen.top;
-   const auto b = screen.top + screen.height;
+   setSettings(_settings);
+}
 
-   aabb.upperBound = vecS2B({std::max(l, r), std::max(b, t)});
-   aabb.lowerBound = vecS2B({std::min(l, r), std::min(b, t)});
 
-   return WorldQuery::queryBodies(world, aabb);
+void RainOverlay::Drops::resize(size_t size)
+{
+   _pos_px.resize(size);
+   _velocity_px.resize(size);
+   _age_s.resize(size);
+   _collision_y_px.resize(size);
+   _sprite_index.resize(size);
 }
 
+
+void RainOverlay::Hits::resize(size_t size)
+{
+   _pos_px.resize(size);
+   _age_s.resize(size);
+   _head = 0;
+   _count = 0;
 }
 
 
-RainOverlay::RainOverlay()
- : _texture(TexturePool::getInstance().get("data/sprites/rain.png"))
+void RainOverlay::Hits::push(const sf::Vector2f& pos_px)
 {
-   std::srand(static_cast<uint32_t>(std::time(nullptr))); // use current time as seed for random generator
-
-   for (auto a = 0; a < _settings._drop_count; a++)
-   {
-      RainDrop drop;
-      drop._sprite.setTexture(*_texture);
-      _drops.push_back(drop);
-   }
+   // when full, the oldest hit is overwritten
+   _pos_px[_head] = pos_px;
+   _age_s[_head] = 0.0f;
+   _head = (_head + 1) % _pos_px.size();
+   _count = std::min(_count + 1, _pos_px.size());
 }
 
 
@@ -77,6 +82,11 @@ void RainOverlay::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
       screen_view.getSize().y
    };
 
+   if (_vertices.empty())
+   {
+      return;
+   }
+
    // source: foreground
    // dest:   background
 
@@ -89,22 +99,20 @@ void RainOverlay::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
          sf::BlendMode::Add               // alphaBlendEquation
    );
 
-   for (auto& d : _drops)
+   sf::RenderStates drop_states;
+   drop_states.texture = _texture.get();
+   drop_states.blendMode = blend_mode;
+
+   if (_drop_vertex_count > 0)
    {
-      if (d._age_s >= 0.0f)
-      {
-         // DebugDraw::drawLine(target, d._origin_px, d._pos_px + sf::Vector2f{0.0f, 96.0f}, {0, 0, 1});
-         target.draw(d._sprite, blend_mode);
-      }
+      target.draw(_vertices.data(), _drop_vertex_count, sf::Quads, drop_states);
    }
 
-   if (_settings._collide)
+   if (_vertices.size() > _drop_vertex_count)
    {
-      for (auto& hit : _hits)
-      {
-         // DebugDraw::drawPoint(target, hit._pos_px, {1, 0, 0});
-         target.draw(hit._sprite);
-      }
+      sf::RenderStates hit_states;
+      hit_states.texture = _texture.get();
+      target.draw(_vertices.data() + _drop_vertex_count, _vertices.size() - _drop_vertex_count, sf::Quads, hit_states);
    }
 }
 
@@ -130,29 +138,6 @@ void RainOverlay::update(const sf::Time& dt)
       return;
    }
 
-   // go through all edges and find the closest intersection; this way we know when the rain drop will hit the floor
-   auto update_colliding_edge = [this](RainDrop& p) {
-
-      p._intersections.clear();
-
-      for (const auto& edge : _edges)
-      {
-         auto intersection = SfmlMath::intersect(
-            p._origin_px,
-            p._pos_px + sf::Vector2f{0.0f, 1000.0f},
-            edge._p1_px,
-            edge._p2_px
-         );
-
-         if (intersection.has_value())
-         {
-            p._intersections.push_back(intersection.value().y);
-         }
-      }
-
-      std::sort(p._intersections.begin(), p._intersections.end());
-   };
-
    // set up the rain area like below:
    //
    //   +- - - - +----------------------+- - - - +
@@ -174,127 +159,189 @@ void RainOverlay::update(const sf::Time& dt)
    _clip_rect.height = _screen.height * 2;
    _clip_rect.width  = _screen.width * 2;
 
+   if (_settings._collide)
+   {
+      // only refresh the box2d information every 30 frames
+      if (!_surfaces_determined || _refresh_surface_counter == 30)
+      {
+         determineRainSurfaces();
+         _refresh_surface_counter = 0;
+      }
+
+      _refresh_surface_counter++;
+   }
+
+   const auto drop_count = _drops._pos_px.size();
+
    // initialize all drops if that hasn't been done yet
    if (!_initialized)
    {
-      for (auto& p : _drops)
+      for (auto i = 0u; i < drop_count; i++)
       {
-         const auto sprite_index = std::rand() % 4;
-
-         p._sprite.setTextureRect({static_cast<int32_t>(sprite_index) * 11, 0, 11, 96});
-         p._sprite.setOrigin(6, 0);
-         p._pos_px.x = _clip_rect.left + std::rand() % static_cast<int32_t>(_clip_rect.width);
-         p._pos_px.y = _clip_rect.top + std::rand() % static_cast<int32_t>(_clip_rect.height);
-         p._age_s = (std::rand() % (static_cast<int32_t>(max_age_s * 10000))) * 0.0001f;
-         p._dir_px.y = (std::rand() % 100) * randomize_factor_y + fixed_direction_y;
-         update_colliding_edge(p);
+         _drops._sprite_index[i] = static_cast<uint8_t>(std::rand() % 4);
+         _drops._pos_px[i].x = _clip_rect.left + std::rand() % static_cast<int32_t>(_clip_rect.width);
+         _drops._pos_px[i].y = _clip_rect.top + std::rand() % static_cast<int32_t>(_clip_rect.height);
+         _drops._age_s[i] = (std::rand() % (static_cast<int32_t>(max_age_s * 10000))) * 0.0001f;
+         _drops._velocity_px[i] = (std::rand() % 100) * randomize_factor_y + fixed_direction_y;
+         updateCollision(i);
       }
 
       _initialized = true;
    }
 
-   auto fallthrough_index = 0;
-   for (auto& p : _drops)
+   const auto dt_s = dt.asSeconds();
+
+   for (auto i = 0u; i < drop_count; i++)
    {
-      p._age_s += dt.asSeconds();
+      auto& age_s = _drops._age_s[i];
+      age_s += dt_s;
 
-      if (p._age_s > 0.0f)
+      if (age_s <= 0.0f)
       {
-         const auto step_width_px = p._dir_px * dt.asSeconds();
-         p._pos_px += step_width_px;
-         p._sprite.setPosition(p._pos_px);
-
-         if (p._age_s > max_age_s)
-         {
-            p.reset(_clip_rect);
-            update_colliding_edge(p);
-         }
-         else
-         {
-            if (_settings._fall_through_rate == 0 || (fallthrough_index % _settings._fall_through_rate) == 0)
-            {
-               // intersect rain drop with edges
-               if (!p._intersections.empty())
-               {
-                  const auto& closest_point = p._intersections.front();
+         continue;
+      }
 
-                  if (p._pos_px.y + 96 > p._intersections.at(0))
-                  {
-                     const sf::Vector2f hit_position{p._pos_px.x, closest_point};
+      auto& pos_px = _drops._pos_px[i];
+      pos_px.y += _drops._velocity_px[i] * dt_s;
 
-                     DropHit hit;
-                     hit._sprite.setTexture(*_texture);
-                     hit._sprite.setPosition(hit_position);
-                     hit._pos_px = hit_position;
-                     _hits.push_back(hit);
+      if (age_s > max_age_s)
+      {
+         resetDrop(i);
+         continue;
+      }
 
-                     p.reset(_clip_rect);
+      if (_settings._fall_through_rate != 0 && (i % _settings._fall_through_rate) != 0)
+      {
+         continue;
+      }
 
-                     update_colliding_edge(p);
-                  }
-               }
-            }
+      // the drop hits the closest surface below its origin
+      const auto collision_y_px = _drops._collision_y_px[i];
+      if (pos_px.y + 96 > collision_y_px)
+      {
+         if (_settings._collide)
+         {
+            _hits.push({pos_px.x, collision_y_px});
          }
+
+         resetDrop(i);
       }
+   }
 
-      fallthrough_index++;
+   // age hits and drop those that are too old from the tail
+   const auto hit_capacity = _hits._pos_px.size();
+   for (auto i = 0u; i < _hits._count; i++)
+   {
+      _hits._age_s[(_hits._head + hit_capacity - 1 - i) % hit_capacity] += dt_s;
    }
 
-   if (_settings._collide)
+   while (_hits._count > 0 && _hits._age_s[(_hits._head + hit_capacity - _hits._count) % hit_capacity] > 1.0f)
    {
-      // only refresh the box2d information every 30 frames
-      if (_edges.empty() || _refresh_surface_counter == 30)
+      _hits._count--;
+   }
+
+   updateVertices();
+}
+
+
+void RainOverlay::updateVertices()
+{
+   _vertices.clear();
+
+   const auto add_quad = [this](float left, float top, const sf::IntRect& rect) {
+      const auto right = left + rect.width;
+      const auto bottom = top + rect.height;
+      const auto u0 = static_cast<float>(rect.left);
+      const auto v0 = static_cast<float>(rect.top);
+      const auto u1 = static_cast<float>(rect.left + rect.width);
+      const auto v1 = static_cast<float>(rect.top + rect.height);
+
+      _vertices.emplace_back(sf::Vector2f{left, top}, sf::Vector2f{u0, v0});
+      _vertices.emplace_back(sf::Vector2f{right, top}, sf::Vector2f{u1, v0});
+      _vertices.emplace_back(sf::Vector2f{right, bottom}, sf::Vector2f{u1, v1});
+      _vertices.emplace_back(sf::Vector2f{left, bottom}, sf::Vector2f{u0, v1});
+   };
+
+   // drops: 11x96 texture rects with their origin at (6, 0)
+   for (auto i = 0u; i < _drops._pos_px.size(); i++)
+   {
+      if (_drops._age_s[i] < 0.0f)
       {
-         determineRainSurfaces();
-         _refresh_surface_counter = 0;
+         continue;
       }
 
-      _refresh_surface_counter++;
+      const auto& pos_px = _drops._pos_px[i];
+      add_quad(pos_px.x - 6.0f, pos_px.y, {_drops._sprite_index[i] * 11, 0, 11, 96});
+   }
 
-      // update hit and erase those that are too old
-      _hits.erase(
-         std::remove_if(
-            _hits.begin(),
-            _hits.end(),
-            [dt](auto& hit) {
-               hit._age_s +=  dt.asSeconds();
-               hit._sprite.setOrigin(5, 11);
-               hit._sprite.setTextureRect({
-                     11 * std::min(3, static_cast<int32_t>(hit._age_s * 10.0f)),
-                     96,
-                     11,
-                     12
-                  }
-               );
-               return hit._age_s > 1.0f;
-            }
-         ),
-         _hits.end()
-      );
+   _drop_vertex_count = _vertices.size();
+
+   // hits: 11x12 texture rects animated over their age with their origin at (5, 11)
+   const auto hit_capacity = _hits._pos_px.size();
+   for (auto i = 0u; i < _hits._count; i++)
+   {
+      const auto index = (_hits._head + hit_capacity - 1 - i) % hit_capacity;
+      const auto& pos_px = _hits._pos_px[index];
+      const auto frame = std::min(3, static_cast<int32_t>(_hits._age_s[index] * 10.0f));
+      add_quad(pos_px.x - 5.0f, pos_px.y - 11.0f, {11 * frame, 96, 11, 12});
    }
 }
 
 
-void RainOverlay::RainDrop::reset(const sf::FloatRect& rect)
+void RainOverlay::resetDrop(size_t index)
 {
-   _age_s = - (std::rand() % 10000) * 0.0001f;
+   _drops._age_s[index] = - (std::rand() % 10000) * 0.0001f;
 
-   const auto x = std::rand() % static_cast<int32_t>(rect.width);
+   const auto x = std::rand() % static_cast<int32_t>(_clip_rect.width);
 
-   _pos_px.x = static_cast<float>(rect.left + x);
-   _pos_px.y = rect.top;
+   _drops._pos_px[index].x = static_cast<float>(_clip_rect.left + x);
+   _drops._pos_px[index].y = _clip_rect.top;
 
-   _origin_px = _pos_px;
+   updateCollision(index);
+}
+
+
+void RainOverlay::updateCollision(size_t index)
+{
+   // drops fall straight down, so only the edges in the drop's column need to be checked
+   // for the closest intersection within the next 1000px; this way we know when the rain drop will hit the floor
+   const auto& pos_px = _drops._pos_px[index];
+   auto collision_y_px = std::numeric_limits<float>::max();
+
+   const auto bucket = static_cast<int32_t>(std::floor((pos_px.x - _bucket_left_px) / bucket_width_px));
+   if (bucket >= 0 && bucket + 1 < static_cast<int32_t>(_bucket_offsets.size()))
+   {
+      for (auto i = _bucket_offsets[bucket]; i < _bucket_offsets[bucket + 1]; i++)
+      {
+         const auto& edge = _edges[_bucket_edges[i]];
+
+         const auto intersection = SfmlMath::intersect(
+            pos_px,
+            pos_px + sf::Vector2f{0.0f, 1000.0f},
+            edge._p1_px,
+            edge._p2_px
+         );
+
+         if (intersection.has_value())
+         {
+            collision_y_px = std::min(collision_y_px, intersection.value().y);
+         }
+      }
+   }
+
+   _drops._collision_y_px[index] = collision_y_px;
 }
 
 
 void RainOverlay::determineRainSurfaces()
 {
+   _surfaces_determined = true;
    _edges.clear();
 
    auto level = Level::getCurrentLevel();
 
-   std::vector<b2Body*> bodies = retrieveBodiesOnScreen(level->getWorld(), _screen);
+   // the debug draw asks for the same bodies, so the query result is shared
+   const auto& bodies = WorldQuery::retrieveBodiesOnScreen(level->getWorld(), _screen);
 
    for (auto body : bodies)
    {
@@ -345,10 +392,69 @@ void RainOverlay::determineRainSurfaces()
          }
       }
    }
+
+   // put the edges into columns by their x range
+   _bucket_offsets.clear();
+   _bucket_edges.clear();
+
+   if (_edges.empty())
+   {
+      return;
+   }
+
+   auto left_px = std::numeric_limits<float>::max();
+   auto right_px = std::numeric_limits<float>::lowest();
+   for (const auto& edge : _edges)
+   {
+      left_px = std::min({left_px, edge._p1_px.x, edge._p2_px.x});
+      right_px = std::max({right_px, edge._p1_px.x, edge._p2_px.x});
+   }
+
+   _bucket_left_px = left_px;
+   const auto bucket_count = static_cast<int32_t>((right_px - left_px) / bucket_width_px) + 1;
+
+   const auto bucket_range = [&](const Edge& edge) {
+      const auto first = static_cast<int32_t>((std::min(edge._p1_px.x, edge._p2_px.x) - left_px) / bucket_width_px);
+      const auto last = static_cast<int32_t>((std::max(edge._p1_px.x, edge._p2_px.x) - left_px) / bucket_width_px);
+      return std::make_pair(first, std::min(last, bucket_count - 1));
+   };
+
+   // count, prefix sum, then fill
+   _bucket_offsets.resize(bucket_count + 1, 0);
+   for (const auto& edge : _edges)
+   {
+      const auto [first, last] = bucket_range(edge);
+      for (auto bucket = first; bucket <= last; bucket++)
+      {
+         _bucket_offsets[bucket + 1]++;
+      }
+   }
+
+   for (auto bucket = 0; bucket < bucket_count; bucket++)
+   {
+      _bucket_offsets[bucket + 1] += _bucket_offsets[bucket];
+   }
+
+   _bucket_edges.resize(_bucket_offsets.back());
+   auto fill = _bucket_offsets;
+   for (auto edge_index = 0u; edge_index < _edges.size(); edge_index++)
+   {
+      const auto [first, last] = bucket_range(_edges[edge_index]);
+      for (auto bucket = first; bucket <= last; bucket++)
+      {
+         _bucket_edges[fill[bucket]++] = static_cast<int32_t>(edge_index);
+      }
+   }
 }
 
 
 void RainOverlay::setSettings(const RainSettings& settings)
 {
    _settings = settings;
+
+   // hits live for a second and drops take about as long to respawn, two hits per drop leave plenty of room
+   _drops.resize(static_cast<size_t>(std::max(_settings._drop_count, 0)));
+   _hits.resize(std::max<size_t>(_drops._pos_px.size() * 2, 1));
+   _vertices.reserve((_drops._pos_px.size() + _hits._pos_px.size()) * 4);
+   _initialized = false;
 }
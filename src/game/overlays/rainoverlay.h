@@ -4,7 +4,6 @@
 
 #include <cstdint>
 #include <memory>
-#include <optional>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
@@ -22,26 +21,6 @@ public:
       int32_t _fall_through_rate = 0;
    };
 
-   struct RainDrop
-   {
-      void reset(const sf::FloatRect& rect);
-
-      sf::Vector2f _origin_px;
-      sf::Vector2f _pos_px;
-      sf::Vector2f _dir_px;
-      float _length = 0.0f;
-      float _age_s = 0.0f;
-      sf::Sprite _sprite;
-      std::vector<float> _intersections;
-   };
-
-   struct DropHit
-   {
-      sf::Vector2f _pos_px;
-      float _age_s = 0.0f;
-      sf::Sprite _sprite;
-   };
-
    struct Edge
    {
       sf::Vector2f _p1_px;
@@ -58,20 +37,55 @@ public:
 
 private:
 
+   // structure of arrays, sized to the drop count once
+   struct Drops
+   {
+      void resize(size_t size);
+
+      std::vector<sf::Vector2f> _pos_px;
+      std::vector<float> _velocity_px;
+      std::vector<float> _age_s;
+      std::vector<float> _collision_y_px; // closest surface below the drop, infinity if there is none
+      std::vector<uint8_t> _sprite_index;
+   };
+
+   // ring buffer of drop hits; all hits age at the same rate so the oldest is always at the tail
+   struct Hits
+   {
+      void resize(size_t size);
+      void push(const sf::Vector2f& pos_px);
+
+      std::vector<sf::Vector2f> _pos_px;
+      std::vector<float> _age_s;
+      size_t _head = 0;
+      size_t _count = 0;
+   };
+
+   void resetDrop(size_t index);
+   void updateCollision(size_t index);
+   void updateVertices();
    void determineRainSurfaces();
 
    bool _initialized = false;
+   bool _surfaces_determined = false;
    uint8_t _refresh_surface_counter = 0;
 
    sf::FloatRect _screen;
    sf::FloatRect _clip_rect;
 
-   std::vector<RainDrop> _drops;
+   Drops _drops;
+   Hits _hits;
    std::shared_ptr<sf::Texture> _texture;
+
+   // collision edges, bucketed into columns so a drop only tests the edges above or below it
    std::vector<Edge> _edges;
+   std::vector<int32_t> _bucket_offsets;
+   std::vector<int32_t> _bucket_edges;
+   float _bucket_left_px = 0.0f;
 
-   std::vector<DropHit> _hits;
+   // drops first, then hits
+   std::vector<sf::Vertex> _vertices;
+   size_t _drop_vertex_count = 0;
 
    RainSettings _settings;
 };
-
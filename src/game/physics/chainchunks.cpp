@@ -0,0 +1,67 @@
+#include "chainchunks.h"
+
+#include <cmath>
+#include <utility>
+
+
+std::vector<ChainChunks::Chunk> ChainChunks::split(const std::vector<b2Vec2>& loop, float chunk_size_m)
+{
+   std::vector<Chunk> chunks;
+
+   const auto count = static_cast<int32_t>(loop.size());
+   if (chunk_size_m <= 0.0f || count < 3)
+   {
+      return chunks;
+   }
+
+   // edge i goes from vertex i to vertex i + 1, the last edge closes the loop
+   std::vector<std::pair<int32_t, int32_t>> cells(count);
+   for (auto i = 0; i < count; i++)
+   {
+      const auto center = 0.5f * (loop[i] + loop[(i + 1) % count]);
+      cells[i] = {static_cast<int32_t>(std::floor(center.x / chunk_size_m)), static_cast<int32_t>(std::floor(center.y / chunk_size_m))};
+   }
+
+   // start at an edge that enters a new cell so no chunk wraps around the end of the loop
+   auto start = -1;
+   for (auto i = 0; i < count; i++)
+   {
+      if (cells[i] != cells[(i + count - 1) % count])
+      {
+         start = i;
+         break;
+      }
+   }
+
+   if (start == -1)
+   {
+      return chunks;
+   }
+
+   auto edge = 0;
+   while (edge < count)
+   {
+      const auto first = (start + edge) % count;
+
+      auto edge_count = 1;
+      while (edge + edge_count < count && cells[(first + edge_count) % count] == cells[first])
+      {
+         edge_count++;
+      }
+
+      Chunk chunk;
+      chunk._offset = first;
+      chunk._prev_vertex = loop[(first + count - 1) % count];
+      chunk._next_vertex = loop[(first + edge_count + 1) % count];
+
+      for (auto i = 0; i <= edge_count; i++)
+      {
+         chunk._vertices.push_back(loop[(first + i) % count]);
+      }
+
+      chunks.push_back(std::move(chunk));
+      edge += edge_count;
+   }
+
+   return chunks;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Box2D/Box2D.h"
+
+#include <cstdint>
+#include <vector>
+
+/*! \brief Splits closed level outlines into grid aligned chunks
+ *
+ *  Every edge of a loop is assigned to the grid cell its center is in. Consecutive edges within the same cell form a
+ *  chunk, which becomes an open box2d chain. The vertices before and after a chunk are kept as ghost vertices, so
+ *  bodies sliding across a chunk border collide exactly as they would with the whole loop.
+ */
+namespace ChainChunks
+{
+
+struct Chunk
+{
+   std::vector<b2Vec2> _vertices;
+   b2Vec2 _prev_vertex;
+   b2Vec2 _next_vertex;
+   int32_t _offset = 0; // index of the first vertex within the loop
+};
+
+// returns no chunks if the loop fits into a single cell or chunking is disabled
+std::vector<Chunk> split(const std::vector<b2Vec2>& loop, float chunk_size_m);
+
+}
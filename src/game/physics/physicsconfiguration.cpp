@@ -18,6 +18,8 @@ std::string PhysicsConfiguration::serialize()
        {
           {"timestep", _time_step},
           {"gravity", _gravity},
+          {"solver_thread_count", _solver_thread_count},
+          {"chain_chunk_size_tiles", _chain_chunk_size_tiles},
 
           {"player_speed_max_air", _player_speed_max_air},
           {"player_speed_max_walk", _player_speed_max_walk},
@@ -85,6 +87,16 @@ void PhysicsConfiguration::deserialize(const std::string& data)
    _time_step = config["PhysicsConfiguration"]["timestep"].get<float>();
    _gravity = config["PhysicsConfiguration"]["gravity"].get<float>();
 
+   if (config["PhysicsConfiguration"].count("solver_thread_count") > 0)
+   {
+      _solver_thread_count = config["PhysicsConfiguration"]["solver_thread_count"].get<int32_t>();
+   }
+
+   if (config["PhysicsConfiguration"].count("chain_chunk_size_tiles") > 0)
+   {
+      _chain_chunk_size_tiles = config["PhysicsConfiguration"]["chain_chunk_size_tiles"].get<int32_t>();
+   }
+
    _player_speed_max_walk = config["PhysicsConfiguration"]["player_speed_max_walk"].get<float>();
    _player_speed_max_run = config["PhysicsConfiguration"]["player_speed_max_run"].get<float>();
    _player_speed_max_water = config["PhysicsConfiguration"]["player_speed_max_water"].get<float>();
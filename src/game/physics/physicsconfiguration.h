@@ -8,7 +8,10 @@ struct PhysicsConfiguration
    PhysicsConfiguration() = default;
 
    float _time_step = 1.0f/60.0f;
+   int32_t _max_time_steps_per_frame = 5;        // not in json
    float _gravity = 8.5f;
+   int32_t _solver_thread_count = 1;             // islands are solved in parallel with more than 1 thread, 0 uses all cores
+   int32_t _chain_chunk_size_tiles = 32;         // static level chains are split into chunks of this size, 0 keeps them whole
 
    float _player_speed_max_walk = 2.5f;
    float _player_speed_max_run = 3.5f;
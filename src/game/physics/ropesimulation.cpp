@@ -0,0 +1,78 @@
+#include "ropesimulation.h"
+
+
+void RopeSimulation::setup(const b2Vec2& anchor_m, int32_t segment_count, float segment_length_m, const b2Vec2& gravity)
+{
+   _gravity = gravity;
+   _segment_length_m = segment_length_m;
+
+   // the rope starts hanging straight down from its anchor
+   const auto particle_count = static_cast<size_t>(segment_count + 1);
+   _positions.resize(particle_count);
+   _predicted_positions.resize(particle_count);
+   _velocities.assign(particle_count, b2Vec2{0.0f, 0.0f});
+
+   for (auto i = 0u; i < particle_count; i++)
+   {
+      _positions[i] = anchor_m + b2Vec2{0.0f, i * segment_length_m};
+   }
+}
+
+
+void RopeSimulation::step(float dt)
+{
+   if (_positions.size() < 2 || dt <= 0.0f)
+   {
+      return;
+   }
+
+   const auto particle_count = _positions.size();
+
+   _predicted_positions[0] = _positions[0];
+
+   for (auto i = 1u; i < particle_count; i++)
+   {
+      _velocities[i] += dt * _gravity;
+      _predicted_positions[i] = _positions[i] + dt * _velocities[i];
+   }
+
+   // project the distance constraints, the anchor has no inverse mass so only its neighbour is moved
+   for (auto iteration = 0; iteration < _iterations; iteration++)
+   {
+      for (auto i = 0u; i < particle_count - 1; i++)
+      {
+         auto& a = _predicted_positions[i];
+         auto& b = _predicted_positions[i + 1];
+
+         auto delta = b - a;
+         const auto length = delta.Normalize();
+         const auto error = length - _segment_length_m;
+
+         if (i == 0)
+         {
+            b -= error * delta;
+         }
+         else
+         {
+            a += 0.5f * error * delta;
+            b -= 0.5f * error * delta;
+         }
+      }
+   }
+
+   const auto inv_dt = 1.0f / dt;
+   for (auto i = 1u; i < particle_count; i++)
+   {
+      _velocities[i] = inv_dt * (_predicted_positions[i] - _positions[i]);
+      _positions[i] = _predicted_positions[i];
+   }
+}
+
+
+void RopeSimulation::applyVelocity(const b2Vec2& velocity)
+{
+   for (auto i = 1u; i < _velocities.size(); i++)
+   {
+      _velocities[i] += velocity;
+   }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Box2D/Box2D.h"
+
+#include <cstdint>
+#include <vector>
+
+/*! \brief Position based simulation of a rope pinned to an anchor
+ *
+ *  The rope is a row of particles kept apart by distance constraints, the first particle is the anchor and never
+ *  moves. It is much cheaper than a box2d body and joint per segment and doesn't add anything to the world's island
+ *  solver, which is fine as long as the rope doesn't need to collide with anything.
+ */
+struct RopeSimulation
+{
+   void setup(const b2Vec2& anchor_m, int32_t segment_count, float segment_length_m, const b2Vec2& gravity);
+   void step(float dt);
+   void applyVelocity(const b2Vec2& velocity);
+
+   std::vector<b2Vec2> _positions;
+   std::vector<b2Vec2> _predicted_positions;
+   std::vector<b2Vec2> _velocities;
+
+   b2Vec2 _gravity{0.0f, 0.0f};
+   float _segment_length_m = 0.0f;
+   int32_t _iterations = 8;
+};
@@ -7,6 +7,7 @@
 #include "chainshapeanalyzer.h"
 #include "displaymode.h"
 #include "fadetransitioneffect.h"
+#include "fixedtimestep.h"
 #include "fixturenode.h"
 #include "framework/joystick/gamecontroller.h"
 #include "framework/tools/globalclock.h"
@@ -46,6 +47,33 @@ static constexpr auto impulse_epsilon = 0.0000001f;
 static constexpr auto wall_slide_sensor_width = 8.0f;
 static constexpr auto wall_slide_sensor_height = 0.75f;
 static constexpr auto wall_slide_sensor_distance = 0.21f;
+
+// finds the closest chain edge of the ground body along a ray
+class GroundRayCastCallback : public b2RayCastCallback
+{
+   public:
+
+      GroundRayCastCallback(b2Body* ground_body)
+       : _ground_body(ground_body)
+      {
+      }
+
+      float32 ReportFixture(b2Fixture* fixture, const b2Vec2& /*point*/, const b2Vec2& normal, float32 fraction) override
+      {
+         // terrain is made out of chains, so only process those
+         if (fixture->GetBody() != _ground_body || fixture->GetShape()->GetType() != b2Shape::e_chain)
+         {
+            return -1.0f;
+         }
+
+         // clip the ray so only closer hits are reported from here on
+         _normal = normal;
+         return fraction;
+      }
+
+      b2Body* _ground_body = nullptr;
+      b2Vec2 _normal{0.0f, -1.0f};
+};
 }  // namespace
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -204,6 +232,9 @@ void Player::setBodyViaPixelPosition(float x, float y)
 {
    setPixelPosition(x, y);
 
+   // teleports must not be interpolated
+   _pixel_position_previous_f = _pixel_position_f;
+
    if (_body)
    {
       _body->SetTransform(b2Vec2(x * MPP, y * MPP), 0.0f);
@@ -246,7 +277,7 @@ void Player::draw(sf::RenderTarget& color, sf::RenderTarget& normal)
    }
 
    // that y offset is to compensate the wonky box2d origin
-   const auto draw_position_px = _pixel_position_f + sf::Vector2f(0, 8);
+   const auto draw_position_px = FixedTimeStep::interpolate(_pixel_position_previous_f, _pixel_position_f) + sf::Vector2f(0, 8);
 
    auto current_cycle = _player_animation.getCurrentCycle();
    if (current_cycle)
@@ -377,7 +408,7 @@ void Player::createFeet()
 
       auto object_data_feet = new FixtureNode(this);
       object_data_feet->setType(ObjectTypePlayer);
-      object_data_feet->setFlag("foot", true);
+      object_data_feet->setFlag(FixtureNode::Flag::Foot, true);
       foot->SetUserData(static_cast<void*>(object_data_feet));
    }
 
@@ -480,7 +511,7 @@ void Player::createBody()
 
    auto object_data_head = new FixtureNode(this);
    object_data_head->setType(ObjectTypePlayer);
-   object_data_head->setFlag("head", true);
+   object_data_head->setFlag(FixtureNode::Flag::Head, true);
    _body_fixture->SetUserData(static_cast<void*>(object_data_head));
 
    // mBody->Dump();
@@ -1331,46 +1362,17 @@ void Player::updateGroundAngle()
       return;
    }
 
-   // raycast down to determine terrain slope
-   b2RayCastInput input;
-   input.p1 = _body->GetPosition();
-   input.p2 = _body->GetPosition() + b2Vec2(0.0f, 1.0f);
-   input.maxFraction = 1.0f;
-
-   float closest_fraction = 1.0f;
-   b2Vec2 intersection_normal(0.0f, -1.0f);
-
    if (!_ground_body)
    {
       _ground_normal.Set(0.0f, -1.0f);
       return;
    }
 
-   for (auto f = _ground_body->GetFixtureList(); f; f = f->GetNext())
-   {
-      // terrain is made out of chains, so only process those
-      if (f->GetShape()->GetType() != b2Shape::e_chain)
-      {
-         continue;
-      }
-
-      b2RayCastOutput output;
-      for (auto child_index = 0; child_index < f->GetShape()->GetChildCount(); child_index++)
-      {
-         if (!f->RayCast(&output, input, child_index))
-         {
-            continue;
-         }
-
-         if (output.fraction < closest_fraction)
-         {
-            closest_fraction = output.fraction;
-            intersection_normal = output.normal;
-         }
-      }
-   }
+   // raycast down to determine terrain slope, the broadphase only hands over the chain edges below the player
+   GroundRayCastCallback ray_cast_callback(_ground_body);
+   _body->GetWorld()->RayCast(&ray_cast_callback, _body->GetPosition(), _body->GetPosition() + b2Vec2(0.0f, 1.0f));
 
-   _ground_normal = intersection_normal;
+   _ground_normal = ray_cast_callback._normal;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1443,6 +1445,7 @@ void Player::updateWaterBubbles(const sf::Time& dt)
 void Player::update(const sf::Time& dt)
 {
    _time += dt;
+   _pixel_position_previous_f = _pixel_position_f;
 
    updateChainShapeCollisions();
    updateImpulse();
@@ -1868,6 +1871,7 @@ DeathReason Player::checkDead() const
 void Player::setStartPixelPosition(float x, float y)
 {
    setPixelPosition(x, y);
+   _pixel_position_previous_f = _pixel_position_f;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
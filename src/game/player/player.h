@@ -186,6 +186,7 @@ private:
    float _impulse = 0.0f;
 
    sf::Vector2f _pixel_position_f;
+   sf::Vector2f _pixel_position_previous_f;
    sf::Vector2i _pixel_position_i;
    sf::FloatRect _pixel_rect_f;
    sf::IntRect _pixel_rect_i;
@@ -1,29 +1,9 @@
 #include "playerclimb.h"
 
 #include "audio.h"
+#include "level.h"
 #include "savestate.h"
-
-namespace
-{
-
-class PlayerAABBQueryCallback : public b2QueryCallback
-{
-   public:
-      std::set<b2Body*> _bodies;
-
-   public:
-      bool ReportFixture(b2Fixture* fixture)
-      {
-         // foundBodies.push_back(fixture->GetBody());
-         _bodies.insert(fixture->GetBody());
-
-         // keep going to find all fixtures in the query area
-         return true;
-      }
-};
-
-}
-
+#include "worldquery.h"
 
 //----------------------------------------------------------------------------------------------------------------------
 void PlayerClimb::update(b2Body* player_body, bool in_air)
@@ -93,9 +73,6 @@ void PlayerClimb::update(b2Body* player_body, bool in_air)
    //   aabb.lowerBound = lower;
    //   aabb.upperBound = upper;
 
-   // query nearby region
-   PlayerAABBQueryCallback queryCallback;
-
 
    // player aabb is: 19.504843, 158.254532 to 19.824877 158.966980
    // x: 0.320034 * 0.5 -> 0.1600171
@@ -119,117 +96,115 @@ void PlayerClimb::update(b2Body* player_body, bool in_air)
 
    // printf("player aabb is: %f, %f to %f %f\n", aabb.lowerBound.x, aabb.lowerBound.y, aabb.upperBound.x, aabb.upperBound.y);
 
-   player_body->GetWorld()->QueryAABB(&queryCallback, aabb);
-
-   // std::remove_if(queryCallback.foundBodies.begin(), queryCallback.foundBodies.end(), [this](b2Body* body){return body == mBody;});
-   queryCallback._bodies.erase(player_body);
+   // query nearby region
+   const auto level = Level::getCurrentLevel();
+   const auto& bodies = WorldQuery::queryBodiesCached(level->getWorld(), aabb);
 
    // printf("bodies in range:\n");
-   for (auto body : queryCallback._bodies)
+   for (auto body : bodies)
    {
-      if (body->GetType() == b2_staticBody)
+      if (body != player_body && body->GetType() == b2_staticBody)
       {
          // printf("- static body: %p\n", body);
 
+         // a large outline is made of several chain fixtures, the closest vertex across all of them is used
          auto found = false;
          auto dist_max = 0.16f;
-         auto fixture = body->GetFixtureList();
+         auto edge_length_minimum = 1000.0f;
+         b2Vec2 closest;
 
-         while (fixture)
+         for (auto fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
          {
             auto shape = dynamic_cast<b2ChainShape*>(fixture->GetShape());
+            const auto chunk = level->getWorldChainChunk(fixture);
+
+            if (!shape || !chunk)
+            {
+               continue;
+            }
 
-            if (shape)
+            const auto& chain = level->getWorldChains()[chunk->_chain_index];
+
+            for (auto index = 0; index < shape->m_count; index++)
             {
-               b2Vec2 closest;
+               auto curr = shape->m_vertices[index];
+               auto edge_length_squared = (aabb.GetCenter() - curr).LengthSquared();
 
-               auto edge_length_minimum = 1000.0f;
-               for (auto index = 0; index < shape->m_count; index++)
+               if (edge_length_squared >= dist_max)
                {
-                  auto curr = shape->m_vertices[index];
-                  auto edge_length_squared = (aabb.GetCenter() - curr).LengthSquared();
-
-                  if (edge_length_squared >= dist_max)
-                  {
-                     continue;
-                  }
-
-                  // does player point to edge direction?
-                  if (!edgeMatchesMovement(aabb.GetCenter() - curr))
-                  {
-                     continue;
-                  }
-
-                  // joint in spe needs to point up, since we're holding somewhere4
-                  auto joint_dir = (aabb.GetCenter() - curr);
-                  if  (joint_dir.y <= 0.0f)
-                  {
-                     continue;
-                  }
-
-                  // is the analyzed edge actually climbable?
-                  if (!isClimbableEdge(shape, index))
-                  {
-                     continue;
-                  }
-
-                  // printf("joint dir: %f \n", jointDir.y);
-
-                  // if all that is the case, we have a joint
-                  if (edge_length_squared < edge_length_minimum)
-                  {
-                     edge_length_minimum = edge_length_squared;
-                     closest = curr;
-                     found = true;
-                  }
+                  continue;
                }
 
-               // printf("    - closest vtx: %f, %f, distance: %f\n", closest.x, closest.y, distMin);
-
-               // situation a)
-               //
-               //    v
-               //    +------+ prev/next, same y, greater x
-               //    |
-               //    |
-               //    +
-               //  prev/next
-               //
-               //  same x, greater y
-               //
-               //
-               // situation b)
-               //                                        v
-               //    prev/next, same y, smaller x +------+
-               //                                        |
-               //                                        |
-               //                                        +
-               //                                      prev/next
-               //
-               //                                      same x, greater y
-               //
-               //
-               // prev or current needs to have greater y
-               // other vertex must have different x
-
-               if (found)
+               // does player point to edge direction?
+               if (!edgeMatchesMovement(aabb.GetCenter() - curr))
                {
-                  b2DistanceJointDef joint_def;
-                  joint_def.Initialize(player_body, body, aabb.GetCenter(), closest);
-                  joint_def.collideConnected = true;
-                  // jointDefinition.dampingRatio = 0.5f;
-                  // jointDefinition.frequencyHz = 5.0f;
-                  // jointDefinition.length = 0.01f;
-
-                  Audio::getInstance().playSample("impact.wav");
-                  _climb_joint = player_body->GetWorld()->CreateJoint(&joint_def);
+                  continue;
                }
 
-               // no need to continue processing
-               break;
+               // joint in spe needs to point up, since we're holding somewhere4
+               auto joint_dir = (aabb.GetCenter() - curr);
+               if  (joint_dir.y <= 0.0f)
+               {
+                  continue;
+               }
+
+               // is the analyzed edge actually climbable?
+               if (!isClimbableEdge(chain, (chunk->_offset + index) % static_cast<int32_t>(chain.size())))
+               {
+                  continue;
+               }
+
+               // printf("joint dir: %f \n", jointDir.y);
+
+               // if all that is the case, we have a joint
+               if (edge_length_squared < edge_length_minimum)
+               {
+                  edge_length_minimum = edge_length_squared;
+                  closest = curr;
+                  found = true;
+               }
             }
+         }
 
-            fixture = fixture->GetNext();
+         // printf("    - closest vtx: %f, %f, distance: %f\n", closest.x, closest.y, distMin);
+
+         // situation a)
+         //
+         //    v
+         //    +------+ prev/next, same y, greater x
+         //    |
+         //    |
+         //    +
+         //  prev/next
+         //
+         //  same x, greater y
+         //
+         //
+         // situation b)
+         //                                        v
+         //    prev/next, same y, smaller x +------+
+         //                                        |
+         //                                        |
+         //                                        +
+         //                                      prev/next
+         //
+         //                                      same x, greater y
+         //
+         //
+         // prev or current needs to have greater y
+         // other vertex must have different x
+
+         if (found)
+         {
+            b2DistanceJointDef joint_def;
+            joint_def.Initialize(player_body, body, aabb.GetCenter(), closest);
+            joint_def.collideConnected = true;
+            // jointDefinition.dampingRatio = 0.5f;
+            // jointDefinition.frequencyHz = 5.0f;
+            // jointDefinition.length = 0.01f;
+
+            Audio::getInstance().playSample("impact.wav");
+            _climb_joint = player_body->GetWorld()->CreateJoint(&joint_def);
          }
       }
    }
@@ -253,7 +228,7 @@ void PlayerClimb::removeClimbJoint()
 
 
 //----------------------------------------------------------------------------------------------------------------------
-bool PlayerClimb::isClimbableEdge(b2ChainShape* shape, int i)
+bool PlayerClimb::isClimbableEdge(const std::vector<b2Vec2>& loop, int i)
 {
    /*
       climbable edges:
@@ -313,29 +288,17 @@ bool PlayerClimb::isClimbableEdge(b2ChainShape* shape, int i)
 
    */
 
-   // the last vertex of a shape is duplicated for some weird reson.
-   // probably needs some more investigation. for now it's just not taken into regard
-   shape->m_count--;
-
-   auto index = [shape](int i) -> int {
-      if (i >= shape->m_count)
-      {
-         return i - shape->m_count;
-      }
-      if (i < 0)
-      {
-         return shape->m_count + i;
-      }
-      return i;
+   // the loop is closed, so the neighbours of the first and last vertices wrap around
+   const auto count = static_cast<int32_t>(loop.size());
+   auto index = [count](int i) -> int {
+      return ((i % count) + count) % count;
    };
 
-   auto pp = shape->m_vertices[index(i - 2)];
-   auto p = shape->m_vertices[index(i - 1)];
-   auto c = shape->m_vertices[i];
-   auto n = shape->m_vertices[index(i + 1)];
-   auto nn = shape->m_vertices[index(i + 2)];
-
-   shape->m_count++;
+   auto pp = loop[index(i - 2)];
+   auto p = loop[index(i - 1)];
+   auto c = loop[i];
+   auto n = loop[index(i + 1)];
+   auto nn = loop[index(i + 2)];
 
    auto climbable =
          (p.y > c.y && (fabs(n.x - c.x) > 0.001f) && pp.y > p.y)
@@ -3,6 +3,7 @@
 #include "playercontrols.h"
 #include <Box2D/Box2D.h>
 #include <functional>
+#include <vector>
 
 class b2Joint;
 class b2ChainShape;
@@ -13,7 +14,7 @@ struct PlayerClimb
 
    void update(b2Body* body, bool in_air);
    void removeClimbJoint();
-   bool isClimbableEdge(b2ChainShape* shape, int currIndex);
+   bool isClimbableEdge(const std::vector<b2Vec2>& loop, int currIndex);
    bool edgeMatchesMovement(const b2Vec2 &edgeDir);
    bool isClimbing() const;
 
@@ -9,7 +9,7 @@
 
 
 std::vector<Projectile::HitInformation> Projectile::_hit_information;
-std::set<Projectile*> Projectile::_projectiles;
+std::vector<Projectile*> Projectile::_projectiles;
 
 
 Projectile::Projectile()
@@ -17,7 +17,9 @@ Projectile::Projectile()
 {
    setClassName(typeid(Projectile).name());
    _type = ObjectTypeProjectile;
-   _projectiles.insert(this);
+
+   _index = _projectiles.size();
+   _projectiles.push_back(this);
 
    ProjectileHitAnimation::setupDefaultAnimation();
 }
@@ -30,7 +32,24 @@ Projectile::~Projectile()
       cb();
    }
 
-   _body->GetWorld()->DestroyBody(_body);
+   // swap the last projectile into the slot of this one
+   if (_index < _projectiles.size() && _projectiles[_index] == this)
+   {
+      auto last = _projectiles.back();
+      last->_index = _index;
+      _projectiles[_index] = last;
+      _projectiles.pop_back();
+   }
+
+   // weapons that pool their bodies take them back
+   if (_body_recycler)
+   {
+      _body_recycler(_body);
+   }
+   else
+   {
+      _body->GetWorld()->DestroyBody(_body);
+   }
 }
 
 
@@ -81,9 +100,9 @@ void Projectile::collectHitInformation()
 {
    _hit_information.clear();
 
-   for (auto it = _projectiles.begin(); it != _projectiles.end(); )
+   for (auto i = 0u; i < _projectiles.size();)
    {
-      auto projectile = *it;
+      auto projectile = _projectiles[i];
       if (projectile->isScheduledForRemoval())
       {
          _hit_information.push_back({
@@ -94,13 +113,12 @@ void Projectile::collectHitInformation()
             }
          );
 
-         delete *it;
-
-         _projectiles.erase(it++);
+         // the destructor moves the last projectile into slot i
+         delete projectile;
       }
       else
       {
-         ++it;
+         i++;
       }
    }
 }
@@ -187,6 +205,12 @@ void Projectile::addDestroyedCallback(const DestroyedCallback& destroyed_callbac
 }
 
 
+void Projectile::setBodyRecycler(const BodyRecycler& body_recycler)
+{
+   _body_recycler = body_recycler;
+}
+
+
 bool Projectile::isSticky() const
 {
    return _sticky;
@@ -10,7 +10,7 @@
 #include <functional>
 #include <list>
 #include <map>
-#include <set>
+#include <vector>
 
 class b2Body;
 
@@ -28,6 +28,7 @@ public:
    };
 
    using DestroyedCallback = std::function<void(void)>;
+   using BodyRecycler = std::function<void(b2Body*)>;
 
    Projectile();
    virtual ~Projectile();
@@ -39,6 +40,7 @@ public:
    static void update(const sf::Time& dt);
 
    void addDestroyedCallback(const DestroyedCallback& destroyedCallback);
+   void setBodyRecycler(const BodyRecycler& body_recycler);
 
    bool isSticky() const;
    void setSticky(bool sticky);
@@ -82,11 +84,14 @@ protected:
    WeaponType _weapon_type = WeaponType::None;
    std::string _projectile_identifier = default_projectile_identifier;
    std::vector<DestroyedCallback> _destroyed_callbacks;
+   BodyRecycler _body_recycler;
+   size_t _index = 0;
 
    Animation _animation;
    sf::Rect<int32_t> _animation_texture_rect;
 
-   static std::set<Projectile*> _projectiles;
+   // all projectiles in one contiguous array, each projectile knows its own slot so it can be removed in O(1)
+   static std::vector<Projectile*> _projectiles;
    static std::vector<HitInformation> _hit_information;
 };
 
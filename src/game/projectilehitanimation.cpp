@@ -2,12 +2,13 @@
 
 #include "texturepool.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 
 //----------------------------------------------------------------------------------------------------------------------
-std::vector<ProjectileHitAnimation*> ProjectileHitAnimation::__active_animations;
+std::vector<ProjectileHitAnimation> ProjectileHitAnimation::__active_animations;
 std::map<std::string, AnimationFrameData> ProjectileHitAnimation::__reference_animations;
 
 
@@ -23,7 +24,9 @@ constexpr auto frame_time = 0.075f;
 //----------------------------------------------------------------------------------------------------------------------
 void ProjectileHitAnimation::playHitAnimation(float x, float y, float angle, const AnimationFrameData& frames)
 {
-   auto anim = new ProjectileHitAnimation();
+   // the animations are stored by value so a burst of hits doesn't allocate one heap object each
+   __active_animations.emplace_back();
+   auto anim = &__active_animations.back();
 
    anim->_frames = frames._frames;
    anim->_color_texture = frames._texture;
@@ -41,37 +44,30 @@ void ProjectileHitAnimation::playHitAnimation(float x, float y, float angle, con
    // Log::Info() << "setting animation rotation to " << angle;
 
    anim->play();
-
-   __active_animations.push_back(anim);
 }
 
 
 //----------------------------------------------------------------------------------------------------------------------
 void ProjectileHitAnimation::updateHitAnimations(const sf::Time& dt)
 {
-   std::vector<ProjectileHitAnimation*>::iterator it;
-   for (it = __active_animations.begin(); it != __active_animations.end();)
+   // after one loop animation will go into paused state
+   __active_animations.erase(
+      std::remove_if(__active_animations.begin(), __active_animations.end(), [](const auto& animation){
+            return animation._paused;
+         }
+      ),
+      __active_animations.end()
+   );
+
+   for (auto& animation : __active_animations)
    {
-      auto animation = (*it);
-
-      // after one loop animation will go into paused state
-      if (animation->_paused)
-      {
-         // Log::Info() << "removing animation after " << animation->mElapsed.asMilliseconds() << "ms";
-         delete animation;
-         it = __active_animations.erase(it);
-      }
-      else
-      {
-         animation->update(dt);
-         ++it;
-      }
+      animation.update(dt);
    }
 }
 
 
 //----------------------------------------------------------------------------------------------------------------------
-std::vector<ProjectileHitAnimation*>& ProjectileHitAnimation::getHitAnimations()
+std::vector<ProjectileHitAnimation>& ProjectileHitAnimation::getHitAnimations()
 {
    return __active_animations;
 }
@@ -18,7 +18,7 @@ public:
    // active animations
    static void playHitAnimation(float x, float y, float angle, const AnimationFrameData& frames);
    static void updateHitAnimations(const sf::Time& dt);
-   static std::vector<ProjectileHitAnimation*>& getHitAnimations();
+   static std::vector<ProjectileHitAnimation>& getHitAnimations();
 
    // reference animations
    static void addReferenceAnimation(const std::string& id, const AnimationFrameData& animation);
@@ -39,7 +39,7 @@ public:
 
 protected:
 
-   static std::vector<ProjectileHitAnimation*> __active_animations;
+   static std::vector<ProjectileHitAnimation> __active_animations;
    static std::map<std::string, AnimationFrameData> __reference_animations;
 
 };
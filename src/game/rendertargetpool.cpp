@@ -0,0 +1,142 @@
+#include "rendertargetpool.h"
+
+#include "framework/tools/log.h"
+
+#include <algorithm>
+#include <numeric>
+
+
+RenderTargetPool::Handle RenderTargetPool::declare(
+   const std::string& name,
+   const Descriptor& descriptor,
+   int32_t first_pass,
+   int32_t last_pass
+)
+{
+   Target target;
+   target._name = name;
+   target._descriptor = descriptor;
+   target._first_pass = first_pass;
+   target._last_pass = last_pass;
+
+   _targets.push_back(target);
+   return static_cast<Handle>(_targets.size() - 1);
+}
+
+
+void RenderTargetPool::compile()
+{
+   _physical_targets.clear();
+
+   // assign targets in the order they come alive so a physical target can be handed over
+   // to the next user as soon as its previous user's last pass is done
+   std::vector<size_t> order(_targets.size());
+   std::iota(order.begin(), order.end(), 0);
+   std::stable_sort(order.begin(), order.end(), [this](auto a, auto b){
+         return _targets[a]._first_pass < _targets[b]._first_pass;
+      }
+   );
+
+   for (auto index : order)
+   {
+      auto& target = _targets[index];
+
+      auto it = std::find_if(_physical_targets.begin(), _physical_targets.end(), [&target](const auto& physical){
+            return
+                  physical._descriptor._width == target._descriptor._width
+               && physical._descriptor._height == target._descriptor._height
+               && physical._last_pass < target._first_pass;
+         }
+      );
+
+      if (it == _physical_targets.end())
+      {
+         PhysicalTarget physical;
+         physical._descriptor = target._descriptor;
+         _physical_targets.push_back(physical);
+         it = _physical_targets.end() - 1;
+      }
+
+      // a shared target needs a stencil buffer if any of its users do
+      it->_descriptor._stencil |= target._descriptor._stencil;
+      it->_last_pass = target._last_pass;
+      target._physical_index = static_cast<int32_t>(std::distance(_physical_targets.begin(), it));
+   }
+
+   for (auto& physical : _physical_targets)
+   {
+      sf::ContextSettings context_settings;
+      context_settings.stencilBits = physical._descriptor._stencil ? 8 : 0;
+
+      physical._render_texture = std::make_shared<sf::RenderTexture>();
+      physical._render_texture->create(physical._descriptor._width, physical._descriptor._height, context_settings);
+   }
+
+   logReport();
+}
+
+
+void RenderTargetPool::clear()
+{
+   _targets.clear();
+   _physical_targets.clear();
+}
+
+
+const std::shared_ptr<sf::RenderTexture>& RenderTargetPool::get(Handle handle) const
+{
+   return _physical_targets[_targets[handle]._physical_index]._render_texture;
+}
+
+
+size_t RenderTargetPool::computeSize(const Descriptor& descriptor)
+{
+   // rgba8 color attachment plus a packed depth24/stencil8 attachment if requested
+   const auto bytes_per_pixel = descriptor._stencil ? 8u : 4u;
+   return static_cast<size_t>(descriptor._width) * descriptor._height * bytes_per_pixel;
+}
+
+
+size_t RenderTargetPool::computeSize() const
+{
+   size_t size = 0;
+
+   for (const auto& physical : _physical_targets)
+   {
+      size += computeSize(physical._descriptor);
+   }
+
+   return size;
+}
+
+
+size_t RenderTargetPool::computeSizeWithoutAliasing() const
+{
+   size_t size = 0;
+
+   for (const auto& target : _targets)
+   {
+      size += computeSize(target._descriptor);
+   }
+
+   return size;
+}
+
+
+void RenderTargetPool::logReport() const
+{
+   for (const auto& target : _targets)
+   {
+      Log::Info()
+         << "render target '" << target._name << "': "
+         << target._descriptor._width << " x " << target._descriptor._height
+         << (target._descriptor._stencil ? " (stencil)" : "")
+         << ", passes " << target._first_pass << ".." << target._last_pass
+         << " -> texture " << target._physical_index;
+   }
+
+   Log::Info()
+      << "render targets: " << _targets.size() << " targets in " << _physical_targets.size() << " textures, "
+      << computeSize() / (1024 * 1024) << "mb vram (" << computeSizeWithoutAliasing() / (1024 * 1024) << "mb without aliasing)";
+}
+
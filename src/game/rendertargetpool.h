@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+
+/*! \brief A pool of render targets shared between the passes of a frame
+ *         Targets whose lifetimes don't overlap share the same render texture.
+ *
+ *  Each pass declares the targets it writes or reads along with the index of the first and the
+ *  last pass that uses them. compile() then assigns physical render textures to those targets;
+ *  a physical render texture is re-used for every target of the same size that is declared
+ *  after the previous user's last pass. Targets that are never declared (i.e. disabled passes)
+ *  are never allocated.
+ */
+class RenderTargetPool
+{
+
+public:
+
+   struct Descriptor
+   {
+      uint32_t _width = 0;
+      uint32_t _height = 0;
+      bool _stencil = false;
+   };
+
+   using Handle = int32_t;
+   static constexpr Handle InvalidHandle = -1;
+
+   Handle declare(const std::string& name, const Descriptor& descriptor, int32_t first_pass, int32_t last_pass);
+   void compile();
+   void clear();
+
+   const std::shared_ptr<sf::RenderTexture>& get(Handle handle) const;
+
+   size_t computeSize() const;
+   size_t computeSizeWithoutAliasing() const;
+   void logReport() const;
+
+
+private:
+
+   struct Target
+   {
+      std::string _name;
+      Descriptor _descriptor;
+      int32_t _first_pass = 0;
+      int32_t _last_pass = 0;
+      int32_t _physical_index = -1;
+   };
+
+   struct PhysicalTarget
+   {
+      Descriptor _descriptor;
+      int32_t _last_pass = 0;
+      std::shared_ptr<sf::RenderTexture> _render_texture;
+   };
+
+   static size_t computeSize(const Descriptor& descriptor);
+
+   std::vector<Target> _targets;
+   std::vector<PhysicalTarget> _physical_targets;
+};
+
@@ -7,16 +7,9 @@
 
 
 //----------------------------------------------------------------------------------------------------------------------
-AtmosphereShader::AtmosphereShader(
-   uint32_t texture_width,
-   uint32_t texture_height
-)
- : _render_texture(std::make_shared<sf::RenderTexture>())
+AtmosphereShader::AtmosphereShader(const std::shared_ptr<sf::RenderTexture>& render_texture)
+ : _render_texture(render_texture)
 {
-   _render_texture->create(
-      static_cast<uint32_t>(texture_width),
-      static_cast<uint32_t>(texture_height)
-   );
 }
 
 
@@ -6,10 +6,7 @@
 class AtmosphereShader
 {
    public:
-      AtmosphereShader(
-         uint32_t texture_width,
-         uint32_t texture_height
-      );
+      AtmosphereShader(const std::shared_ptr<sf::RenderTexture>& render_texture);
 
       ~AtmosphereShader();
 
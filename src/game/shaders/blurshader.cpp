@@ -4,33 +4,15 @@
 
 #include <iostream>
 
-#define SUPPORT_STENCIL_BITS 1
-
 
 //----------------------------------------------------------------------------------------------------------------------
 BlurShader::BlurShader(
-   uint32_t width,
-   uint32_t height
+   const std::shared_ptr<sf::RenderTexture>& render_texture,
+   const std::shared_ptr<sf::RenderTexture>& render_texture_scaled
 )
- : _render_texture(std::make_shared<sf::RenderTexture>()),
-   _render_texture_scaled(std::make_shared<sf::RenderTexture>())
+ : _render_texture(render_texture),
+   _render_texture_scaled(render_texture_scaled)
 {
-#ifdef SUPPORT_STENCIL_BITS
-   sf::ContextSettings contextSettings;
-   contextSettings.stencilBits = 8;
-#endif
-
-#ifdef SUPPORT_STENCIL_BITS
-   _render_texture->create(width, height, contextSettings);
-#else
-   _render_texture->create(width, height);
-#endif
-
-#ifdef SUPPORT_STENCIL_BITS
-   _render_texture_scaled->create(960, 540, contextSettings);
-#else
-   _render_texture->create(960, 540);
-#endif
    _render_texture_scaled->setSmooth(true);
 }
 
@@ -7,8 +7,8 @@ class BlurShader
 {
    public:
       BlurShader(
-         uint32_t width,
-         uint32_t height
+         const std::shared_ptr<sf::RenderTexture>& render_texture,
+         const std::shared_ptr<sf::RenderTexture>& render_texture_scaled
       );
 
       ~BlurShader();
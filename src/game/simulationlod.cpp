@@ -0,0 +1,108 @@
+#include "simulationlod.h"
+
+#include "gamemechanism.h"
+#include "luanode.h"
+#include "room.h"
+
+#include <algorithm>
+
+
+namespace
+{
+// mechanisms that replay their movement shouldn't stall the frame they wake up in
+constexpr auto max_fast_forward_seconds = 2.0f;
+}
+
+
+void SimulationLod::update(const sf::FloatRect& view_rect_px, const std::shared_ptr<Room>& room)
+{
+   _active_rects_px.clear();
+
+   // distance fallback, so things right outside the screen keep moving while the camera pans
+   _active_rects_px.push_back({
+         view_rect_px.left - view_rect_px.width,
+         view_rect_px.top - view_rect_px.height,
+         view_rect_px.width * 3.0f,
+         view_rect_px.height * 3.0f
+      }
+   );
+
+   if (room)
+   {
+      for (const auto& sub_room : room->_sub_rooms)
+      {
+         _active_rects_px.push_back(sub_room._rect);
+      }
+   }
+}
+
+
+bool SimulationLod::isActive(const sf::FloatRect& rect_px) const
+{
+   return std::any_of(_active_rects_px.begin(), _active_rects_px.end(), [&rect_px](const auto& active_rect_px){
+         return active_rect_px.intersects(rect_px);
+      }
+   );
+}
+
+
+void SimulationLod::updateMechanisms(const std::vector<std::vector<std::shared_ptr<GameMechanism>>*>& mechanisms, const sf::Time& dt)
+{
+   for (const auto& mechanism_vector : mechanisms)
+   {
+      for (const auto& mechanism : *mechanism_vector)
+      {
+         // mechanisms without a bounding box are always simulated
+         const auto bounding_box_px = mechanism->getBoundingBoxPx();
+         const auto active = !bounding_box_px.has_value() || isActive(*bounding_box_px);
+
+         auto it = _dormant_mechanisms.find(mechanism.get());
+         const auto dormant = (it != _dormant_mechanisms.end());
+
+         if (active)
+         {
+            if (dormant)
+            {
+               const auto dormant_time = it->second;
+               _dormant_mechanisms.erase(it);
+               wake(mechanism.get(), dormant_time, dt);
+            }
+
+            mechanism->update(dt);
+         }
+         else if (dormant)
+         {
+            it->second += dt;
+         }
+         else
+         {
+            _dormant_mechanisms[mechanism.get()] = dt;
+            mechanism->setDormant(true);
+         }
+      }
+   }
+}
+
+
+void SimulationLod::wake(GameMechanism* mechanism, const sf::Time& dormant_time, const sf::Time& dt)
+{
+   // that happens before the mechanism is woken up so its bodies don't go through the broadphase
+   mechanism->fastForward(std::min(dormant_time, sf::seconds(max_fast_forward_seconds)), dt);
+   mechanism->setDormant(false);
+}
+
+
+void SimulationLod::updateEnemies(const std::vector<std::shared_ptr<LuaNode>>& enemies)
+{
+   for (const auto& enemy : enemies)
+   {
+      if (!enemy->_body)
+      {
+         continue;
+      }
+
+      const auto& pos_px = enemy->_position_px;
+      enemy->setDormant(!isActive({pos_px.x, pos_px.y, 1.0f, 1.0f}));
+   }
+}
+
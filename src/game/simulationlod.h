@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class GameMechanism;
+class LuaNode;
+struct Room;
+
+
+/*! \brief Limits the simulation to the part of the level that is close to the player
+ *
+ *  The active area is the current room plus the camera view extended by one view in each direction;
+ *  levels without rooms only use the latter. Mechanisms that report a bounding box and enemies outside
+ *  the active area are put to sleep: they are no longer updated and their bodies are deactivated.
+ *
+ *  When a mechanism re-enters the active area, it's told how long it slept (up to a limit) so it can advance
+ *  its phase without side effects; moving platforms replay their movement, everything else just continues
+ *  where it was put to sleep since a full update could hurt or kill the player. Enemies continue where they
+ *  were put to sleep as well and their lua timers are paused while they're dormant.
+ */
+class SimulationLod
+{
+
+public:
+
+   void update(const sf::FloatRect& view_rect_px, const std::shared_ptr<Room>& room);
+   bool isActive(const sf::FloatRect& rect_px) const;
+
+   void updateMechanisms(const std::vector<std::vector<std::shared_ptr<GameMechanism>>*>& mechanisms, const sf::Time& dt);
+   void updateEnemies(const std::vector<std::shared_ptr<LuaNode>>& enemies);
+
+
+private:
+
+   void wake(GameMechanism* mechanism, const sf::Time& dormant_time, const sf::Time& dt);
+
+   std::vector<sf::FloatRect> _active_rects_px;
+   std::unordered_map<GameMechanism*, sf::Time> _dormant_mechanisms;
+};
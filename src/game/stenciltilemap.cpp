@@ -6,6 +6,38 @@
 #include "framework/tmxparser/tmxlayer.h"
 #include "framework/tmxparser/tmxproperties.h"
 #include "framework/tmxparser/tmxproperty.h"
+#include "gameconfiguration.h"
+
+#include <algorithm>
+
+
+int64_t StencilTileMap::__frame = 0;
+
+
+namespace
+{
+
+sf::Shader& alphaMaskShader()
+{
+   static sf::Shader __shader;
+   static bool __loaded = false;
+
+   if (!__loaded)
+   {
+      __loaded = true;
+
+      if (!__shader.loadFromFile("data/shaders/alpha_mask.frag", sf::Shader::Fragment))
+      {
+         Log::Error() << "error loading alpha mask shader";
+      }
+
+      __shader.setUniform("texture", sf::Shader::CurrentTexture);
+   }
+
+   return __shader;
+}
+
+}
 
 
 bool StencilTileMap::load(const std::shared_ptr<TmxLayer>& layer, const std::shared_ptr<TmxTileSet>& tileset, const std::filesystem::path& base_path)
@@ -38,6 +70,72 @@ bool StencilTileMap::load(const std::shared_ptr<TmxLayer>& layer, const std::sha
 
 
 void StencilTileMap::draw(sf::RenderTarget& color, sf::RenderTarget& normal, sf::RenderStates states) const
+{
+   if (GameConfiguration::getInstance()._stencil_alpha_mask_enabled && _alpha_mask)
+   {
+      drawWithAlphaMask(color, normal, states);
+   }
+   else
+   {
+      drawWithStencilBuffer(color, normal, states);
+   }
+}
+
+
+void StencilTileMap::nextFrame()
+{
+   __frame++;
+}
+
+
+void StencilTileMap::updateAlphaMask(const sf::RenderTarget& color, const sf::Transform& transform) const
+{
+   // the mask is shared by all tile maps with the same reference, the first one drawn in a frame updates it;
+   // tile maps drawn with a different transform need it redrawn
+   if (
+         _alpha_mask->_frame == __frame
+      && std::equal(transform.getMatrix(), transform.getMatrix() + 16, _alpha_mask->_transform.getMatrix())
+   )
+   {
+      return;
+   }
+
+   _alpha_mask->_frame = __frame;
+   _alpha_mask->_transform = transform;
+
+   auto& render_texture = _alpha_mask->_render_texture;
+   if (render_texture.getSize() != color.getSize())
+   {
+      render_texture.create(color.getSize().x, color.getSize().y);
+   }
+
+   // the mask is rendered with the same view as the color target so it can be sampled in window coordinates
+   render_texture.setView(color.getView());
+   render_texture.clear(sf::Color::Transparent);
+
+   const auto visible = _stencil_tilemap->isVisible();
+   _stencil_tilemap->setVisible(true);
+   _stencil_tilemap->draw(render_texture, sf::RenderStates{transform});
+   _stencil_tilemap->setVisible(visible);
+
+   render_texture.display();
+}
+
+
+void StencilTileMap::drawWithAlphaMask(sf::RenderTarget& color, sf::RenderTarget& normal, sf::RenderStates states) const
+{
+   updateAlphaMask(color, states.transform);
+
+   auto& shader = alphaMaskShader();
+   shader.setUniform("mask", _alpha_mask->_render_texture.getTexture());
+   shader.setUniform("mask_size", sf::Glsl::Vec2(_alpha_mask->_render_texture.getSize()));
+
+   states.shader = &shader;
+   TileMap::draw(color, normal, states);
+}
+
+
+void StencilTileMap::drawWithStencilBuffer(sf::RenderTarget& color, sf::RenderTarget& normal, sf::RenderStates states) const
 {
    prepareWriteToStencilBuffer();
    const auto visible = _stencil_tilemap->isVisible();
@@ -89,6 +187,12 @@ void StencilTileMap::setStencilTilemap(const std::shared_ptr<TileMap>& stencil_t
 }
 
 
+void StencilTileMap::setAlphaMask(const std::shared_ptr<AlphaMask>& alpha_mask)
+{
+   _alpha_mask = alpha_mask;
+}
+
+
 const std::string& StencilTileMap::getStencilReference() const
 {
    return _stencil_reference;
@@ -2,13 +2,27 @@
 
 #include "tilemap.h"
 
+#include <memory>
+
 /*! \brief A tile map implementation that contains a second tilemap that serves as a stencil buffer
  *
-  */
+ *  By default the reference tile map is drawn into the stencil buffer (with alpha testing) before each
+ *  stencil tile map is drawn. Alternatively, the reference tile map's coverage is drawn into an alpha mask
+ *  texture once per frame; all stencil tile maps that share the same reference then sample that mask in a
+ *  shader and discard uncovered fragments. That mode neither needs a stencil buffer nor GL_ALPHA_TEST which
+ *  isn't available in core profiles.
+ */
 class StencilTileMap : public TileMap
 {
    public:
 
+      struct AlphaMask
+      {
+         sf::RenderTexture _render_texture;
+         sf::Transform _transform;
+         int64_t _frame = -1;
+      };
+
       StencilTileMap() = default;
 
       bool load(const std::shared_ptr<TmxLayer>& layer, const std::shared_ptr<TmxTileSet>& tileset, const std::filesystem::path& base_path) override;
@@ -16,14 +30,23 @@ class StencilTileMap : public TileMap
 
       const std::string& getStencilReference() const;
       void setStencilTilemap(const std::shared_ptr<TileMap>& stencil_tilemap);
+      void setAlphaMask(const std::shared_ptr<AlphaMask>& alpha_mask);
+
+      static void nextFrame();
 
    private:
 
+      void drawWithStencilBuffer(sf::RenderTarget& color, sf::RenderTarget& normal, sf::RenderStates states) const;
+      void drawWithAlphaMask(sf::RenderTarget& color, sf::RenderTarget& normal, sf::RenderStates states) const;
+      void updateAlphaMask(const sf::RenderTarget& color, const sf::Transform& transform) const;
+
       void prepareWriteToStencilBuffer() const;
       void prepareWriteColor() const;
       void disableStencilTest() const;
 
       std::string _stencil_reference;
       std::shared_ptr<TileMap> _stencil_tilemap = nullptr;
-};
+      std::shared_ptr<AlphaMask> _alpha_mask;
 
+      static int64_t __frame;
+};
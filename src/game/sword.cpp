@@ -44,8 +44,8 @@ void Sword::update(const sf::Time& /*time*/)
       updateHitbox();
 
       // this ought to go to a separate class for hit/damage management
-      auto hit_nodes = WorldQuery::findNodes(_hit_rect_px);
-      for (auto& node : hit_nodes)
+      WorldQuery::findNodes(_hit_rect_px, _hit_nodes);
+      for (auto node : _hit_nodes)
       {
          std::cout << "hit: " << node->_script_name << " " << node->_id << std::endl;
          node->luaHit(sword_damage);
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <chrono>
+#include <vector>
 
 #include "Box2D/Box2D.h"
 
 #include "weapon.h"
 
+struct LuaNode;
+
 class Sword : public Weapon
 {
    public:
@@ -33,5 +36,6 @@ class Sword : public Weapon
 
       bool _cleared_to_attack{true};
       sf::FloatRect _hit_rect_px;
+      std::vector<LuaNode*> _hit_nodes;
 };
 
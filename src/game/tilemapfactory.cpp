@@ -39,6 +39,9 @@ void TileMapFactory::merge(const std::vector<std::shared_ptr<TileMap>>& tile_map
       tile_maps_map[tile_map->getLayerName()] = tile_map;
    }
 
+   // stencil tile maps that share the same reference also share its alpha mask
+   std::map<std::string, std::shared_ptr<StencilTileMap::AlphaMask>> alpha_masks;
+
    for (auto& tile_map : tile_maps)
    {
       auto stencil_tile_map = dynamic_pointer_cast<StencilTileMap>(tile_map);
@@ -58,5 +61,13 @@ void TileMapFactory::merge(const std::vector<std::shared_ptr<TileMap>>& tile_map
       }
 
       stencil_tile_map->setStencilTilemap(reference_map);
+
+      auto& alpha_mask = alpha_masks[reference_name];
+      if (!alpha_mask)
+      {
+         alpha_mask = std::make_shared<StencilTileMap::AlphaMask>();
+      }
+
+      stencil_tile_map->setAlphaMask(alpha_mask);
    }
 }
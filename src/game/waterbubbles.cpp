@@ -30,6 +30,9 @@ WaterBubbles::WaterBubbles()
 
 void WaterBubbles::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
 {
+   // bubbles need to know about the water surface, so they stay on the cpu but are drawn in one go
+   _vertices.clear();
+
    for (const auto& bubble : _bubbles)
    {
       // sleeping bubbles aren't drawn just yet
@@ -38,7 +41,26 @@ void WaterBubbles::draw(sf::RenderTarget& target, sf::RenderTarget& /*normal*/)
          continue;
       }
 
-      target.draw(bubble->_sprite);
+      // sprite origin is the bubble's center
+      const auto& rect = bubble->_texture_rect;
+      const auto left = bubble->_position.x - rect.width * 0.5f;
+      const auto top = bubble->_position.y - rect.height * 0.5f;
+      const auto right = left + rect.width;
+      const auto bottom = top + rect.height;
+      const auto u0 = static_cast<float>(rect.left);
+      const auto v0 = static_cast<float>(rect.top);
+      const auto u1 = static_cast<float>(rect.left + rect.width);
+      const auto v1 = static_cast<float>(rect.top + rect.height);
+
+      _vertices.append(sf::Vertex({left, top}, {u0, v0}));
+      _vertices.append(sf::Vertex({right, top}, {u1, v0}));
+      _vertices.append(sf::Vertex({right, bottom}, {u1, v1}));
+      _vertices.append(sf::Vertex({left, bottom}, {u0, v1}));
+   }
+
+   if (_vertices.getVertexCount() > 0)
+   {
+      target.draw(_vertices, _texture.get());
    }
 }
 
@@ -84,9 +106,8 @@ void WaterBubbles::update(const sf::Time& dt, const WaterBubbleInput& input)
 
          // std::cout << "spawn " << pos_px.x << ", " << pos_px.y << std::endl;
 
-         auto bubble = std::make_shared<Bubble>(pos_px, vel_px, _texture);
-         bubble->_sprite.setTextureRect(sprite_rects[std::rand() % sprite_rects.size()]);
-         bubble->_sprite.setOrigin(12.0f, 12.0f);
+         auto bubble = std::make_shared<Bubble>(pos_px, vel_px);
+         bubble->_texture_rect = sprite_rects[std::rand() % sprite_rects.size()];
          bubble->_delay_s = frand(0.0f, 0.3f);
          _bubbles.push_back(bubble);
       }
@@ -101,7 +122,6 @@ void WaterBubbles::update(const sf::Time& dt, const WaterBubbleInput& input)
       }
 
       bubble->_position += dt.asSeconds() * bubble->_velocity;
-      bubble->_sprite.setPosition(bubble->_position);
 
       const auto atmosphere = Level::getCurrentLevel()->getAtmosphere().getTileForPosition(bubble->_position);
       if (atmosphere != AtmosphereTileWaterFull)
@@ -114,8 +134,7 @@ void WaterBubbles::update(const sf::Time& dt, const WaterBubbleInput& input)
    _bubbles.erase(std::remove_if(_bubbles.begin(), _bubbles.end(), [](const auto& bubble) { return bubble->_pop; }), _bubbles.end());
 }
 
-WaterBubbles::Bubble::Bubble(const sf::Vector2f& pos, const sf::Vector2f& vel, const std::shared_ptr<sf::Texture>& texture)
+WaterBubbles::Bubble::Bubble(const sf::Vector2f& pos, const sf::Vector2f& vel)
     : _position(pos), _velocity(vel)
 {
-   _sprite.setTexture(*texture);
 }
@@ -13,8 +13,8 @@ public:
 
    struct Bubble
    {
-      Bubble(const sf::Vector2f& pos, const sf::Vector2f& vel, const std::shared_ptr<sf::Texture>& texture);
-      sf::Sprite _sprite;
+      Bubble(const sf::Vector2f& pos, const sf::Vector2f& vel);
+      sf::IntRect _texture_rect;
       sf::Vector2f _position;
       sf::Vector2f _velocity;
       bool _pop = false;
@@ -35,6 +35,7 @@ public:
 private:
    std::vector<std::shared_ptr<Bubble>> _bubbles;
    std::shared_ptr<sf::Texture> _texture;
+   sf::VertexArray _vertices{sf::Quads};
 
    float duration_since_last_bubbles_s = 0.0f;
    float delay_between_spawn_variation_s = 1.0f;
@@ -1,17 +1,173 @@
 #include "worldquery.h"
 
-#include "luainterface.h"
+#include "hitboxindex.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <unordered_map>
 
 b2Vec2 vecS2B(const sf::Vector2f& vector)
 {
    return {vector.x * MPP, vector.y * MPP};
 }
 
+namespace
+{
+
+// collects the fixtures of all proxies overlapping any of the given aabbs in a single walk over the tree
+class MultiQueryCallback
+{
+   public:
+
+      bool QueryCallback(int32 proxy_id)
+      {
+         const auto& fat_aabb = _broad_phase->GetFatAABB(proxy_id);
+         const auto proxy = static_cast<b2FixtureProxy*>(_broad_phase->GetUserData(proxy_id));
+
+         for (auto i = 0u; i < _aabbs->size(); i++)
+         {
+            if (b2TestOverlap(fat_aabb, (*_aabbs)[i]))
+            {
+               (*_fixtures)[i].push_back(proxy->fixture);
+            }
+         }
+
+         return true;
+      }
+
+      const b2BroadPhase* _broad_phase = nullptr;
+      const std::vector<b2AABB>* _aabbs = nullptr;
+      std::vector<std::vector<b2Fixture*>>* _fixtures = nullptr;
+};
+
+
+class FirstHitRayCastCallback : public b2RayCastCallback
+{
+   public:
+
+      float32 ReportFixture(b2Fixture* fixture, const b2Vec2& /*point*/, const b2Vec2& /*normal*/, float32 /*fraction*/) override
+      {
+         _fixtures->push_back(fixture);
+         return 0.0f;
+      }
+
+      std::vector<b2Fixture*>* _fixtures = nullptr;
+};
+
+
+enum class QueryType
+{
+   Fixtures,
+   Bodies,
+   RayCast
+};
+
+
+struct QueryKey
+{
+   const b2World* _world = nullptr;
+
+   // bodies created during a tick don't pass the destruction listener, a changed body count keeps them from
+   // being served results that were cached before they existed
+   int32_t _body_count = 0;
+
+   QueryType _type = QueryType::Fixtures;
+   std::array<float, 4> _values;
+
+   bool operator==(const QueryKey& other) const
+   {
+      return
+            _world == other._world
+         && _body_count == other._body_count
+         && _type == other._type
+         && _values == other._values;
+   }
+};
+
+
+struct QueryKeyHash
+{
+   size_t operator()(const QueryKey& key) const
+   {
+      auto hash = std::hash<const void*>()(key._world) ^ static_cast<size_t>(key._type);
+      hash = hash * 31 + static_cast<size_t>(key._body_count);
+      for (auto value : key._values)
+      {
+         hash = hash * 31 + std::hash<float>()(value);
+      }
+
+      return hash;
+   }
+};
+
+
+struct QueryResult
+{
+   std::vector<b2Fixture*> _fixtures;
+   std::vector<b2Body*> _bodies;
+};
+
+
+// the results live in a deque so references handed out stay valid while more results are added;
+// they are recycled once the next tick starts so their memory is only allocated once
+struct QueryCache
+{
+   QueryResult& find(const QueryKey& key, bool& found)
+   {
+      const auto it = _results.find(key);
+      found = (it != _results.end());
+
+      if (found)
+      {
+         return *it->second;
+      }
+
+      if (_used == _storage.size())
+      {
+         _storage.emplace_back();
+      }
+
+      auto& result = _storage[_used++];
+      result._fixtures.clear();
+      result._bodies.clear();
+      _results[key] = &result;
+      return result;
+   }
+
+   std::unordered_map<QueryKey, QueryResult*, QueryKeyHash> _results;
+   std::deque<QueryResult> _storage;
+   size_t _used = 0;
+};
+
+
+QueryCache __cache;
+WorldQuery::CacheDestructionListener __cache_destruction_listener;
+
+
+QueryKey makeKey(const std::shared_ptr<b2World>& world, QueryType type, const b2Vec2& a, const b2Vec2& b)
+{
+   return {world.get(), world->GetBodyCount(), type, {a.x, a.y, b.x, b.y}};
+}
+
+}
+
+
 std::vector<b2Fixture*> WorldQuery::queryFixtures(const std::shared_ptr<b2World>& world, const b2AABB& aabb)
 {
+   std::vector<b2Fixture*> fixtures;
+   queryFixtures(world, aabb, fixtures);
+   return fixtures;
+}
+
+void WorldQuery::queryFixtures(const std::shared_ptr<b2World>& world, const b2AABB& aabb, std::vector<b2Fixture*>& fixtures)
+{
+   // the query fills the caller's buffer so its memory is reused
    FixtureQueryCallback query_callback;
+   query_callback._fixtures.swap(fixtures);
+   query_callback._fixtures.clear();
    world->QueryAABB(&query_callback, aabb);
-   return query_callback._fixtures;
+   fixtures.swap(query_callback._fixtures);
 }
 
 bool WorldQuery::FixtureQueryCallback::ReportFixture(b2Fixture* fixture)
@@ -22,71 +178,142 @@ bool WorldQuery::FixtureQueryCallback::ReportFixture(b2Fixture* fixture)
 
 std::vector<b2Body*> WorldQuery::queryBodies(const std::shared_ptr<b2World>& world, const b2AABB& aabb)
 {
+   std::vector<b2Body*> bodies;
+   queryBodies(world, aabb, bodies);
+   return bodies;
+}
+
+void WorldQuery::queryBodies(const std::shared_ptr<b2World>& world, const b2AABB& aabb, std::vector<b2Body*>& bodies)
+{
+   // the query fills the caller's buffer so its memory is reused
    BodyQueryCallback query_callback;
+   query_callback._bodies.swap(bodies);
+   query_callback._bodies.clear();
    world->QueryAABB(&query_callback, aabb);
-   return query_callback._bodies;
+   bodies.swap(query_callback._bodies);
 }
 
 bool WorldQuery::BodyQueryCallback::ReportFixture(b2Fixture* fixture)
 {
-   _bodies.push_back(fixture->GetBody());
+   // a body is reported for each proxy of each of its fixtures, the proxies of a body come in no particular order
+   const auto body = fixture->GetBody();
+   if (std::find(_bodies.begin(), _bodies.end(), body) == _bodies.end())
+   {
+      _bodies.push_back(body);
+   }
+
    return true;
 }
 
-std::vector<std::shared_ptr<LuaNode>> WorldQuery::findNodes(const sf::FloatRect& search_rect)
+void WorldQuery::queryFixtures(
+   const std::shared_ptr<b2World>& world,
+   const std::vector<b2AABB>& aabbs,
+   std::vector<std::vector<b2Fixture*>>& fixtures
+)
 {
-   const auto& nodes = LuaInterface::instance().getObjectList();
+   fixtures.resize(aabbs.size());
+   for (auto& f : fixtures)
+   {
+      f.clear();
+   }
 
-   std::vector<std::shared_ptr<LuaNode>> hit_nodes;
-   std::copy_if(
-      nodes.begin(),
-      nodes.end(),
-      std::back_inserter(hit_nodes),
-      [search_rect](const auto& node)
-      {
-         const auto& hit_boxes = node->_hitboxes;
-         return std::any_of(
-            hit_boxes.begin(),
-            hit_boxes.end(),
-            [search_rect](const auto& hit_box) { return hit_box.getRectTranslated().intersects(search_rect); }
-         );
-      }
-   );
+   if (aabbs.empty())
+   {
+      return;
+   }
+
+   auto bounds = aabbs.front();
+   for (const auto& aabb : aabbs)
+   {
+      bounds.Combine(aabb);
+   }
 
-   return hit_nodes;
+   MultiQueryCallback query_callback;
+   query_callback._broad_phase = &world->GetContactManager().m_broadPhase;
+   query_callback._aabbs = &aabbs;
+   query_callback._fixtures = &fixtures;
+   query_callback._broad_phase->Query(&query_callback, bounds);
 }
 
-std::vector<std::shared_ptr<LuaNode>> WorldQuery::findNodes(const std::vector<sf::FloatRect>& attack_rects)
+const std::vector<b2Fixture*>& WorldQuery::queryFixturesCached(const std::shared_ptr<b2World>& world, const b2AABB& aabb)
 {
-   const auto& nodes = LuaInterface::instance().getObjectList();
+   auto found = false;
+   auto& result = __cache.find(makeKey(world, QueryType::Fixtures, aabb.lowerBound, aabb.upperBound), found);
 
-   std::vector<std::shared_ptr<LuaNode>> hit_nodes;
-   std::copy_if(
-      nodes.begin(),
-      nodes.end(),
-      std::back_inserter(hit_nodes),
-      [attack_rects](const auto& node)
-      {
-         const auto& hit_boxes = node->_hitboxes;
-         return std::any_of(
-            hit_boxes.begin(),
-            hit_boxes.end(),
-            [attack_rects](const auto& hit_box)
-            {
-               return std::any_of(
-                  attack_rects.begin(),
-                  attack_rects.end(),
-                  [hit_box](const auto& attack_rect) { return hit_box.getRectTranslated().intersects(attack_rect); }
-               );
-            }
-         );
-      }
-   );
+   if (!found)
+   {
+      queryFixtures(world, aabb, result._fixtures);
+   }
+
+   return result._fixtures;
+}
+
+const std::vector<b2Body*>& WorldQuery::queryBodiesCached(const std::shared_ptr<b2World>& world, const b2AABB& aabb)
+{
+   auto found = false;
+   auto& result = __cache.find(makeKey(world, QueryType::Bodies, aabb.lowerBound, aabb.upperBound), found);
+
+   if (!found)
+   {
+      queryBodies(world, aabb, result._bodies);
+   }
+
+   return result._bodies;
+}
+
+const std::vector<b2Fixture*>& WorldQuery::rayCastCached(
+   const std::shared_ptr<b2World>& world,
+   const b2Vec2& point_1,
+   const b2Vec2& point_2
+)
+{
+   auto found = false;
+   auto& result = __cache.find(makeKey(world, QueryType::RayCast, point_1, point_2), found);
+
+   if (!found)
+   {
+      // stops at the first fixture hit, which is not necessarily the closest one
+      FirstHitRayCastCallback ray_cast_callback;
+      ray_cast_callback._fixtures = &result._fixtures;
+      world->RayCast(&ray_cast_callback, point_1, point_2);
+   }
 
-   return hit_nodes;
+   return result._fixtures;
+}
+
+void WorldQuery::resetCache()
+{
+   __cache._results.clear();
+   __cache._used = 0;
+}
+
+WorldQuery::CacheDestructionListener& WorldQuery::getCacheDestructionListener()
+{
+   return __cache_destruction_listener;
+}
+
+void WorldQuery::CacheDestructionListener::SayGoodbye(b2Joint* /*joint*/)
+{
+}
+
+void WorldQuery::CacheDestructionListener::SayGoodbye(b2Fixture* /*fixture*/)
+{
+   // the results may hold the fixture or its body, so none of them may be handed out again.
+   // the buffers are not recycled before the next tick though since callers might still iterate them.
+   __cache._results.clear();
+}
+
+void WorldQuery::findNodes(const sf::FloatRect& search_rect, std::vector<LuaNode*>& nodes)
+{
+   HitboxIndex::getInstance().query(search_rect, nodes);
+}
+
+void WorldQuery::findNodes(const std::vector<sf::FloatRect>& attack_rects, std::vector<LuaNode*>& nodes)
+{
+   HitboxIndex::getInstance().query(attack_rects, nodes);
 }
 
-std::vector<b2Body*> WorldQuery::retrieveBodiesOnScreen(const std::shared_ptr<b2World>& world, const sf::FloatRect& screen)
+const std::vector<b2Body*>& WorldQuery::retrieveBodiesOnScreen(const std::shared_ptr<b2World>& world, const sf::FloatRect& screen)
 {
    b2AABB aabb;
 
@@ -98,5 +325,5 @@ std::vector<b2Body*> WorldQuery::retrieveBodiesOnScreen(const std::shared_ptr<b2
    aabb.upperBound = vecS2B({std::max(l, r), std::max(b, t)});
    aabb.lowerBound = vecS2B({std::min(l, r), std::min(b, t)});
 
-   return WorldQuery::queryBodies(world, aabb);
+   return WorldQuery::queryBodiesCached(world, aabb);
 }
@@ -29,11 +29,47 @@ class BodyQueryCallback : public b2QueryCallback
 };
 
 
+// invalidates the cached query results when bodies are destroyed in the middle of a tick
+class CacheDestructionListener : public b2DestructionListener
+{
+   public:
+
+      void SayGoodbye(b2Joint* joint) override;
+      void SayGoodbye(b2Fixture* fixture) override;
+};
+
+
 std::vector<b2Fixture*> queryFixtures(const std::shared_ptr<b2World>& world, const b2AABB& aabb);
 std::vector<b2Body*> queryBodies(const std::shared_ptr<b2World>& world, const b2AABB& aabb);
-std::vector<b2Body*> retrieveBodiesOnScreen(const std::shared_ptr<b2World>& world, const sf::FloatRect& screen);
-std::vector<std::shared_ptr<LuaNode>> findNodes(const sf::FloatRect& attack_rect);
-std::vector<std::shared_ptr<LuaNode>> findNodes(const std::vector<sf::FloatRect>& attack_rects);
+
+// these write into caller supplied buffers, which are cleared first.
+// fixtures are reported once per broadphase proxy, so a chain shows up once for each edge in the aabb;
+// bodies are only reported once.
+void queryFixtures(const std::shared_ptr<b2World>& world, const b2AABB& aabb, std::vector<b2Fixture*>& fixtures);
+void queryBodies(const std::shared_ptr<b2World>& world, const b2AABB& aabb, std::vector<b2Body*>& bodies);
+
+// walks the broadphase tree once for all aabbs, fixtures[i] receives what queryFixtures would return for aabbs[i].
+// the aabbs should be close to each other since the walk covers everything within their union.
+void queryFixtures(
+   const std::shared_ptr<b2World>& world,
+   const std::vector<b2AABB>& aabbs,
+   std::vector<std::vector<b2Fixture*>>& fixtures
+);
+
+// identical queries within a tick share their results, resetCache() starts the next tick.
+// results are dropped when a fixture is destroyed and not reused once the number of bodies in the world changed.
+// the returned buffers stay valid until then.
+const std::vector<b2Fixture*>& queryFixturesCached(const std::shared_ptr<b2World>& world, const b2AABB& aabb);
+const std::vector<b2Body*>& queryBodiesCached(const std::shared_ptr<b2World>& world, const b2AABB& aabb);
+const std::vector<b2Fixture*>& rayCastCached(const std::shared_ptr<b2World>& world, const b2Vec2& point_1, const b2Vec2& point_2);
+void resetCache();
+CacheDestructionListener& getCacheDestructionListener();
+
+const std::vector<b2Body*>& retrieveBodiesOnScreen(const std::shared_ptr<b2World>& world, const sf::FloatRect& screen);
+
+// the lua nodes with a hitbox intersecting the rect(s) are written to nodes, which is cleared first
+void findNodes(const sf::FloatRect& attack_rect, std::vector<LuaNode*>& nodes);
+void findNodes(const std::vector<sf::FloatRect>& attack_rects, std::vector<LuaNode*>& nodes);
 
 }
 
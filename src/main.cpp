@@ -3,12 +3,14 @@
 #include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <string>
 
 #include "game/constants.h"
 #include "game/preloader.h"
 #include "game/test.h"
-#include "framework/tools/logthread.h"
+#include "framework/tools/logfile.h"
 
 #ifdef __linux__
 extern "C" int XInitThreads();
@@ -35,15 +37,44 @@ void debugAuthors()
 }
 
 
-int main(int /*argc*/, char** /*argv*/)
+// usage: deceptus --headless [tick count] [level index] [event file]
+std::optional<Game::HeadlessSettings> parseHeadlessSettings(int argc, char** argv)
+{
+   if (argc < 2 || std::string{argv[1]} != "--headless")
+   {
+      return std::nullopt;
+   }
+
+   Game::HeadlessSettings settings;
+
+   if (argc > 2)
+   {
+      settings._tick_count = std::stoi(argv[2]);
+   }
+
+   if (argc > 3)
+   {
+      settings._level_index = std::stoi(argv[3]);
+   }
+
+   if (argc > 4)
+   {
+      settings._event_filename = argv[4];
+   }
+
+   return settings;
+}
+
+
+int main(int argc, char** argv)
 {
 #ifndef DEBUG
    // setup logging to file
-   LogThread log_thread;
+   LogFile log_file;
    Log::registerListenerCallback(
       std::bind(
-         &LogThread::log,
-         &log_thread,
+         &LogFile::log,
+         &log_file,
          std::placeholders::_1,
          std::placeholders::_2,
          std::placeholders::_3,
@@ -57,6 +88,14 @@ int main(int /*argc*/, char** /*argv*/)
 #endif
 
    debugAuthors();
+
+   const auto headless_settings = parseHeadlessSettings(argc, argv);
+   if (headless_settings.has_value())
+   {
+      Game game;
+      return game.runHeadless(headless_settings.value());
+   }
+
    Test test;
    Game game;
    game.initialize();
@@ -0,0 +1,122 @@
+#include <Box2D/Common/b2ThreadPool.h>
+#include <Box2D/Common/b2StackAllocator.h>
+
+b2ThreadPool::b2ThreadPool(int32 threadCount)
+{
+	b2Assert(threadCount > 0);
+
+	m_threadCount = threadCount;
+	m_allocators = new b2StackAllocator[m_threadCount];
+
+	m_generation = 0;
+	m_busyCount = 0;
+	m_stop = false;
+
+	m_function = nullptr;
+	m_context = nullptr;
+	m_taskCount = 0;
+	m_nextTask = 0;
+
+	// Thread 0 is the thread calling Run.
+	for (int32 i = 1; i < m_threadCount; ++i)
+	{
+		m_threads.emplace_back(&b2ThreadPool::WorkerMain, this, i);
+	}
+}
+
+b2ThreadPool::~b2ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_wakeCondition.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+
+	delete[] m_allocators;
+}
+
+b2StackAllocator* b2ThreadPool::GetAllocator(int32 threadIndex)
+{
+	b2Assert(0 <= threadIndex && threadIndex < m_threadCount);
+	return m_allocators + threadIndex;
+}
+
+void b2ThreadPool::Run(b2TaskFunction* function, void* context, int32 taskCount)
+{
+	// Not worth waking up the workers.
+	if (m_threadCount == 1 || taskCount < 2)
+	{
+		for (int32 i = 0; i < taskCount; ++i)
+		{
+			function(context, i, 0);
+		}
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_function = function;
+		m_context = context;
+		m_taskCount = taskCount;
+		m_nextTask = 0;
+		m_busyCount = m_threadCount - 1;
+		++m_generation;
+	}
+
+	m_wakeCondition.notify_all();
+
+	Work(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]() { return m_busyCount == 0; });
+}
+
+void b2ThreadPool::WorkerMain(int32 threadIndex)
+{
+	uint32 generation = 0;
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeCondition.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+
+			if (m_stop)
+			{
+				return;
+			}
+
+			generation = m_generation;
+		}
+
+		Work(threadIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_busyCount;
+		}
+
+		m_doneCondition.notify_one();
+	}
+}
+
+void b2ThreadPool::Work(int32 threadIndex)
+{
+	for (;;)
+	{
+		int32 taskIndex = m_nextTask.fetch_add(1);
+		if (taskIndex >= m_taskCount)
+		{
+			break;
+		}
+
+		m_function(m_context, taskIndex, threadIndex);
+	}
+}
@@ -0,0 +1,67 @@
+#ifndef B2_THREAD_POOL_H
+#define B2_THREAD_POOL_H
+
+#include <Box2D/Common/b2Settings.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class b2StackAllocator;
+
+/// A task is called once for each index passed to b2ThreadPool::Run.
+typedef void b2TaskFunction(void* context, int32 taskIndex, int32 threadIndex);
+
+/// A small pool of worker threads used to solve islands in parallel.
+/// Each thread, including the calling thread, has its own stack allocator
+/// so tasks can allocate without synchronization.
+class b2ThreadPool
+{
+public:
+
+	/// The calling thread counts as one of the threads.
+	explicit b2ThreadPool(int32 threadCount);
+	~b2ThreadPool();
+
+	b2ThreadPool(const b2ThreadPool&) = delete;
+	b2ThreadPool& operator=(const b2ThreadPool&) = delete;
+
+	int32 GetThreadCount() const;
+
+	/// Get the stack allocator of a thread. Thread 0 is the thread calling Run.
+	b2StackAllocator* GetAllocator(int32 threadIndex);
+
+	/// Run the tasks 0..taskCount-1 and wait until all of them are done.
+	/// The calling thread works on tasks as well.
+	void Run(b2TaskFunction* function, void* context, int32 taskCount);
+
+private:
+
+	void WorkerMain(int32 threadIndex);
+	void Work(int32 threadIndex);
+
+	std::vector<std::thread> m_threads;
+	b2StackAllocator* m_allocators;
+	int32 m_threadCount;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wakeCondition;
+	std::condition_variable m_doneCondition;
+	uint32 m_generation;
+	int32 m_busyCount;
+	bool m_stop;
+
+	b2TaskFunction* m_function;
+	void* m_context;
+	int32 m_taskCount;
+	std::atomic<int32> m_nextTask;
+};
+
+inline int32 b2ThreadPool::GetThreadCount() const
+{
+	return m_threadCount;
+}
+
+#endif
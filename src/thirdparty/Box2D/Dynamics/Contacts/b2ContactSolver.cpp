@@ -24,10 +24,52 @@
 #include <Box2D/Dynamics/b2World.h>
 #include <Box2D/Common/b2StackAllocator.h>
 
+#include <string.h>
+
+#if defined(B2_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
 #define B2_DEBUG_SOLVER 0
 
 bool g_blockSolve = true;
 
+b2SimdMode b2DetectSimdMode()
+{
+#if defined(B2_SIMD_X86) && defined(_MSC_VER)
+	// AVX2 needs the cpu support and the os saving the ymm registers.
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] >= 7)
+	{
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		__cpuidex(info, 7, 0);
+		bool avx2 = (info[1] & (1 << 5)) != 0;
+
+		if (osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6)
+		{
+			return b2_simdAVX2;
+		}
+	}
+	return b2_simdSSE2;
+#elif defined(B2_SIMD_X86)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? b2_simdAVX2 : b2_simdSSE2;
+#else
+	return b2_simdNone;
+#endif
+}
+
+b2SimdMode g_contactSolverSimd = b2DetectSimdMode();
+
+// Constraints are colored so that no two constraints of a color share a dynamic body.
+// Constraints that don't get a color are solved one by one after the batches.
+const int32 b2_wideColorCount = 24;
+
 struct b2ContactPositionConstraint
 {
 	b2Vec2 localPoints[b2_maxManifoldPoints];
@@ -54,6 +96,12 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 	m_velocities = def->velocities;
 	m_contacts = def->contacts;
 
+	m_simd = g_contactSolverSimd;
+	m_wideConstraints = nullptr;
+	m_wideCount = 0;
+	m_scalarConstraints = nullptr;
+	m_scalarCount = 0;
+
 	// Initialize position independent portions of the constraints.
 	for (int32 i = 0; i < m_count; ++i)
 	{
@@ -76,8 +124,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->friction = contact->m_friction;
 		vc->restitution = contact->m_restitution;
 		vc->tangentSpeed = contact->m_tangentSpeed;
-		vc->indexA = bodyA->m_islandIndex;
-		vc->indexB = bodyB->m_islandIndex;
+		vc->indexA = b2GetIslandIndex(bodyA, def->statics);
+		vc->indexB = b2GetIslandIndex(bodyB, def->statics);
 		vc->invMassA = bodyA->m_invMass;
 		vc->invMassB = bodyB->m_invMass;
 		vc->invIA = bodyA->m_invI;
@@ -88,8 +136,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->normalMass.SetZero();
 
 		b2ContactPositionConstraint* pc = m_positionConstraints + i;
-		pc->indexA = bodyA->m_islandIndex;
-		pc->indexB = bodyB->m_islandIndex;
+		pc->indexA = b2GetIslandIndex(bodyA, def->statics);
+		pc->indexB = b2GetIslandIndex(bodyB, def->statics);
 		pc->invMassA = bodyA->m_invMass;
 		pc->invMassB = bodyB->m_invMass;
 		pc->localCenterA = bodyA->m_sweep.localCenter;
@@ -132,6 +180,12 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 
 b2ContactSolver::~b2ContactSolver()
 {
+	if (m_wideConstraints)
+	{
+		m_allocator->Free(m_scalarConstraints);
+		m_allocator->Free(m_wideConstraints);
+	}
+
 	m_allocator->Free(m_velocityConstraints);
 	m_allocator->Free(m_positionConstraints);
 }
@@ -246,6 +300,233 @@ void b2ContactSolver::InitializeVelocityConstraints()
 			}
 		}
 	}
+
+	// The batches don't support solving two point constraints one point after another.
+	if (m_simd != b2_simdNone && g_blockSolve && m_count >= b2_simdWidth)
+	{
+		InitializeWideConstraints();
+	}
+}
+
+namespace
+{
+
+bool b2IsDynamic(float32 invMass, float32 invI)
+{
+	return invMass > 0.0f || invI > 0.0f;
+}
+
+// Greedy coloring, returns -1 if all colors are used by one of the bodies.
+int32 b2AssignColor(const b2ContactVelocityConstraint* vc, uint32* bodyColors)
+{
+	bool dynamicA = b2IsDynamic(vc->invMassA, vc->invIA);
+	bool dynamicB = b2IsDynamic(vc->invMassB, vc->invIB);
+
+	// Static and kinematic bodies keep their velocity, so they can be shared within a color.
+	uint32 used = (dynamicA ? bodyColors[vc->indexA] : 0) | (dynamicB ? bodyColors[vc->indexB] : 0);
+
+	for (int32 color = 0; color < b2_wideColorCount; ++color)
+	{
+		uint32 bit = 1u << color;
+		if ((used & bit) == 0)
+		{
+			if (dynamicA)
+			{
+				bodyColors[vc->indexA] |= bit;
+			}
+
+			if (dynamicB)
+			{
+				bodyColors[vc->indexB] |= bit;
+			}
+
+			return color;
+		}
+	}
+
+	return -1;
+}
+
+}
+
+// Pack the constraints into batches for the simd solver.
+void b2ContactSolver::InitializeWideConstraints()
+{
+	b2Assert(m_wideConstraints == nullptr);
+
+	int32 bodyCount = 0;
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		const b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		bodyCount = b2Max(bodyCount, b2Max(vc->indexA, vc->indexB) + 1);
+	}
+
+	// Count the constraints of each color first so the batches can be allocated below the coloring data.
+	int32 colorCounts[b2_wideColorCount] = {};
+	int32 scalarCount = 0;
+
+	uint32* bodyColors = (uint32*)m_allocator->Allocate(bodyCount * sizeof(uint32));
+	memset(bodyColors, 0, bodyCount * sizeof(uint32));
+
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		int32 color = b2AssignColor(m_velocityConstraints + i, bodyColors);
+		if (color < 0)
+		{
+			++scalarCount;
+		}
+		else
+		{
+			++colorCounts[color];
+		}
+	}
+
+	m_allocator->Free(bodyColors);
+
+	// Colors with just a few constraints are not worth a batch.
+	int32 colorBatches[b2_wideColorCount];
+	int32 wideCount = 0;
+	for (int32 color = 0; color < b2_wideColorCount; ++color)
+	{
+		colorBatches[color] = wideCount;
+
+		if (colorCounts[color] < b2_simdWidth / 2)
+		{
+			scalarCount += colorCounts[color];
+			colorCounts[color] = 0;
+			continue;
+		}
+
+		wideCount += (colorCounts[color] + b2_simdWidth - 1) / b2_simdWidth;
+	}
+
+	if (wideCount == 0)
+	{
+		return;
+	}
+
+	m_wideCount = wideCount;
+	m_wideConstraints = (b2WideContactConstraint*)m_allocator->Allocate(m_wideCount * sizeof(b2WideContactConstraint));
+	m_scalarConstraints = (int32*)m_allocator->Allocate(scalarCount * sizeof(int32));
+
+	memset(m_wideConstraints, 0, m_wideCount * sizeof(b2WideContactConstraint));
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		b2WideContactConstraint* wc = m_wideConstraints + i;
+		for (int32 lane = 0; lane < b2_simdWidth; ++lane)
+		{
+			wc->constraintIndex[lane] = -1;
+			wc->indexA[lane] = -1;
+			wc->indexB[lane] = -1;
+		}
+	}
+
+	// The coloring is deterministic, so running it again gives the same colors.
+	int32 colorFill[b2_wideColorCount] = {};
+
+	bodyColors = (uint32*)m_allocator->Allocate(bodyCount * sizeof(uint32));
+	memset(bodyColors, 0, bodyCount * sizeof(uint32));
+
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		const b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		const b2ContactPositionConstraint* pc = m_positionConstraints + i;
+
+		int32 color = b2AssignColor(vc, bodyColors);
+		if (color < 0 || colorCounts[color] == 0)
+		{
+			m_scalarConstraints[m_scalarCount++] = i;
+			continue;
+		}
+
+		int32 slot = colorFill[color]++;
+		b2WideContactConstraint* wc = m_wideConstraints + colorBatches[color] + slot / b2_simdWidth;
+		int32 lane = slot % b2_simdWidth;
+
+		wc->constraintIndex[lane] = i;
+		wc->indexA[lane] = vc->indexA;
+		wc->indexB[lane] = vc->indexB;
+		wc->invMassA[lane] = vc->invMassA;
+		wc->invIA[lane] = vc->invIA;
+		wc->invMassB[lane] = vc->invMassB;
+		wc->invIB[lane] = vc->invIB;
+
+		wc->normalX[lane] = vc->normal.x;
+		wc->normalY[lane] = vc->normal.y;
+		wc->friction[lane] = vc->friction;
+		wc->tangentSpeed[lane] = vc->tangentSpeed;
+
+		if (vc->pointCount == 2)
+		{
+			wc->blockSolve[lane] = 1.0f;
+			wc->K11[lane] = vc->K.ex.x;
+			wc->K12[lane] = vc->K.ey.x;
+			wc->K22[lane] = vc->K.ey.y;
+			wc->normalMass11[lane] = vc->normalMass.ex.x;
+			wc->normalMass12[lane] = vc->normalMass.ey.x;
+			wc->normalMass22[lane] = vc->normalMass.ey.y;
+		}
+
+		for (int32 j = 0; j < vc->pointCount; ++j)
+		{
+			const b2VelocityConstraintPoint* vcp = vc->points + j;
+			wc->rAx[j][lane] = vcp->rA.x;
+			wc->rAy[j][lane] = vcp->rA.y;
+			wc->rBx[j][lane] = vcp->rB.x;
+			wc->rBy[j][lane] = vcp->rB.y;
+			wc->normalMass[j][lane] = vcp->normalMass;
+			wc->tangentMass[j][lane] = vcp->tangentMass;
+			wc->velocityBias[j][lane] = vcp->velocityBias;
+			wc->normalImpulse[j][lane] = vcp->normalImpulse;
+			wc->tangentImpulse[j][lane] = vcp->tangentImpulse;
+		}
+
+		wc->localCenterAx[lane] = pc->localCenterA.x;
+		wc->localCenterAy[lane] = pc->localCenterA.y;
+		wc->localCenterBx[lane] = pc->localCenterB.x;
+		wc->localCenterBy[lane] = pc->localCenterB.y;
+		wc->localNormalX[lane] = pc->localNormal.x;
+		wc->localNormalY[lane] = pc->localNormal.y;
+		wc->localPointX[lane] = pc->localPoint.x;
+		wc->localPointY[lane] = pc->localPoint.y;
+
+		for (int32 j = 0; j < pc->pointCount; ++j)
+		{
+			wc->localPointsX[j][lane] = pc->localPoints[j].x;
+			wc->localPointsY[j][lane] = pc->localPoints[j].y;
+		}
+
+		wc->radiusA[lane] = pc->radiusA;
+		wc->radiusB[lane] = pc->radiusB;
+		wc->circles[lane] = pc->type == b2Manifold::e_circles ? 1.0f : 0.0f;
+		wc->faceB[lane] = pc->type == b2Manifold::e_faceB ? 1.0f : 0.0f;
+		wc->pointCount[lane] = (float32)pc->pointCount;
+	}
+
+	m_allocator->Free(bodyColors);
+}
+
+// Copy the impulses of the batches back for warm starting and reporting.
+void b2ContactSolver::StoreWideImpulses()
+{
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		const b2WideContactConstraint* wc = m_wideConstraints + i;
+		for (int32 lane = 0; lane < b2_simdWidth; ++lane)
+		{
+			if (wc->constraintIndex[lane] < 0)
+			{
+				continue;
+			}
+
+			b2ContactVelocityConstraint* vc = m_velocityConstraints + wc->constraintIndex[lane];
+			for (int32 j = 0; j < vc->pointCount; ++j)
+			{
+				vc->points[j].normalImpulse = wc->normalImpulse[j][lane];
+				vc->points[j].tangentImpulse = wc->tangentImpulse[j][lane];
+			}
+		}
+	}
 }
 
 void b2ContactSolver::WarmStart()
@@ -290,319 +571,348 @@ void b2ContactSolver::WarmStart()
 
 void b2ContactSolver::SolveVelocityConstraints()
 {
+#ifdef B2_SIMD_X86
+	if (m_wideCount > 0)
+	{
+		if (m_simd == b2_simdAVX2)
+		{
+			b2SolveVelocityConstraintsAVX2(m_wideConstraints, m_wideCount, m_velocities);
+		}
+		else
+		{
+			b2SolveVelocityConstraintsSSE2(m_wideConstraints, m_wideCount, m_velocities);
+		}
+
+		for (int32 i = 0; i < m_scalarCount; ++i)
+		{
+			SolveVelocityConstraint(m_velocityConstraints + m_scalarConstraints[i]);
+		}
+
+		return;
+	}
+#endif
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
-		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		SolveVelocityConstraint(m_velocityConstraints + i);
+	}
+}
 
-		int32 indexA = vc->indexA;
-		int32 indexB = vc->indexB;
-		float32 mA = vc->invMassA;
-		float32 iA = vc->invIA;
-		float32 mB = vc->invMassB;
-		float32 iB = vc->invIB;
-		int32 pointCount = vc->pointCount;
+void b2ContactSolver::SolveVelocityConstraint(b2ContactVelocityConstraint* vc)
+{
+	int32 indexA = vc->indexA;
+	int32 indexB = vc->indexB;
+	float32 mA = vc->invMassA;
+	float32 iA = vc->invIA;
+	float32 mB = vc->invMassB;
+	float32 iB = vc->invIB;
+	int32 pointCount = vc->pointCount;
+
+	b2Vec2 vA = m_velocities[indexA].v;
+	float32 wA = m_velocities[indexA].w;
+	b2Vec2 vB = m_velocities[indexB].v;
+	float32 wB = m_velocities[indexB].w;
+
+	b2Vec2 normal = vc->normal;
+	b2Vec2 tangent = b2Cross(normal, 1.0f);
+	float32 friction = vc->friction;
+
+	b2Assert(pointCount == 1 || pointCount == 2);
+
+	// Solve tangent constraints first because non-penetration is more important
+	// than friction.
+	for (int32 j = 0; j < pointCount; ++j)
+	{
+		b2VelocityConstraintPoint* vcp = vc->points + j;
 
-		b2Vec2 vA = m_velocities[indexA].v;
-		float32 wA = m_velocities[indexA].w;
-		b2Vec2 vB = m_velocities[indexB].v;
-		float32 wB = m_velocities[indexB].w;
+		// Relative velocity at contact
+		b2Vec2 dv = vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA);
 
-		b2Vec2 normal = vc->normal;
-		b2Vec2 tangent = b2Cross(normal, 1.0f);
-		float32 friction = vc->friction;
+		// Compute tangent force
+		float32 vt = b2Dot(dv, tangent) - vc->tangentSpeed;
+		float32 lambda = vcp->tangentMass * (-vt);
 
-		b2Assert(pointCount == 1 || pointCount == 2);
+		// b2Clamp the accumulated force
+		float32 maxFriction = friction * vcp->normalImpulse;
+		float32 newImpulse = b2Clamp(vcp->tangentImpulse + lambda, -maxFriction, maxFriction);
+		lambda = newImpulse - vcp->tangentImpulse;
+		vcp->tangentImpulse = newImpulse;
 
-		// Solve tangent constraints first because non-penetration is more important
-		// than friction.
-		for (int32 j = 0; j < pointCount; ++j)
+		// Apply contact impulse
+		b2Vec2 P = lambda * tangent;
+
+		vA -= mA * P;
+		wA -= iA * b2Cross(vcp->rA, P);
+
+		vB += mB * P;
+		wB += iB * b2Cross(vcp->rB, P);
+	}
+
+	// Solve normal constraints
+	if (pointCount == 1 || g_blockSolve == false)
+	{
+		for (int32 i = 0; i < pointCount; ++i)
 		{
-			b2VelocityConstraintPoint* vcp = vc->points + j;
+			b2VelocityConstraintPoint* vcp = vc->points + i;
 
 			// Relative velocity at contact
 			b2Vec2 dv = vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA);
 
-			// Compute tangent force
-			float32 vt = b2Dot(dv, tangent) - vc->tangentSpeed;
-			float32 lambda = vcp->tangentMass * (-vt);
+			// Compute normal impulse
+			float32 vn = b2Dot(dv, normal);
+			float32 lambda = -vcp->normalMass * (vn - vcp->velocityBias);
 
-			// b2Clamp the accumulated force
-			float32 maxFriction = friction * vcp->normalImpulse;
-			float32 newImpulse = b2Clamp(vcp->tangentImpulse + lambda, -maxFriction, maxFriction);
-			lambda = newImpulse - vcp->tangentImpulse;
-			vcp->tangentImpulse = newImpulse;
+			// b2Clamp the accumulated impulse
+			float32 newImpulse = b2Max(vcp->normalImpulse + lambda, 0.0f);
+			lambda = newImpulse - vcp->normalImpulse;
+			vcp->normalImpulse = newImpulse;
 
 			// Apply contact impulse
-			b2Vec2 P = lambda * tangent;
-
+			b2Vec2 P = lambda * normal;
 			vA -= mA * P;
 			wA -= iA * b2Cross(vcp->rA, P);
 
 			vB += mB * P;
 			wB += iB * b2Cross(vcp->rB, P);
 		}
-
-		// Solve normal constraints
-		if (pointCount == 1 || g_blockSolve == false)
+	}
+	else
+	{
+		// Block solver developed in collaboration with Dirk Gregorius (back in 01/07 on Box2D_Lite).
+		// Build the mini LCP for this contact patch
+		//
+		// vn = A * x + b, vn >= 0, , vn >= 0, x >= 0 and vn_i * x_i = 0 with i = 1..2
+		//
+		// A = J * W * JT and J = ( -n, -r1 x n, n, r2 x n )
+		// b = vn0 - velocityBias
+		//
+		// The system is solved using the "Total enumeration method" (s. Murty). The complementary constraint vn_i * x_i
+		// implies that we must have in any solution either vn_i = 0 or x_i = 0. So for the 2D contact problem the cases
+		// vn1 = 0 and vn2 = 0, x1 = 0 and x2 = 0, x1 = 0 and vn2 = 0, x2 = 0 and vn1 = 0 need to be tested. The first valid
+		// solution that satisfies the problem is chosen.
+		// 
+		// In order to account of the accumulated impulse 'a' (because of the iterative nature of the solver which only requires
+		// that the accumulated impulse is clamped and not the incremental impulse) we change the impulse variable (x_i).
+		//
+		// Substitute:
+		// 
+		// x = a + d
+		// 
+		// a := old total impulse
+		// x := new total impulse
+		// d := incremental impulse 
+		//
+		// For the current iteration we extend the formula for the incremental impulse
+		// to compute the new total impulse:
+		//
+		// vn = A * d + b
+		//    = A * (x - a) + b
+		//    = A * x + b - A * a
+		//    = A * x + b'
+		// b' = b - A * a;
+
+		b2VelocityConstraintPoint* cp1 = vc->points + 0;
+		b2VelocityConstraintPoint* cp2 = vc->points + 1;
+
+		b2Vec2 a(cp1->normalImpulse, cp2->normalImpulse);
+		b2Assert(a.x >= 0.0f && a.y >= 0.0f);
+
+		// Relative velocity at contact
+		b2Vec2 dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
+		b2Vec2 dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
+
+		// Compute normal velocity
+		float32 vn1 = b2Dot(dv1, normal);
+		float32 vn2 = b2Dot(dv2, normal);
+
+		b2Vec2 b;
+		b.x = vn1 - cp1->velocityBias;
+		b.y = vn2 - cp2->velocityBias;
+
+		// Compute b'
+		b -= b2Mul(vc->K, a);
+
+		const float32 k_errorTol = 1e-3f;
+		B2_NOT_USED(k_errorTol);
+
+		for (;;)
 		{
-			for (int32 i = 0; i < pointCount; ++i)
+			//
+			// Case 1: vn = 0
+			//
+			// 0 = A * x + b'
+			//
+			// Solve for x:
+			//
+			// x = - inv(A) * b'
+			//
+			b2Vec2 x = - b2Mul(vc->normalMass, b);
+
+			if (x.x >= 0.0f && x.y >= 0.0f)
 			{
-				b2VelocityConstraintPoint* vcp = vc->points + i;
+				// Get the incremental impulse
+				b2Vec2 d = x - a;
 
-				// Relative velocity at contact
-				b2Vec2 dv = vB + b2Cross(wB, vcp->rB) - vA - b2Cross(wA, vcp->rA);
+				// Apply incremental impulse
+				b2Vec2 P1 = d.x * normal;
+				b2Vec2 P2 = d.y * normal;
+				vA -= mA * (P1 + P2);
+				wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
 
-				// Compute normal impulse
-				float32 vn = b2Dot(dv, normal);
-				float32 lambda = -vcp->normalMass * (vn - vcp->velocityBias);
+				vB += mB * (P1 + P2);
+				wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
 
-				// b2Clamp the accumulated impulse
-				float32 newImpulse = b2Max(vcp->normalImpulse + lambda, 0.0f);
-				lambda = newImpulse - vcp->normalImpulse;
-				vcp->normalImpulse = newImpulse;
+				// Accumulate
+				cp1->normalImpulse = x.x;
+				cp2->normalImpulse = x.y;
 
-				// Apply contact impulse
-				b2Vec2 P = lambda * normal;
-				vA -= mA * P;
-				wA -= iA * b2Cross(vcp->rA, P);
+#if B2_DEBUG_SOLVER == 1
+				// Postconditions
+				dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
+				dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
 
-				vB += mB * P;
-				wB += iB * b2Cross(vcp->rB, P);
+				// Compute normal velocity
+				vn1 = b2Dot(dv1, normal);
+				vn2 = b2Dot(dv2, normal);
+
+				b2Assert(b2Abs(vn1 - cp1->velocityBias) < k_errorTol);
+				b2Assert(b2Abs(vn2 - cp2->velocityBias) < k_errorTol);
+#endif
+				break;
 			}
-		}
-		else
-		{
-			// Block solver developed in collaboration with Dirk Gregorius (back in 01/07 on Box2D_Lite).
-			// Build the mini LCP for this contact patch
-			//
-			// vn = A * x + b, vn >= 0, , vn >= 0, x >= 0 and vn_i * x_i = 0 with i = 1..2
-			//
-			// A = J * W * JT and J = ( -n, -r1 x n, n, r2 x n )
-			// b = vn0 - velocityBias
-			//
-			// The system is solved using the "Total enumeration method" (s. Murty). The complementary constraint vn_i * x_i
-			// implies that we must have in any solution either vn_i = 0 or x_i = 0. So for the 2D contact problem the cases
-			// vn1 = 0 and vn2 = 0, x1 = 0 and x2 = 0, x1 = 0 and vn2 = 0, x2 = 0 and vn1 = 0 need to be tested. The first valid
-			// solution that satisfies the problem is chosen.
-			// 
-			// In order to account of the accumulated impulse 'a' (because of the iterative nature of the solver which only requires
-			// that the accumulated impulse is clamped and not the incremental impulse) we change the impulse variable (x_i).
+
 			//
-			// Substitute:
-			// 
-			// x = a + d
-			// 
-			// a := old total impulse
-			// x := new total impulse
-			// d := incremental impulse 
+			// Case 2: vn1 = 0 and x2 = 0
 			//
-			// For the current iteration we extend the formula for the incremental impulse
-			// to compute the new total impulse:
+			//   0 = a11 * x1 + a12 * 0 + b1' 
+			// vn2 = a21 * x1 + a22 * 0 + b2'
 			//
-			// vn = A * d + b
-			//    = A * (x - a) + b
-			//    = A * x + b - A * a
-			//    = A * x + b'
-			// b' = b - A * a;
+			x.x = - cp1->normalMass * b.x;
+			x.y = 0.0f;
+			vn1 = 0.0f;
+			vn2 = vc->K.ex.y * x.x + b.y;
 
-			b2VelocityConstraintPoint* cp1 = vc->points + 0;
-			b2VelocityConstraintPoint* cp2 = vc->points + 1;
+			if (x.x >= 0.0f && vn2 >= 0.0f)
+			{
+				// Get the incremental impulse
+				b2Vec2 d = x - a;
 
-			b2Vec2 a(cp1->normalImpulse, cp2->normalImpulse);
-			b2Assert(a.x >= 0.0f && a.y >= 0.0f);
+				// Apply incremental impulse
+				b2Vec2 P1 = d.x * normal;
+				b2Vec2 P2 = d.y * normal;
+				vA -= mA * (P1 + P2);
+				wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
 
-			// Relative velocity at contact
-			b2Vec2 dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
-			b2Vec2 dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
+				vB += mB * (P1 + P2);
+				wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
 
-			// Compute normal velocity
-			float32 vn1 = b2Dot(dv1, normal);
-			float32 vn2 = b2Dot(dv2, normal);
+				// Accumulate
+				cp1->normalImpulse = x.x;
+				cp2->normalImpulse = x.y;
 
-			b2Vec2 b;
-			b.x = vn1 - cp1->velocityBias;
-			b.y = vn2 - cp2->velocityBias;
+#if B2_DEBUG_SOLVER == 1
+				// Postconditions
+				dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
 
-			// Compute b'
-			b -= b2Mul(vc->K, a);
+				// Compute normal velocity
+				vn1 = b2Dot(dv1, normal);
 
-			const float32 k_errorTol = 1e-3f;
-			B2_NOT_USED(k_errorTol);
+				b2Assert(b2Abs(vn1 - cp1->velocityBias) < k_errorTol);
+#endif
+				break;
+			}
+
+
+			//
+			// Case 3: vn2 = 0 and x1 = 0
+			//
+			// vn1 = a11 * 0 + a12 * x2 + b1' 
+			//   0 = a21 * 0 + a22 * x2 + b2'
+			//
+			x.x = 0.0f;
+			x.y = - cp2->normalMass * b.y;
+			vn1 = vc->K.ey.x * x.y + b.x;
+			vn2 = 0.0f;
 
-			for (;;)
+			if (x.y >= 0.0f && vn1 >= 0.0f)
 			{
-				//
-				// Case 1: vn = 0
-				//
-				// 0 = A * x + b'
-				//
-				// Solve for x:
-				//
-				// x = - inv(A) * b'
-				//
-				b2Vec2 x = - b2Mul(vc->normalMass, b);
-
-				if (x.x >= 0.0f && x.y >= 0.0f)
-				{
-					// Get the incremental impulse
-					b2Vec2 d = x - a;
-
-					// Apply incremental impulse
-					b2Vec2 P1 = d.x * normal;
-					b2Vec2 P2 = d.y * normal;
-					vA -= mA * (P1 + P2);
-					wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
-
-					vB += mB * (P1 + P2);
-					wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
-
-					// Accumulate
-					cp1->normalImpulse = x.x;
-					cp2->normalImpulse = x.y;
+				// Resubstitute for the incremental impulse
+				b2Vec2 d = x - a;
 
-#if B2_DEBUG_SOLVER == 1
-					// Postconditions
-					dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
-					dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
+				// Apply incremental impulse
+				b2Vec2 P1 = d.x * normal;
+				b2Vec2 P2 = d.y * normal;
+				vA -= mA * (P1 + P2);
+				wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
 
-					// Compute normal velocity
-					vn1 = b2Dot(dv1, normal);
-					vn2 = b2Dot(dv2, normal);
+				vB += mB * (P1 + P2);
+				wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
 
-					b2Assert(b2Abs(vn1 - cp1->velocityBias) < k_errorTol);
-					b2Assert(b2Abs(vn2 - cp2->velocityBias) < k_errorTol);
-#endif
-					break;
-				}
-
-				//
-				// Case 2: vn1 = 0 and x2 = 0
-				//
-				//   0 = a11 * x1 + a12 * 0 + b1' 
-				// vn2 = a21 * x1 + a22 * 0 + b2'
-				//
-				x.x = - cp1->normalMass * b.x;
-				x.y = 0.0f;
-				vn1 = 0.0f;
-				vn2 = vc->K.ex.y * x.x + b.y;
-
-				if (x.x >= 0.0f && vn2 >= 0.0f)
-				{
-					// Get the incremental impulse
-					b2Vec2 d = x - a;
-
-					// Apply incremental impulse
-					b2Vec2 P1 = d.x * normal;
-					b2Vec2 P2 = d.y * normal;
-					vA -= mA * (P1 + P2);
-					wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
-
-					vB += mB * (P1 + P2);
-					wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
-
-					// Accumulate
-					cp1->normalImpulse = x.x;
-					cp2->normalImpulse = x.y;
+				// Accumulate
+				cp1->normalImpulse = x.x;
+				cp2->normalImpulse = x.y;
 
 #if B2_DEBUG_SOLVER == 1
-					// Postconditions
-					dv1 = vB + b2Cross(wB, cp1->rB) - vA - b2Cross(wA, cp1->rA);
+				// Postconditions
+				dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
 
-					// Compute normal velocity
-					vn1 = b2Dot(dv1, normal);
+				// Compute normal velocity
+				vn2 = b2Dot(dv2, normal);
 
-					b2Assert(b2Abs(vn1 - cp1->velocityBias) < k_errorTol);
+				b2Assert(b2Abs(vn2 - cp2->velocityBias) < k_errorTol);
 #endif
-					break;
-				}
-
-
-				//
-				// Case 3: vn2 = 0 and x1 = 0
-				//
-				// vn1 = a11 * 0 + a12 * x2 + b1' 
-				//   0 = a21 * 0 + a22 * x2 + b2'
-				//
-				x.x = 0.0f;
-				x.y = - cp2->normalMass * b.y;
-				vn1 = vc->K.ey.x * x.y + b.x;
-				vn2 = 0.0f;
-
-				if (x.y >= 0.0f && vn1 >= 0.0f)
-				{
-					// Resubstitute for the incremental impulse
-					b2Vec2 d = x - a;
-
-					// Apply incremental impulse
-					b2Vec2 P1 = d.x * normal;
-					b2Vec2 P2 = d.y * normal;
-					vA -= mA * (P1 + P2);
-					wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
-
-					vB += mB * (P1 + P2);
-					wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
-
-					// Accumulate
-					cp1->normalImpulse = x.x;
-					cp2->normalImpulse = x.y;
+				break;
+			}
 
-#if B2_DEBUG_SOLVER == 1
-					// Postconditions
-					dv2 = vB + b2Cross(wB, cp2->rB) - vA - b2Cross(wA, cp2->rA);
+			//
+			// Case 4: x1 = 0 and x2 = 0
+			// 
+			// vn1 = b1
+			// vn2 = b2;
+			x.x = 0.0f;
+			x.y = 0.0f;
+			vn1 = b.x;
+			vn2 = b.y;
+
+			if (vn1 >= 0.0f && vn2 >= 0.0f )
+			{
+				// Resubstitute for the incremental impulse
+				b2Vec2 d = x - a;
 
-					// Compute normal velocity
-					vn2 = b2Dot(dv2, normal);
+				// Apply incremental impulse
+				b2Vec2 P1 = d.x * normal;
+				b2Vec2 P2 = d.y * normal;
+				vA -= mA * (P1 + P2);
+				wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
+
+				vB += mB * (P1 + P2);
+				wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
+
+				// Accumulate
+				cp1->normalImpulse = x.x;
+				cp2->normalImpulse = x.y;
 
-					b2Assert(b2Abs(vn2 - cp2->velocityBias) < k_errorTol);
-#endif
-					break;
-				}
-
-				//
-				// Case 4: x1 = 0 and x2 = 0
-				// 
-				// vn1 = b1
-				// vn2 = b2;
-				x.x = 0.0f;
-				x.y = 0.0f;
-				vn1 = b.x;
-				vn2 = b.y;
-
-				if (vn1 >= 0.0f && vn2 >= 0.0f )
-				{
-					// Resubstitute for the incremental impulse
-					b2Vec2 d = x - a;
-
-					// Apply incremental impulse
-					b2Vec2 P1 = d.x * normal;
-					b2Vec2 P2 = d.y * normal;
-					vA -= mA * (P1 + P2);
-					wA -= iA * (b2Cross(cp1->rA, P1) + b2Cross(cp2->rA, P2));
-
-					vB += mB * (P1 + P2);
-					wB += iB * (b2Cross(cp1->rB, P1) + b2Cross(cp2->rB, P2));
-
-					// Accumulate
-					cp1->normalImpulse = x.x;
-					cp2->normalImpulse = x.y;
-
-					break;
-				}
-
-				// No solution, give up. This is hit sometimes, but it doesn't seem to matter.
 				break;
 			}
-		}
 
-		m_velocities[indexA].v = vA;
-		m_velocities[indexA].w = wA;
-		m_velocities[indexB].v = vB;
-		m_velocities[indexB].w = wB;
+			// No solution, give up. This is hit sometimes, but it doesn't seem to matter.
+			break;
+		}
 	}
+
+	m_velocities[indexA].v = vA;
+	m_velocities[indexA].w = wA;
+	m_velocities[indexB].v = vB;
+	m_velocities[indexB].w = wB;
 }
 
 void b2ContactSolver::StoreImpulses()
 {
+	if (m_wideConstraints)
+	{
+		StoreWideImpulses();
+	}
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
@@ -672,78 +982,108 @@ bool b2ContactSolver::SolvePositionConstraints()
 {
 	float32 minSeparation = 0.0f;
 
+#ifdef B2_SIMD_X86
+	if (m_wideCount > 0)
+	{
+		if (m_simd == b2_simdAVX2)
+		{
+			minSeparation = b2SolvePositionConstraintsAVX2(m_wideConstraints, m_wideCount, m_positions);
+		}
+		else
+		{
+			minSeparation = b2SolvePositionConstraintsSSE2(m_wideConstraints, m_wideCount, m_positions);
+		}
+
+		for (int32 i = 0; i < m_scalarCount; ++i)
+		{
+			minSeparation = b2Min(minSeparation, SolvePositionConstraint(m_positionConstraints + m_scalarConstraints[i]));
+		}
+
+		// We can't expect minSpeparation >= -b2_linearSlop because we don't
+		// push the separation above -b2_linearSlop.
+		return minSeparation >= -3.0f * b2_linearSlop;
+	}
+#endif
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
-		b2ContactPositionConstraint* pc = m_positionConstraints + i;
+		minSeparation = b2Min(minSeparation, SolvePositionConstraint(m_positionConstraints + i));
+	}
 
-		int32 indexA = pc->indexA;
-		int32 indexB = pc->indexB;
-		b2Vec2 localCenterA = pc->localCenterA;
-		float32 mA = pc->invMassA;
-		float32 iA = pc->invIA;
-		b2Vec2 localCenterB = pc->localCenterB;
-		float32 mB = pc->invMassB;
-		float32 iB = pc->invIB;
-		int32 pointCount = pc->pointCount;
+	// We can't expect minSpeparation >= -b2_linearSlop because we don't
+	// push the separation above -b2_linearSlop.
+	return minSeparation >= -3.0f * b2_linearSlop;
+}
 
-		b2Vec2 cA = m_positions[indexA].c;
-		float32 aA = m_positions[indexA].a;
+float32 b2ContactSolver::SolvePositionConstraint(b2ContactPositionConstraint* pc)
+{
+	float32 minSeparation = 0.0f;
 
-		b2Vec2 cB = m_positions[indexB].c;
-		float32 aB = m_positions[indexB].a;
+	int32 indexA = pc->indexA;
+	int32 indexB = pc->indexB;
+	b2Vec2 localCenterA = pc->localCenterA;
+	float32 mA = pc->invMassA;
+	float32 iA = pc->invIA;
+	b2Vec2 localCenterB = pc->localCenterB;
+	float32 mB = pc->invMassB;
+	float32 iB = pc->invIB;
+	int32 pointCount = pc->pointCount;
 
-		// Solve normal constraints
-		for (int32 j = 0; j < pointCount; ++j)
-		{
-			b2Transform xfA, xfB;
-			xfA.q.Set(aA);
-			xfB.q.Set(aB);
-			xfA.p = cA - b2Mul(xfA.q, localCenterA);
-			xfB.p = cB - b2Mul(xfB.q, localCenterB);
+	b2Vec2 cA = m_positions[indexA].c;
+	float32 aA = m_positions[indexA].a;
 
-			b2PositionSolverManifold psm;
-			psm.Initialize(pc, xfA, xfB, j);
-			b2Vec2 normal = psm.normal;
+	b2Vec2 cB = m_positions[indexB].c;
+	float32 aB = m_positions[indexB].a;
 
-			b2Vec2 point = psm.point;
-			float32 separation = psm.separation;
+	// Solve normal constraints
+	for (int32 j = 0; j < pointCount; ++j)
+	{
+		b2Transform xfA, xfB;
+		xfA.q.Set(aA);
+		xfB.q.Set(aB);
+		xfA.p = cA - b2Mul(xfA.q, localCenterA);
+		xfB.p = cB - b2Mul(xfB.q, localCenterB);
 
-			b2Vec2 rA = point - cA;
-			b2Vec2 rB = point - cB;
+		b2PositionSolverManifold psm;
+		psm.Initialize(pc, xfA, xfB, j);
+		b2Vec2 normal = psm.normal;
 
-			// Track max constraint error.
-			minSeparation = b2Min(minSeparation, separation);
+		b2Vec2 point = psm.point;
+		float32 separation = psm.separation;
 
-			// Prevent large corrections and allow slop.
-			float32 C = b2Clamp(b2_baumgarte * (separation + b2_linearSlop), -b2_maxLinearCorrection, 0.0f);
+		b2Vec2 rA = point - cA;
+		b2Vec2 rB = point - cB;
 
-			// Compute the effective mass.
-			float32 rnA = b2Cross(rA, normal);
-			float32 rnB = b2Cross(rB, normal);
-			float32 K = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
+		// Track max constraint error.
+		minSeparation = b2Min(minSeparation, separation);
 
-			// Compute normal impulse
-			float32 impulse = K > 0.0f ? - C / K : 0.0f;
+		// Prevent large corrections and allow slop.
+		float32 C = b2Clamp(b2_baumgarte * (separation + b2_linearSlop), -b2_maxLinearCorrection, 0.0f);
 
-			b2Vec2 P = impulse * normal;
+		// Compute the effective mass.
+		float32 rnA = b2Cross(rA, normal);
+		float32 rnB = b2Cross(rB, normal);
+		float32 K = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
 
-			cA -= mA * P;
-			aA -= iA * b2Cross(rA, P);
+		// Compute normal impulse
+		float32 impulse = K > 0.0f ? - C / K : 0.0f;
 
-			cB += mB * P;
-			aB += iB * b2Cross(rB, P);
-		}
+		b2Vec2 P = impulse * normal;
 
-		m_positions[indexA].c = cA;
-		m_positions[indexA].a = aA;
+		cA -= mA * P;
+		aA -= iA * b2Cross(rA, P);
 
-		m_positions[indexB].c = cB;
-		m_positions[indexB].a = aB;
+		cB += mB * P;
+		aB += iB * b2Cross(rB, P);
 	}
 
-	// We can't expect minSpeparation >= -b2_linearSlop because we don't
-	// push the separation above -b2_linearSlop.
-	return minSeparation >= -3.0f * b2_linearSlop;
+	m_positions[indexA].c = cA;
+	m_positions[indexA].a = aA;
+
+	m_positions[indexB].c = cB;
+	m_positions[indexB].a = aB;
+
+	return minSeparation;
 }
 
 // Sequential position solver for position constraints.
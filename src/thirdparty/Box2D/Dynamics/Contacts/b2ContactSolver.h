@@ -22,6 +22,7 @@
 #include <Box2D/Common/b2Math.h>
 #include <Box2D/Collision/b2Collision.h>
 #include <Box2D/Dynamics/b2TimeStep.h>
+#include <Box2D/Dynamics/Contacts/b2ContactSolverWide.h>
 
 class b2Contact;
 class b2Body;
@@ -64,6 +65,7 @@ struct b2ContactSolverDef
 	b2Position* positions;
 	b2Velocity* velocities;
 	b2StackAllocator* allocator;
+	b2StaticBodyIndices statics;
 };
 
 class b2ContactSolver
@@ -81,6 +83,12 @@ public:
 	bool SolvePositionConstraints();
 	bool SolveTOIPositionConstraints(int32 toiIndexA, int32 toiIndexB);
 
+	void SolveVelocityConstraint(b2ContactVelocityConstraint* vc);
+	float32 SolvePositionConstraint(b2ContactPositionConstraint* pc);
+
+	void InitializeWideConstraints();
+	void StoreWideImpulses();
+
 	b2TimeStep m_step;
 	b2Position* m_positions;
 	b2Velocity* m_velocities;
@@ -89,6 +97,13 @@ public:
 	b2ContactVelocityConstraint* m_velocityConstraints;
 	b2Contact** m_contacts;
 	int m_count;
+
+	// Batches of constraints solved with simd, the remaining constraints are solved one by one.
+	b2SimdMode m_simd;
+	b2WideContactConstraint* m_wideConstraints;
+	int32 m_wideCount;
+	int32* m_scalarConstraints;
+	int32 m_scalarCount;
 };
 
 #endif
@@ -0,0 +1,67 @@
+#include <Box2D/Dynamics/Contacts/b2ContactSolverWide.h>
+
+#ifdef B2_SIMD_X86
+
+#include <immintrin.h>
+
+// Only the code below is compiled for AVX2, it is called after checking the cpu supports it.
+// All headers are included above so none of their inline functions are compiled for AVX2.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace
+{
+
+const int32 b2_laneCount = 8;
+
+struct b2FloatW
+{
+	__m256 v;
+};
+
+inline b2FloatW operator+(b2FloatW a, b2FloatW b) { return { _mm256_add_ps(a.v, b.v) }; }
+inline b2FloatW operator-(b2FloatW a, b2FloatW b) { return { _mm256_sub_ps(a.v, b.v) }; }
+inline b2FloatW operator*(b2FloatW a, b2FloatW b) { return { _mm256_mul_ps(a.v, b.v) }; }
+inline b2FloatW operator/(b2FloatW a, b2FloatW b) { return { _mm256_div_ps(a.v, b.v) }; }
+
+inline b2FloatW b2ZeroW() { return { _mm256_setzero_ps() }; }
+inline b2FloatW b2SplatW(float32 a) { return { _mm256_set1_ps(a) }; }
+inline b2FloatW b2LoadW(const float32* p) { return { _mm256_loadu_ps(p) }; }
+inline void b2StoreW(float32* p, b2FloatW a) { _mm256_storeu_ps(p, a.v); }
+
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b) { return { _mm256_min_ps(a.v, b.v) }; }
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b) { return { _mm256_max_ps(a.v, b.v) }; }
+inline b2FloatW b2SqrtW(b2FloatW a) { return { _mm256_sqrt_ps(a.v) }; }
+inline b2FloatW b2TruncW(b2FloatW a) { return { _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a.v)) }; }
+
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+inline b2FloatW b2LessW(b2FloatW a, b2FloatW b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b) { return { _mm256_and_ps(a.v, b.v) }; }
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+
+}
+
+#include <Box2D/Dynamics/Contacts/b2ContactSolverWide.inl>
+
+void b2SolveVelocityConstraintsAVX2(b2WideContactConstraint* constraints, int32 count, b2Velocity* velocities)
+{
+	b2SolveVelocityConstraintsWide(constraints, count, velocities);
+}
+
+float32 b2SolvePositionConstraintsAVX2(const b2WideContactConstraint* constraints, int32 count, b2Position* positions)
+{
+	return b2SolvePositionConstraintsWide(constraints, count, positions);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
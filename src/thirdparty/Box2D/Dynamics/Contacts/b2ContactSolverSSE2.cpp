@@ -0,0 +1,52 @@
+#include <Box2D/Dynamics/Contacts/b2ContactSolverWide.h>
+
+#ifdef B2_SIMD_X86
+
+#include <emmintrin.h>
+
+namespace
+{
+
+const int32 b2_laneCount = 4;
+
+struct b2FloatW
+{
+	__m128 v;
+};
+
+inline b2FloatW operator+(b2FloatW a, b2FloatW b) { return { _mm_add_ps(a.v, b.v) }; }
+inline b2FloatW operator-(b2FloatW a, b2FloatW b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline b2FloatW operator*(b2FloatW a, b2FloatW b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline b2FloatW operator/(b2FloatW a, b2FloatW b) { return { _mm_div_ps(a.v, b.v) }; }
+
+inline b2FloatW b2ZeroW() { return { _mm_setzero_ps() }; }
+inline b2FloatW b2SplatW(float32 a) { return { _mm_set1_ps(a) }; }
+inline b2FloatW b2LoadW(const float32* p) { return { _mm_loadu_ps(p) }; }
+inline void b2StoreW(float32* p, b2FloatW a) { _mm_storeu_ps(p, a.v); }
+
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b) { return { _mm_min_ps(a.v, b.v) }; }
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b) { return { _mm_max_ps(a.v, b.v) }; }
+inline b2FloatW b2SqrtW(b2FloatW a) { return { _mm_sqrt_ps(a.v) }; }
+inline b2FloatW b2TruncW(b2FloatW a) { return { _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v)) }; }
+
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline b2FloatW b2LessW(b2FloatW a, b2FloatW b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b) { return { _mm_and_ps(a.v, b.v) }; }
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+
+}
+
+#include <Box2D/Dynamics/Contacts/b2ContactSolverWide.inl>
+
+void b2SolveVelocityConstraintsSSE2(b2WideContactConstraint* constraints, int32 count, b2Velocity* velocities)
+{
+	b2SolveVelocityConstraintsWide(constraints, count, velocities);
+}
+
+float32 b2SolvePositionConstraintsSSE2(const b2WideContactConstraint* constraints, int32 count, b2Position* positions)
+{
+	return b2SolvePositionConstraintsWide(constraints, count, positions);
+}
+
+#endif
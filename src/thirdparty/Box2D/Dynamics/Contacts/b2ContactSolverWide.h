@@ -0,0 +1,93 @@
+#ifndef B2_CONTACT_SOLVER_WIDE_H
+#define B2_CONTACT_SOLVER_WIDE_H
+
+#include <Box2D/Common/b2Settings.h>
+#include <Box2D/Dynamics/b2TimeStep.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define B2_SIMD_X86
+#endif
+
+/// Instruction sets the contact solver can use to solve constraints in batches.
+enum b2SimdMode
+{
+	b2_simdNone,
+	b2_simdSSE2,
+	b2_simdAVX2
+};
+
+/// The instruction set used by the contact solver. It is detected at startup,
+/// set it to b2_simdNone to solve all constraints one by one.
+extern b2SimdMode g_contactSolverSimd;
+
+/// Get the best instruction set supported by this cpu.
+b2SimdMode b2DetectSimdMode();
+
+/// The number of constraints in a batch.
+const int32 b2_simdWidth = 8;
+
+/// This is an internal structure.
+/// Contact constraints in structure of arrays layout. No dynamic body is used by more
+/// than one constraint of a batch, so all lanes of a batch are solved at the same time.
+/// SSE2 solves a batch as two halves, AVX2 in one go; both give the same results.
+struct b2WideContactConstraint
+{
+	// Unused lanes have a constraint and body index of -1 and no mass.
+	int32 constraintIndex[b2_simdWidth];
+	int32 indexA[b2_simdWidth];
+	int32 indexB[b2_simdWidth];
+	float32 invMassA[b2_simdWidth];
+	float32 invIA[b2_simdWidth];
+	float32 invMassB[b2_simdWidth];
+	float32 invIB[b2_simdWidth];
+
+	// Velocity constraints, the second point of single point constraints has no mass.
+	float32 normalX[b2_simdWidth];
+	float32 normalY[b2_simdWidth];
+	float32 friction[b2_simdWidth];
+	float32 tangentSpeed[b2_simdWidth];
+	float32 blockSolve[b2_simdWidth];
+	float32 K11[b2_simdWidth];
+	float32 K12[b2_simdWidth];
+	float32 K22[b2_simdWidth];
+	float32 normalMass11[b2_simdWidth];
+	float32 normalMass12[b2_simdWidth];
+	float32 normalMass22[b2_simdWidth];
+
+	float32 rAx[b2_maxManifoldPoints][b2_simdWidth];
+	float32 rAy[b2_maxManifoldPoints][b2_simdWidth];
+	float32 rBx[b2_maxManifoldPoints][b2_simdWidth];
+	float32 rBy[b2_maxManifoldPoints][b2_simdWidth];
+	float32 normalMass[b2_maxManifoldPoints][b2_simdWidth];
+	float32 tangentMass[b2_maxManifoldPoints][b2_simdWidth];
+	float32 velocityBias[b2_maxManifoldPoints][b2_simdWidth];
+	float32 normalImpulse[b2_maxManifoldPoints][b2_simdWidth];
+	float32 tangentImpulse[b2_maxManifoldPoints][b2_simdWidth];
+
+	// Position constraints
+	float32 localCenterAx[b2_simdWidth];
+	float32 localCenterAy[b2_simdWidth];
+	float32 localCenterBx[b2_simdWidth];
+	float32 localCenterBy[b2_simdWidth];
+	float32 localNormalX[b2_simdWidth];
+	float32 localNormalY[b2_simdWidth];
+	float32 localPointX[b2_simdWidth];
+	float32 localPointY[b2_simdWidth];
+	float32 localPointsX[b2_maxManifoldPoints][b2_simdWidth];
+	float32 localPointsY[b2_maxManifoldPoints][b2_simdWidth];
+	float32 radiusA[b2_simdWidth];
+	float32 radiusB[b2_simdWidth];
+	float32 circles[b2_simdWidth];
+	float32 faceB[b2_simdWidth];
+	float32 pointCount[b2_simdWidth];
+};
+
+#ifdef B2_SIMD_X86
+void b2SolveVelocityConstraintsSSE2(b2WideContactConstraint* constraints, int32 count, b2Velocity* velocities);
+float32 b2SolvePositionConstraintsSSE2(const b2WideContactConstraint* constraints, int32 count, b2Position* positions);
+
+void b2SolveVelocityConstraintsAVX2(b2WideContactConstraint* constraints, int32 count, b2Velocity* velocities);
+float32 b2SolvePositionConstraintsAVX2(const b2WideContactConstraint* constraints, int32 count, b2Position* positions);
+#endif
+
+#endif
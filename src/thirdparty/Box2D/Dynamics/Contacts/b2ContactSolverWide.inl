@@ -0,0 +1,475 @@
+// Contact solver for batches of b2WideContactConstraint, written once for all instruction sets.
+// Included by b2ContactSolverSSE2.cpp and b2ContactSolverAVX2.cpp after they define
+//
+//    b2FloatW                           a vector of b2_laneCount floats
+//    + - * /                            lane wise arithmetic
+//    b2ZeroW, b2SplatW                  constants
+//    b2LoadW, b2StoreW                  unaligned loads and stores
+//    b2MinW, b2MaxW, b2SqrtW, b2TruncW  lane wise math
+//    b2GreaterW, b2GreaterEqualW,
+//    b2LessW, b2AndW                    masks
+//    b2SelectW(mask, a, b)              a where mask is set, otherwise b
+//
+// The operations match the scalar solver in b2ContactSolver.cpp one to one, so the results are the
+// same as solving the constraints of a batch one after another. Nothing from other headers is used
+// here since this code may be compiled for an instruction set the rest of the program doesn't use.
+
+namespace
+{
+
+// Cephes single precision sine and cosine, accurate for |x| < 8192.
+void b2SinCosW(b2FloatW x, b2FloatW* sine, b2FloatW* cosine)
+{
+	const b2FloatW zero = b2ZeroW();
+	const b2FloatW one = b2SplatW(1.0f);
+
+	b2FloatW ax = b2MaxW(x, zero - x);
+
+	// Octant of |x|, rounded up to an even number.
+	b2FloatW j = b2TruncW(ax * b2SplatW(1.27323954473516f));
+	b2FloatW odd = b2GreaterW(j - b2SplatW(2.0f) * b2TruncW(j * b2SplatW(0.5f)), b2SplatW(0.5f));
+	j = j + b2SelectW(odd, one, zero);
+	b2FloatW q = j - b2SplatW(8.0f) * b2TruncW(j * b2SplatW(0.125f));
+
+	// Extended precision modular arithmetic.
+	ax = ax - j * b2SplatW(0.78515625f);
+	ax = ax - j * b2SplatW(2.4187564849853515625e-4f);
+	ax = ax - j * b2SplatW(3.77489497744594108e-8f);
+	b2FloatW z = ax * ax;
+
+	b2FloatW c = b2SplatW(2.443315711809948e-5f);
+	c = c * z - b2SplatW(1.388731625493765e-3f);
+	c = c * z + b2SplatW(4.166664568298827e-2f);
+	c = c * z * z - b2SplatW(0.5f) * z + one;
+
+	b2FloatW s = b2SplatW(-1.9515295891e-4f);
+	s = s * z + b2SplatW(8.3321608736e-3f);
+	s = s * z - b2SplatW(1.6666654611e-1f);
+	s = s * z * ax + ax;
+
+	// Octants 2 and 6 swap sine and cosine.
+	b2FloatW swap = b2GreaterW(q - b2SplatW(4.0f) * b2TruncW(q * b2SplatW(0.25f)), one);
+	b2FloatW sinAbs = b2SelectW(swap, c, s);
+	b2FloatW cosAbs = b2SelectW(swap, s, c);
+
+	sinAbs = b2SelectW(b2GreaterW(q, b2SplatW(3.0f)), zero - sinAbs, sinAbs);
+	cosAbs = b2SelectW(b2AndW(b2GreaterW(q, one), b2LessW(q, b2SplatW(5.0f))), zero - cosAbs, cosAbs);
+
+	*sine = b2SelectW(b2LessW(x, zero), zero - sinAbs, sinAbs);
+	*cosine = cosAbs;
+}
+
+void b2SolveVelocityLanes(b2WideContactConstraint* wc, int32 lane, b2Velocity* velocities)
+{
+	const int32* indexA = wc->indexA + lane;
+	const int32* indexB = wc->indexB + lane;
+
+	float32 state[6][b2_simdWidth];
+	for (int32 i = 0; i < b2_laneCount; ++i)
+	{
+		const b2Velocity* velocityA = indexA[i] >= 0 ? velocities + indexA[i] : nullptr;
+		const b2Velocity* velocityB = indexB[i] >= 0 ? velocities + indexB[i] : nullptr;
+		state[0][i] = velocityA ? velocityA->v.x : 0.0f;
+		state[1][i] = velocityA ? velocityA->v.y : 0.0f;
+		state[2][i] = velocityA ? velocityA->w : 0.0f;
+		state[3][i] = velocityB ? velocityB->v.x : 0.0f;
+		state[4][i] = velocityB ? velocityB->v.y : 0.0f;
+		state[5][i] = velocityB ? velocityB->w : 0.0f;
+	}
+
+	b2FloatW vAx = b2LoadW(state[0]);
+	b2FloatW vAy = b2LoadW(state[1]);
+	b2FloatW wA = b2LoadW(state[2]);
+	b2FloatW vBx = b2LoadW(state[3]);
+	b2FloatW vBy = b2LoadW(state[4]);
+	b2FloatW wB = b2LoadW(state[5]);
+
+	const b2FloatW zero = b2ZeroW();
+	const b2FloatW mA = b2LoadW(wc->invMassA + lane);
+	const b2FloatW iA = b2LoadW(wc->invIA + lane);
+	const b2FloatW mB = b2LoadW(wc->invMassB + lane);
+	const b2FloatW iB = b2LoadW(wc->invIB + lane);
+
+	const b2FloatW normalX = b2LoadW(wc->normalX + lane);
+	const b2FloatW normalY = b2LoadW(wc->normalY + lane);
+	const b2FloatW tangentX = normalY;
+	const b2FloatW tangentY = zero - normalX;
+	const b2FloatW friction = b2LoadW(wc->friction + lane);
+	const b2FloatW tangentSpeed = b2LoadW(wc->tangentSpeed + lane);
+
+	// Solve tangent constraints first because non-penetration is more important
+	// than friction.
+	for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+	{
+		const b2FloatW rAx = b2LoadW(wc->rAx[j] + lane);
+		const b2FloatW rAy = b2LoadW(wc->rAy[j] + lane);
+		const b2FloatW rBx = b2LoadW(wc->rBx[j] + lane);
+		const b2FloatW rBy = b2LoadW(wc->rBy[j] + lane);
+
+		// Relative velocity at contact
+		b2FloatW dvx = vBx - wB * rBy - vAx + wA * rAy;
+		b2FloatW dvy = vBy + wB * rBx - vAy - wA * rAx;
+
+		// Compute tangent force
+		b2FloatW vt = dvx * tangentX + dvy * tangentY - tangentSpeed;
+		b2FloatW lambda = b2LoadW(wc->tangentMass[j] + lane) * (zero - vt);
+
+		// Clamp the accumulated force
+		b2FloatW oldImpulse = b2LoadW(wc->tangentImpulse[j] + lane);
+		b2FloatW maxFriction = friction * b2LoadW(wc->normalImpulse[j] + lane);
+		b2FloatW newImpulse = b2MaxW(zero - maxFriction, b2MinW(oldImpulse + lambda, maxFriction));
+		lambda = newImpulse - oldImpulse;
+		b2StoreW(wc->tangentImpulse[j] + lane, newImpulse);
+
+		// Apply contact impulse
+		b2FloatW Px = lambda * tangentX;
+		b2FloatW Py = lambda * tangentY;
+
+		vAx = vAx - mA * Px;
+		vAy = vAy - mA * Py;
+		wA = wA - iA * (rAx * Py - rAy * Px);
+
+		vBx = vBx + mB * Px;
+		vBy = vBy + mB * Py;
+		wB = wB + iB * (rBx * Py - rBy * Px);
+	}
+
+	// Solve normal constraints
+	{
+		const b2FloatW r1Ax = b2LoadW(wc->rAx[0] + lane);
+		const b2FloatW r1Ay = b2LoadW(wc->rAy[0] + lane);
+		const b2FloatW r1Bx = b2LoadW(wc->rBx[0] + lane);
+		const b2FloatW r1By = b2LoadW(wc->rBy[0] + lane);
+		const b2FloatW r2Ax = b2LoadW(wc->rAx[1] + lane);
+		const b2FloatW r2Ay = b2LoadW(wc->rAy[1] + lane);
+		const b2FloatW r2Bx = b2LoadW(wc->rBx[1] + lane);
+		const b2FloatW r2By = b2LoadW(wc->rBy[1] + lane);
+
+		const b2FloatW normalMass1 = b2LoadW(wc->normalMass[0] + lane);
+		const b2FloatW normalMass2 = b2LoadW(wc->normalMass[1] + lane);
+		const b2FloatW bias1 = b2LoadW(wc->velocityBias[0] + lane);
+		const b2FloatW bias2 = b2LoadW(wc->velocityBias[1] + lane);
+
+		const b2FloatW a1 = b2LoadW(wc->normalImpulse[0] + lane);
+		const b2FloatW a2 = b2LoadW(wc->normalImpulse[1] + lane);
+
+		// Relative velocity at contact
+		b2FloatW dv1x = vBx - wB * r1By - vAx + wA * r1Ay;
+		b2FloatW dv1y = vBy + wB * r1Bx - vAy - wA * r1Ax;
+		b2FloatW dv2x = vBx - wB * r2By - vAx + wA * r2Ay;
+		b2FloatW dv2y = vBy + wB * r2Bx - vAy - wA * r2Ax;
+
+		// Compute normal velocity
+		b2FloatW vn1 = dv1x * normalX + dv1y * normalY;
+		b2FloatW vn2 = dv2x * normalX + dv2y * normalY;
+
+		// Single point constraints
+		b2FloatW single = b2MaxW(a1 + (zero - normalMass1) * (vn1 - bias1), zero);
+
+		// Two point constraints are solved as a block, see b2ContactSolver::SolveVelocityConstraints.
+		const b2FloatW K11 = b2LoadW(wc->K11 + lane);
+		const b2FloatW K12 = b2LoadW(wc->K12 + lane);
+		const b2FloatW K22 = b2LoadW(wc->K22 + lane);
+		const b2FloatW normalMass11 = b2LoadW(wc->normalMass11 + lane);
+		const b2FloatW normalMass12 = b2LoadW(wc->normalMass12 + lane);
+		const b2FloatW normalMass22 = b2LoadW(wc->normalMass22 + lane);
+
+		// Compute b'
+		b2FloatW bx = vn1 - bias1;
+		b2FloatW by = vn2 - bias2;
+		bx = bx - (K11 * a1 + K12 * a2);
+		by = by - (K12 * a1 + K22 * a2);
+
+		// Case 1: vn = 0
+		b2FloatW x1Case1 = zero - (normalMass11 * bx + normalMass12 * by);
+		b2FloatW x2Case1 = zero - (normalMass12 * bx + normalMass22 * by);
+		b2FloatW case1 = b2AndW(b2GreaterEqualW(x1Case1, zero), b2GreaterEqualW(x2Case1, zero));
+
+		// Case 2: vn1 = 0 and x2 = 0
+		b2FloatW x1Case2 = (zero - normalMass1) * bx;
+		b2FloatW vn2Case2 = K12 * x1Case2 + by;
+		b2FloatW case2 = b2AndW(b2GreaterEqualW(x1Case2, zero), b2GreaterEqualW(vn2Case2, zero));
+
+		// Case 3: vn2 = 0 and x1 = 0
+		b2FloatW x2Case3 = (zero - normalMass2) * by;
+		b2FloatW vn1Case3 = K12 * x2Case3 + bx;
+		b2FloatW case3 = b2AndW(b2GreaterEqualW(x2Case3, zero), b2GreaterEqualW(vn1Case3, zero));
+
+		// Case 4: x1 = 0 and x2 = 0
+		b2FloatW case4 = b2AndW(b2GreaterEqualW(bx, zero), b2GreaterEqualW(by, zero));
+
+		// Take the first case that is valid, keep the impulse if there is none.
+		b2FloatW x1 = b2SelectW(case4, zero, a1);
+		b2FloatW x2 = b2SelectW(case4, zero, a2);
+		x1 = b2SelectW(case3, zero, x1);
+		x2 = b2SelectW(case3, x2Case3, x2);
+		x1 = b2SelectW(case2, x1Case2, x1);
+		x2 = b2SelectW(case2, zero, x2);
+		x1 = b2SelectW(case1, x1Case1, x1);
+		x2 = b2SelectW(case1, x2Case1, x2);
+
+		b2FloatW block = b2GreaterW(b2LoadW(wc->blockSolve + lane), zero);
+		x1 = b2SelectW(block, x1, single);
+		x2 = b2SelectW(block, x2, a2);
+
+		// Get the incremental impulse
+		b2FloatW d1 = x1 - a1;
+		b2FloatW d2 = x2 - a2;
+
+		// Apply incremental impulse
+		b2FloatW P1x = d1 * normalX;
+		b2FloatW P1y = d1 * normalY;
+		b2FloatW P2x = d2 * normalX;
+		b2FloatW P2y = d2 * normalY;
+
+		vAx = vAx - mA * (P1x + P2x);
+		vAy = vAy - mA * (P1y + P2y);
+		wA = wA - iA * ((r1Ax * P1y - r1Ay * P1x) + (r2Ax * P2y - r2Ay * P2x));
+
+		vBx = vBx + mB * (P1x + P2x);
+		vBy = vBy + mB * (P1y + P2y);
+		wB = wB + iB * ((r1Bx * P1y - r1By * P1x) + (r2Bx * P2y - r2By * P2x));
+
+		// Accumulate
+		b2StoreW(wc->normalImpulse[0] + lane, x1);
+		b2StoreW(wc->normalImpulse[1] + lane, x2);
+	}
+
+	b2StoreW(state[0], vAx);
+	b2StoreW(state[1], vAy);
+	b2StoreW(state[2], wA);
+	b2StoreW(state[3], vBx);
+	b2StoreW(state[4], vBy);
+	b2StoreW(state[5], wB);
+
+	for (int32 i = 0; i < b2_laneCount; ++i)
+	{
+		if (indexA[i] >= 0)
+		{
+			b2Velocity* velocityA = velocities + indexA[i];
+			velocityA->v.x = state[0][i];
+			velocityA->v.y = state[1][i];
+			velocityA->w = state[2][i];
+		}
+
+		if (indexB[i] >= 0)
+		{
+			b2Velocity* velocityB = velocities + indexB[i];
+			velocityB->v.x = state[3][i];
+			velocityB->v.y = state[4][i];
+			velocityB->w = state[5][i];
+		}
+	}
+}
+
+float32 b2SolvePositionLanes(const b2WideContactConstraint* wc, int32 lane, b2Position* positions)
+{
+	const int32* indexA = wc->indexA + lane;
+	const int32* indexB = wc->indexB + lane;
+
+	float32 state[6][b2_simdWidth];
+	for (int32 i = 0; i < b2_laneCount; ++i)
+	{
+		const b2Position* positionA = indexA[i] >= 0 ? positions + indexA[i] : nullptr;
+		const b2Position* positionB = indexB[i] >= 0 ? positions + indexB[i] : nullptr;
+		state[0][i] = positionA ? positionA->c.x : 0.0f;
+		state[1][i] = positionA ? positionA->c.y : 0.0f;
+		state[2][i] = positionA ? positionA->a : 0.0f;
+		state[3][i] = positionB ? positionB->c.x : 0.0f;
+		state[4][i] = positionB ? positionB->c.y : 0.0f;
+		state[5][i] = positionB ? positionB->a : 0.0f;
+	}
+
+	b2FloatW cAx = b2LoadW(state[0]);
+	b2FloatW cAy = b2LoadW(state[1]);
+	b2FloatW aA = b2LoadW(state[2]);
+	b2FloatW cBx = b2LoadW(state[3]);
+	b2FloatW cBy = b2LoadW(state[4]);
+	b2FloatW aB = b2LoadW(state[5]);
+
+	const b2FloatW zero = b2ZeroW();
+	const b2FloatW mA = b2LoadW(wc->invMassA + lane);
+	const b2FloatW iA = b2LoadW(wc->invIA + lane);
+	const b2FloatW mB = b2LoadW(wc->invMassB + lane);
+	const b2FloatW iB = b2LoadW(wc->invIB + lane);
+
+	const b2FloatW localCenterAx = b2LoadW(wc->localCenterAx + lane);
+	const b2FloatW localCenterAy = b2LoadW(wc->localCenterAy + lane);
+	const b2FloatW localCenterBx = b2LoadW(wc->localCenterBx + lane);
+	const b2FloatW localCenterBy = b2LoadW(wc->localCenterBy + lane);
+	const b2FloatW localNormalX = b2LoadW(wc->localNormalX + lane);
+	const b2FloatW localNormalY = b2LoadW(wc->localNormalY + lane);
+	const b2FloatW localPointX = b2LoadW(wc->localPointX + lane);
+	const b2FloatW localPointY = b2LoadW(wc->localPointY + lane);
+	const b2FloatW radiusA = b2LoadW(wc->radiusA + lane);
+	const b2FloatW radiusB = b2LoadW(wc->radiusB + lane);
+	const b2FloatW circles = b2GreaterW(b2LoadW(wc->circles + lane), zero);
+	const b2FloatW faceB = b2GreaterW(b2LoadW(wc->faceB + lane), zero);
+	const b2FloatW pointCount = b2LoadW(wc->pointCount + lane);
+
+	b2FloatW minSeparation = zero;
+
+	// Solve normal constraints
+	for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+	{
+		const b2FloatW active = b2GreaterW(pointCount, b2SplatW((float32)j));
+
+		b2FloatW sA, qA, sB, qB;
+		b2SinCosW(aA, &sA, &qA);
+		b2SinCosW(aB, &sB, &qB);
+
+		b2FloatW pAx = cAx - (qA * localCenterAx - sA * localCenterAy);
+		b2FloatW pAy = cAy - (sA * localCenterAx + qA * localCenterAy);
+		b2FloatW pBx = cBx - (qB * localCenterBx - sB * localCenterBy);
+		b2FloatW pBy = cBy - (sB * localCenterBx + qB * localCenterBy);
+
+		const b2FloatW localPointsX = b2LoadW(wc->localPointsX[j] + lane);
+		const b2FloatW localPointsY = b2LoadW(wc->localPointsY[j] + lane);
+
+		// Face manifolds, the reference face is on body B for e_faceB.
+		b2FloatW sRef = b2SelectW(faceB, sB, sA);
+		b2FloatW qRef = b2SelectW(faceB, qB, qA);
+		b2FloatW pRefx = b2SelectW(faceB, pBx, pAx);
+		b2FloatW pRefy = b2SelectW(faceB, pBy, pAy);
+		b2FloatW sInc = b2SelectW(faceB, sA, sB);
+		b2FloatW qInc = b2SelectW(faceB, qA, qB);
+		b2FloatW pIncx = b2SelectW(faceB, pAx, pBx);
+		b2FloatW pIncy = b2SelectW(faceB, pAy, pBy);
+
+		b2FloatW normalX = qRef * localNormalX - sRef * localNormalY;
+		b2FloatW normalY = sRef * localNormalX + qRef * localNormalY;
+		b2FloatW planePointX = (qRef * localPointX - sRef * localPointY) + pRefx;
+		b2FloatW planePointY = (sRef * localPointX + qRef * localPointY) + pRefy;
+		b2FloatW clipPointX = (qInc * localPointsX - sInc * localPointsY) + pIncx;
+		b2FloatW clipPointY = (sInc * localPointsX + qInc * localPointsY) + pIncy;
+		b2FloatW separation = (clipPointX - planePointX) * normalX + (clipPointY - planePointY) * normalY - radiusA - radiusB;
+		b2FloatW pointX = clipPointX;
+		b2FloatW pointY = clipPointY;
+
+		// Ensure normal points from A to B
+		normalX = b2SelectW(faceB, zero - normalX, normalX);
+		normalY = b2SelectW(faceB, zero - normalY, normalY);
+
+		// Circle manifolds
+		const b2FloatW localPoint0X = b2LoadW(wc->localPointsX[0] + lane);
+		const b2FloatW localPoint0Y = b2LoadW(wc->localPointsY[0] + lane);
+		b2FloatW pointAx = (qA * localPointX - sA * localPointY) + pAx;
+		b2FloatW pointAy = (sA * localPointX + qA * localPointY) + pAy;
+		b2FloatW pointBx = (qB * localPoint0X - sB * localPoint0Y) + pBx;
+		b2FloatW pointBy = (sB * localPoint0X + qB * localPoint0Y) + pBy;
+		b2FloatW circleNormalX = pointBx - pointAx;
+		b2FloatW circleNormalY = pointBy - pointAy;
+		b2FloatW length = b2SqrtW(circleNormalX * circleNormalX + circleNormalY * circleNormalY);
+		b2FloatW normalize = b2GreaterEqualW(length, b2SplatW(FLT_EPSILON));
+		b2FloatW invLength = b2SplatW(1.0f) / b2SelectW(normalize, length, b2SplatW(1.0f));
+		circleNormalX = b2SelectW(normalize, circleNormalX * invLength, circleNormalX);
+		circleNormalY = b2SelectW(normalize, circleNormalY * invLength, circleNormalY);
+		b2FloatW circleSeparation = (pointBx - pointAx) * circleNormalX + (pointBy - pointAy) * circleNormalY - radiusA - radiusB;
+
+		normalX = b2SelectW(circles, circleNormalX, normalX);
+		normalY = b2SelectW(circles, circleNormalY, normalY);
+		pointX = b2SelectW(circles, b2SplatW(0.5f) * (pointAx + pointBx), pointX);
+		pointY = b2SelectW(circles, b2SplatW(0.5f) * (pointAy + pointBy), pointY);
+		separation = b2SelectW(circles, circleSeparation, separation);
+
+		b2FloatW rAx = pointX - cAx;
+		b2FloatW rAy = pointY - cAy;
+		b2FloatW rBx = pointX - cBx;
+		b2FloatW rBy = pointY - cBy;
+
+		// Track max constraint error.
+		minSeparation = b2SelectW(active, b2MinW(minSeparation, separation), minSeparation);
+
+		// Prevent large corrections and allow slop.
+		b2FloatW C = b2SplatW(b2_baumgarte) * (separation + b2SplatW(b2_linearSlop));
+		C = b2MaxW(b2SplatW(-b2_maxLinearCorrection), b2MinW(C, zero));
+
+		// Compute the effective mass.
+		b2FloatW rnA = rAx * normalY - rAy * normalX;
+		b2FloatW rnB = rBx * normalY - rBy * normalX;
+		b2FloatW K = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
+
+		// Compute normal impulse
+		b2FloatW solvable = b2AndW(active, b2GreaterW(K, zero));
+		b2FloatW impulse = b2SelectW(solvable, (zero - C) / b2SelectW(solvable, K, b2SplatW(1.0f)), zero);
+
+		b2FloatW Px = impulse * normalX;
+		b2FloatW Py = impulse * normalY;
+
+		cAx = cAx - mA * Px;
+		cAy = cAy - mA * Py;
+		aA = aA - iA * (rAx * Py - rAy * Px);
+
+		cBx = cBx + mB * Px;
+		cBy = cBy + mB * Py;
+		aB = aB + iB * (rBx * Py - rBy * Px);
+	}
+
+	b2StoreW(state[0], cAx);
+	b2StoreW(state[1], cAy);
+	b2StoreW(state[2], aA);
+	b2StoreW(state[3], cBx);
+	b2StoreW(state[4], cBy);
+	b2StoreW(state[5], aB);
+
+	float32 separations[b2_simdWidth];
+	b2StoreW(separations, minSeparation);
+
+	float32 result = 0.0f;
+	for (int32 i = 0; i < b2_laneCount; ++i)
+	{
+		if (indexA[i] >= 0)
+		{
+			b2Position* positionA = positions + indexA[i];
+			positionA->c.x = state[0][i];
+			positionA->c.y = state[1][i];
+			positionA->a = state[2][i];
+		}
+
+		if (indexB[i] >= 0)
+		{
+			b2Position* positionB = positions + indexB[i];
+			positionB->c.x = state[3][i];
+			positionB->c.y = state[4][i];
+			positionB->a = state[5][i];
+		}
+
+		result = separations[i] < result ? separations[i] : result;
+	}
+
+	return result;
+}
+
+void b2SolveVelocityConstraintsWide(b2WideContactConstraint* constraints, int32 count, b2Velocity* velocities)
+{
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2WideContactConstraint* wc = constraints + i;
+
+		// Lanes are filled from the front, skip the lanes that are all unused.
+		for (int32 lane = 0; lane < b2_simdWidth && wc->constraintIndex[lane] >= 0; lane += b2_laneCount)
+		{
+			b2SolveVelocityLanes(wc, lane, velocities);
+		}
+	}
+}
+
+float32 b2SolvePositionConstraintsWide(const b2WideContactConstraint* constraints, int32 count, b2Position* positions)
+{
+	float32 minSeparation = 0.0f;
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		const b2WideContactConstraint* wc = constraints + i;
+
+		for (int32 lane = 0; lane < b2_simdWidth && wc->constraintIndex[lane] >= 0; lane += b2_laneCount)
+		{
+			float32 separation = b2SolvePositionLanes(wc, lane, positions);
+			minSeparation = separation < minSeparation ? separation : minSeparation;
+		}
+	}
+
+	return minSeparation;
+}
+
+}
@@ -130,10 +130,10 @@ b2GearJoint::b2GearJoint(const b2GearJointDef* def)
 
 void b2GearJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
-	m_indexC = m_bodyC->m_islandIndex;
-	m_indexD = m_bodyD->m_islandIndex;
+	m_indexA = b2GetIslandIndex(m_bodyA, data.statics);
+	m_indexB = b2GetIslandIndex(m_bodyB, data.statics);
+	m_indexC = b2GetIslandIndex(m_bodyC, data.statics);
+	m_indexD = b2GetIslandIndex(m_bodyD, data.statics);
 	m_lcA = m_bodyA->m_sweep.localCenter;
 	m_lcB = m_bodyB->m_sweep.localCenter;
 	m_lcC = m_bodyC->m_sweep.localCenter;
@@ -21,6 +21,7 @@
 
 #include <Box2D/Common/b2Math.h>
 #include <Box2D/Collision/Shapes/b2Shape.h>
+#include <Box2D/Dynamics/b2TimeStep.h>
 #include <memory>
 
 class b2Fixture;
@@ -403,6 +404,8 @@ private:
 	friend class b2WeldJoint;
 	friend class b2WheelJoint;
 
+	friend int32 b2GetIslandIndex(const b2Body* body, const b2StaticBodyIndices& statics);
+
 	// m_flags
 	enum
 	{
@@ -466,6 +469,24 @@ private:
 	void* m_userData;
 };
 
+/// This is an internal function.
+/// Get the index of a body within the island that is currently solved.
+inline int32 b2GetIslandIndex(const b2Body* body, const b2StaticBodyIndices& statics)
+{
+	if (body->m_type == b2_staticBody)
+	{
+		for (int32 i = 0; i < statics.count; ++i)
+		{
+			if (statics.bodies[i] == body)
+			{
+				return statics.indices[i];
+			}
+		}
+	}
+
+	return body->m_islandIndex;
+}
+
 inline b2BodyType b2Body::GetType() const
 {
 	return m_type;
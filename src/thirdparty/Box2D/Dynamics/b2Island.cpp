@@ -168,11 +168,69 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+
+	m_statics.bodies = nullptr;
+	m_statics.indices = nullptr;
+	m_statics.count = 0;
+	m_impulses = nullptr;
+	m_parallel = false;
+	m_asleep = false;
+}
+
+b2Island::b2Island(
+	b2Body** bodies, int32 bodyCount,
+	b2Contact** contacts, int32 contactCount,
+	b2Joint** joints, int32 jointCount,
+	const b2StaticBodyIndices& statics,
+	b2ContactImpulse* impulses,
+	b2StackAllocator* allocator)
+{
+	m_bodyCapacity = bodyCount;
+	m_contactCapacity = contactCount;
+	m_jointCapacity = jointCount;
+	m_bodyCount = bodyCount;
+	m_contactCount = contactCount;
+	m_jointCount = jointCount;
+
+	m_allocator = allocator;
+	m_listener = nullptr;
+
+	m_bodies = bodies;
+	m_contacts = contacts;
+	m_joints = joints;
+
+	// A null allocator is used while the island is only built.
+	if (m_allocator)
+	{
+		m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
+		m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+	}
+	else
+	{
+		m_velocities = nullptr;
+		m_positions = nullptr;
+	}
+
+	m_statics = statics;
+	m_impulses = impulses;
+	m_parallel = true;
+	m_asleep = false;
 }
 
 b2Island::~b2Island()
 {
 	// Warning: the order should reverse the constructor order.
+	if (m_parallel)
+	{
+		if (m_allocator)
+		{
+			m_allocator->Free(m_positions);
+			m_allocator->Free(m_velocities);
+		}
+
+		return;
+	}
+
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
 	m_allocator->Free(m_joints);
@@ -197,8 +255,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		float32 w = b->m_angularVelocity;
 
 		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		// Static bodies don't move, they may be shared with other islands solved in parallel.
+		if (m_parallel == false || b->m_type != b2_staticBody)
+		{
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -230,6 +292,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	solverData.step = step;
 	solverData.positions = m_positions;
 	solverData.velocities = m_velocities;
+	solverData.statics = m_statics;
 
 	// Initialize velocity constraints.
 	b2ContactSolverDef contactSolverDef;
@@ -239,6 +302,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
 	contactSolverDef.allocator = m_allocator;
+	contactSolverDef.statics = m_statics;
 
 	b2ContactSolver contactSolver(&contactSolverDef);
 	contactSolver.InitializeVelocityConstraints();
@@ -330,6 +394,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+		if (m_parallel && body->m_type == b2_staticBody)
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -372,9 +441,18 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 		if (minSleepTime >= b2_timeToSleep && positionSolved)
 		{
+			m_asleep = true;
+
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+
+				// The world puts shared static bodies to sleep after all islands are solved.
+				if (m_parallel && b->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
 				b->SetAwake(false);
 			}
 		}
@@ -403,6 +481,7 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 	contactSolverDef.step = subStep;
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.statics = m_statics;
 	b2ContactSolver contactSolver(&contactSolverDef);
 
 	// Solve position constraints.
@@ -466,6 +545,8 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 
 	// Don't store the TOI contact forces for warm starting
 	// because they can be quite large.
+	// The batched solver keeps its impulses in the batches though, copy them back for reporting.
+	contactSolver.StoreWideImpulses();
 
 	float32 h = subStep.dt;
 
@@ -515,6 +596,25 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 
 void b2Island::Report(const b2ContactVelocityConstraint* constraints)
 {
+	// Parallel islands keep the impulses, the world reports them in a deterministic order.
+	if (m_impulses)
+	{
+		for (int32 i = 0; i < m_contactCount; ++i)
+		{
+			const b2ContactVelocityConstraint* vc = constraints + i;
+
+			b2ContactImpulse* impulse = m_impulses + i;
+			impulse->count = vc->pointCount;
+			for (int32 j = 0; j < vc->pointCount; ++j)
+			{
+				impulse->normalImpulses[j] = vc->points[j].normalImpulse;
+				impulse->tangentImpulses[j] = vc->points[j].tangentImpulse;
+			}
+		}
+
+		return;
+	}
+
 	if (m_listener == nullptr)
 	{
 		return;
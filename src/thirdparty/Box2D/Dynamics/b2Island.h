@@ -28,6 +28,7 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
+struct b2ContactImpulse;
 struct b2Profile;
 
 /// This is an internal class.
@@ -36,6 +37,18 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// Wrap an island that has already been built so it can be solved in parallel with other islands.
+	/// The body, contact and joint arrays are not owned by the island. Contact impulses are written
+	/// to 'impulses' instead of being reported to a listener, and static bodies are never written to
+	/// since they may be shared with islands solved at the same time.
+	b2Island(b2Body** bodies, int32 bodyCount,
+			b2Contact** contacts, int32 contactCount,
+			b2Joint** joints, int32 jointCount,
+			const b2StaticBodyIndices& statics,
+			b2ContactImpulse* impulses,
+			b2StackAllocator* allocator);
+
 	~b2Island();
 
 	void Clear()
@@ -88,6 +101,11 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	b2StaticBodyIndices m_statics;
+	b2ContactImpulse* m_impulses;
+	bool m_parallel;
+	bool m_asleep;
 };
 
 #endif
@@ -21,6 +21,8 @@
 
 #include <Box2D/Common/b2Math.h>
 
+class b2Body;
+
 /// Profiling data. Times are in milliseconds.
 struct b2Profile
 {
@@ -59,12 +61,23 @@ struct b2Velocity
 	float32 w;
 };
 
+/// This is an internal structure.
+/// Static bodies can be part of several islands. When islands are solved in parallel
+/// their b2Body::m_islandIndex is not valid, so each island keeps its own lookup table.
+struct b2StaticBodyIndices
+{
+	b2Body* const* bodies;
+	const int32* indices;
+	int32 count;
+};
+
 /// Solver Data
 struct b2SolverData
 {
 	b2TimeStep step;
 	b2Position* positions;
 	b2Velocity* velocities;
+	b2StaticBodyIndices statics;
 };
 
 #endif
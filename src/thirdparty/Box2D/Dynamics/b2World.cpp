@@ -31,9 +31,66 @@
 #include <Box2D/Collision/Shapes/b2PolygonShape.h>
 #include <Box2D/Collision/b2TimeOfImpact.h>
 #include <Box2D/Common/b2Draw.h>
+#include <Box2D/Common/b2ThreadPool.h>
 #include <Box2D/Common/b2Timer.h>
 #include <new>
 
+namespace
+{
+
+// An island built for the parallel solver, the ranges index into the arrays of b2ParallelSolveContext.
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+	int32 staticStart;
+	int32 staticCount;
+	b2Profile profile;
+	bool asleep;
+};
+
+struct b2ParallelSolveContext
+{
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+	b2ThreadPool* threadPool;
+	b2IslandRange* islands;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2Body** staticBodies;
+	int32* staticIndices;
+	b2ContactImpulse* impulses;
+};
+
+void b2SolveIslandTask(void* data, int32 taskIndex, int32 threadIndex)
+{
+	b2ParallelSolveContext* context = (b2ParallelSolveContext*)data;
+	b2IslandRange* range = context->islands + taskIndex;
+
+	b2StaticBodyIndices statics;
+	statics.bodies = context->staticBodies + range->staticStart;
+	statics.indices = context->staticIndices + range->staticStart;
+	statics.count = range->staticCount;
+
+	b2Island island(context->bodies + range->bodyStart, range->bodyCount,
+					context->contacts + range->contactStart, range->contactCount,
+					context->joints + range->jointStart, range->jointCount,
+					statics,
+					context->impulses ? context->impulses + range->contactStart : nullptr,
+					context->threadPool->GetAllocator(threadIndex));
+
+	island.Solve(&range->profile, *context->step, context->gravity, context->allowSleep);
+	range->asleep = island.m_asleep;
+}
+
+}
+
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = nullptr;
@@ -60,11 +117,15 @@ b2World::b2World(const b2Vec2& gravity)
 
 	m_contactManager.m_allocator = &m_blockAllocator;
 
+	m_threadPool = nullptr;
+
 	memset(&m_profile, 0, sizeof(b2Profile));
 }
 
 b2World::~b2World()
 {
+	delete m_threadPool;
+
 	// Some shapes allocate using b2Alloc.
 	b2Body* b = m_bodyList;
 	while (b)
@@ -99,6 +160,28 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetSolverThreadCount(int32 threadCount)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked() || threadCount == GetSolverThreadCount())
+	{
+		return;
+	}
+
+	delete m_threadPool;
+	m_threadPool = nullptr;
+
+	if (threadCount > 1)
+	{
+		m_threadPool = new b2ThreadPool(threadCount);
+	}
+}
+
+int32 b2World::GetSolverThreadCount() const
+{
+	return m_threadPool ? m_threadPool->GetThreadCount() : 1;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	g_debugDraw = debugDraw;
@@ -389,13 +472,6 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
-	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
-					m_contactManager.m_contactCount,
-					m_jointCount,
-					&m_stackAllocator,
-					m_contactManager.m_contactListener);
-
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -410,7 +486,51 @@ void b2World::Solve(const b2TimeStep& step)
 		j->m_islandFlag = false;
 	}
 
-	// Build and simulate all awake islands.
+	if (m_threadPool)
+	{
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Build and simulate all awake islands one after another.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
+	// Size the island for the worst case.
+	b2Island island(m_bodyCount,
+					m_contactManager.m_contactCount,
+					m_jointCount,
+					&m_stackAllocator,
+					m_contactManager.m_contactListener);
+
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
 	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
@@ -433,143 +553,272 @@ void b2World::Solve(const b2TimeStep& step)
 
 		// Reset island and stack.
 		island.Clear();
-		int32 stackCount = 0;
-		stack[stackCount++] = seed;
-		seed->m_flags |= b2Body::e_islandFlag;
+		BuildIsland(seed, &island, stack, stackSize);
 
-		// Perform a depth first search (DFS) on the constraint graph.
-		while (stackCount > 0)
-		{
-			// Grab the next body off the stack and add it to the island.
-			b2Body* b = stack[--stackCount];
-			b2Assert(b->IsActive() == true);
-			island.Add(b);
-
-			// Make sure the body is awake.
-			b->SetAwake(true);
+		b2Profile profile;
+		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		m_profile.solveInit += profile.solveInit;
+		m_profile.solveVelocity += profile.solveVelocity;
+		m_profile.solvePosition += profile.solvePosition;
 
-			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
+		// Post solve cleanup.
+		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		{
+			// Allow static bodies to participate in other islands.
+			b2Body* b = island.m_bodies[i];
 			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->m_flags &= ~b2Body::e_islandFlag;
 			}
+		}
+	}
 
-			// Search all contacts connected to this body.
-			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
-			{
-				b2Contact* contact = ce->contact;
+	m_stackAllocator.Free(stack);
+}
 
-				// Has this contact already been added to an island?
-				if (contact->m_flags & b2Contact::e_islandFlag)
-				{
-					continue;
-				}
+// Build all awake islands on this thread, then solve them on the thread pool.
+// Every thread solves with its own stack allocator. Post-solve callbacks are made
+// afterwards in island order, so the results don't depend on the thread count.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	const int32 contactCount = m_contactManager.m_contactCount;
 
-				// Is this contact solid and touching?
-				if (contact->IsEnabled() == false ||
-					contact->IsTouching() == false)
-				{
-					continue;
-				}
+	// Static bodies can be part of several islands, each of them is reached through a contact or a joint.
+	const int32 staticCapacity = contactCount + m_jointCount;
+	const int32 bodyCapacity = m_bodyCount + staticCapacity;
 
-				// Skip sensors.
-				bool sensorA = contact->m_fixtureA->m_isSensor;
-				bool sensorB = contact->m_fixtureB->m_isSensor;
-				if (sensorA || sensorB)
-				{
-					continue;
-				}
+	b2ContactListener* listener = m_contactManager.m_contactListener;
 
-				island.Add(contact);
-				contact->m_flags |= b2Contact::e_islandFlag;
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(bodyCapacity * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCount * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2Body** staticBodies = (b2Body**)m_stackAllocator.Allocate(staticCapacity * sizeof(b2Body*));
+	int32* staticIndices = (int32*)m_stackAllocator.Allocate(staticCapacity * sizeof(int32));
+	b2ContactImpulse* impulses = (b2ContactImpulse*)m_stackAllocator.Allocate(contactCount * sizeof(b2ContactImpulse));
+	b2IslandRange* islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
 
-				b2Body* other = ce->other;
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
 
-				// Was the other body already added to this island?
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+	int32 islandCount = 0;
+	int32 bodyOffset = 0;
+	int32 contactOffset = 0;
+	int32 jointOffset = 0;
+	int32 staticOffset = 0;
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
-			}
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
 
-			// Search all joints connect to this body.
-			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2StaticBodyIndices noStatics;
+		noStatics.bodies = nullptr;
+		noStatics.indices = nullptr;
+		noStatics.count = 0;
+
+		// Build the island straight into the shared arrays.
+		b2Island island(bodies + bodyOffset, bodyCapacity - bodyOffset,
+						contacts + contactOffset, contactCount - contactOffset,
+						joints + jointOffset, m_jointCount - jointOffset,
+						noStatics,
+						nullptr,
+						nullptr);
+		island.Clear();
+		BuildIsland(seed, &island, stack, stackSize);
+
+		b2IslandRange* range = islands + islandCount;
+		range->bodyStart = bodyOffset;
+		range->bodyCount = island.m_bodyCount;
+		range->contactStart = contactOffset;
+		range->contactCount = island.m_contactCount;
+		range->jointStart = jointOffset;
+		range->jointCount = island.m_jointCount;
+		range->staticStart = staticOffset;
+		range->staticCount = 0;
+		range->asleep = false;
+
+		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		{
+			// Remember where the static bodies are in this island and allow them to participate in other islands.
+			b2Body* b = island.m_bodies[i];
+			if (b->GetType() == b2_staticBody)
 			{
-				if (je->joint->m_islandFlag == true)
-				{
-					continue;
-				}
+				b2Assert(staticOffset < staticCapacity);
+				staticBodies[staticOffset] = b;
+				staticIndices[staticOffset] = i;
+				++staticOffset;
+				++range->staticCount;
 
-				b2Body* other = je->other;
+				b->m_flags &= ~b2Body::e_islandFlag;
+			}
+		}
 
-				// Don't simulate joints connected to inactive bodies.
-				if (other->IsActive() == false)
-				{
-					continue;
-				}
+		bodyOffset += island.m_bodyCount;
+		contactOffset += island.m_contactCount;
+		jointOffset += island.m_jointCount;
+		++islandCount;
+	}
 
-				island.Add(je->joint);
-				je->joint->m_islandFlag = true;
+	b2ParallelSolveContext context;
+	context.step = &step;
+	context.gravity = m_gravity;
+	context.allowSleep = m_allowSleep;
+	context.threadPool = m_threadPool;
+	context.islands = islands;
+	context.bodies = bodies;
+	context.contacts = contacts;
+	context.joints = joints;
+	context.staticBodies = staticBodies;
+	context.staticIndices = staticIndices;
+	context.impulses = listener ? impulses : nullptr;
+
+	m_threadPool->Run(b2SolveIslandTask, &context, islandCount);
+
+	// Merge the results in island order.
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange* range = islands + i;
 
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+		m_profile.solveInit += range->profile.solveInit;
+		m_profile.solveVelocity += range->profile.solveVelocity;
+		m_profile.solvePosition += range->profile.solvePosition;
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
+		if (range->asleep)
+		{
+			for (int32 j = 0; j < range->staticCount; ++j)
+			{
+				staticBodies[range->staticStart + j]->SetAwake(false);
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
-
-		// Post solve cleanup.
-		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		if (listener)
 		{
-			// Allow static bodies to participate in other islands.
-			b2Body* b = island.m_bodies[i];
-			if (b->GetType() == b2_staticBody)
+			for (int32 j = 0; j < range->contactCount; ++j)
 			{
-				b->m_flags &= ~b2Body::e_islandFlag;
+				const int32 index = range->contactStart + j;
+				listener->PostSolve(contacts[index], impulses + index);
 			}
 		}
 	}
 
+	// Warning: the order should reverse the allocation order.
 	m_stackAllocator.Free(stack);
+	m_stackAllocator.Free(islands);
+	m_stackAllocator.Free(impulses);
+	m_stackAllocator.Free(staticIndices);
+	m_stackAllocator.Free(staticBodies);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
+}
 
+// Perform a depth first search (DFS) on the constraint graph starting at the seed.
+void b2World::BuildIsland(b2Body* seed, b2Island* island, b2Body** stack, int32 stackSize)
+{
+	int32 stackCount = 0;
+	stack[stackCount++] = seed;
+	seed->m_flags |= b2Body::e_islandFlag;
+
+	while (stackCount > 0)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		// Grab the next body off the stack and add it to the island.
+		b2Body* b = stack[--stackCount];
+		b2Assert(b->IsActive() == true);
+		island->Add(b);
+
+		// Make sure the body is awake.
+		b->SetAwake(true);
+
+		// To keep islands as small as possible, we don't
+		// propagate islands across static bodies.
+		if (b->GetType() == b2_staticBody)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			continue;
+		}
+
+		// Search all contacts connected to this body.
+		for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+		{
+			b2Contact* contact = ce->contact;
+
+			// Has this contact already been added to an island?
+			if (contact->m_flags & b2Contact::e_islandFlag)
 			{
 				continue;
 			}
 
-			if (b->GetType() == b2_staticBody)
+			// Is this contact solid and touching?
+			if (contact->IsEnabled() == false ||
+				contact->IsTouching() == false)
 			{
 				continue;
 			}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+			// Skip sensors.
+			bool sensorA = contact->m_fixtureA->m_isSensor;
+			bool sensorB = contact->m_fixtureB->m_isSensor;
+			if (sensorA || sensorB)
+			{
+				continue;
+			}
+
+			island->Add(contact);
+			contact->m_flags |= b2Contact::e_islandFlag;
+
+			b2Body* other = ce->other;
+
+			// Was the other body already added to this island?
+			if (other->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
+
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		// Search all joints connect to this body.
+		for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+		{
+			if (je->joint->m_islandFlag == true)
+			{
+				continue;
+			}
+
+			b2Body* other = je->other;
+
+			// Don't simulate joints connected to inactive bodies.
+			if (other->IsActive() == false)
+			{
+				continue;
+			}
+
+			island->Add(je->joint);
+			je->joint->m_islandFlag = true;
+
+			if (other->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
+
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
 	}
 }
 
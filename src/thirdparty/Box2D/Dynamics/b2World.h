@@ -33,7 +33,9 @@ struct b2JointDef;
 class b2Body;
 class b2Draw;
 class b2Fixture;
+class b2Island;
 class b2Joint;
+class b2ThreadPool;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -145,6 +147,12 @@ public:
 	void SetAllowSleeping(bool flag);
 	bool GetAllowSleeping() const { return m_allowSleep; }
 
+	/// Set the number of threads used to solve islands. With more than one thread, islands are
+	/// built on the calling thread and solved in parallel. Post-solve callbacks are still made
+	/// on the calling thread, in the same order as with a single thread. The default is 1.
+	void SetSolverThreadCount(int32 threadCount);
+	int32 GetSolverThreadCount() const;
+
 	/// Enable/disable warm starting. For testing.
 	void SetWarmStarting(bool flag) { m_warmStarting = flag; }
 	bool GetWarmStarting() const { return m_warmStarting; }
@@ -225,6 +233,9 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
+	void BuildIsland(b2Body* seed, b2Island* island, b2Body** stack, int32 stackSize);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -232,6 +243,7 @@ private:
 
 	b2BlockAllocator m_blockAllocator;
 	b2StackAllocator m_stackAllocator;
+	b2ThreadPool* m_threadPool;
 
 	int32 m_flags;
 